@@ -31,6 +31,29 @@
 #endif
 #undef RESOURCE_SUPPRESS_STL
 #include <winmeta.h>
+
+// Define WIL_TRACELOGGING_MEMORY_SINK (consistently for every translation unit of a module) to route all TraceLogging
+// events written by that module into wil::trace_memory_sink instead of ETW.  This header must then be included before
+// TraceLoggingProvider.h so that the sink can replace the function the TraceLogging macros write through.
+#ifdef WIL_TRACELOGGING_MEMORY_SINK
+#ifdef TLG_EVENT_WRITE_TRANSFER
+#error WIL_TRACELOGGING_MEMORY_SINK requires wil/Tracelogging.h to be included before TraceLoggingProvider.h
+#endif
+#include <evntprov.h>
+#include <evntrace.h>
+/// @cond
+// TraceLoggingProvider.h may paste TLG_EVENT_WRITE_TRANSFER into other tokens, so it names a plain global function
+inline ULONG __stdcall wil_details_MemorySinkEventWriteTransfer(
+    REGHANDLE regHandle,
+    PCEVENT_DESCRIPTOR eventDescriptor,
+    LPCGUID activityId,
+    LPCGUID relatedActivityId,
+    ULONG dataCount,
+    PEVENT_DATA_DESCRIPTOR data) WI_NOEXCEPT;
+#define TLG_EVENT_WRITE_TRANSFER wil_details_MemorySinkEventWriteTransfer
+/// @endcond
+#endif
+
 #include <TraceLoggingProvider.h>
 #include <TraceLoggingActivity.h>
 #ifndef __WIL_TRACELOGGING_CONFIG_H
@@ -60,6 +83,35 @@
 #define __TRACELOGGING_TEST_HOOK_API_TELEMETRY_EVENT_DELAY_MS 5000
 #endif
 
+// How often a provider writes the "ActivityDurationSummary" events for its ActivityOptions::AggregateDuration activities
+#ifndef WIL_ACTIVITY_DURATION_SUMMARY_INTERVAL_MS
+#define WIL_ACTIVITY_DURATION_SUMMARY_INTERVAL_MS (60 * 1000)
+#endif
+
+// Longest time an event written by a DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM* method is buffered before it is emitted
+#ifndef WIL_BATCHED_EVENT_FLUSH_INTERVAL_MS
+#define WIL_BATCHED_EVENT_FLUSH_INTERVAL_MS 1000
+#endif
+
+// Maximum number of events a DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM* method buffers per processor before emitting them
+#ifndef WIL_BATCHED_EVENT_CAPACITY
+#define WIL_BATCHED_EVENT_CAPACITY 64
+#endif
+
+// Number of most recent events retained by wil::trace_memory_sink when WIL_TRACELOGGING_MEMORY_SINK is defined
+#ifndef WIL_TRACELOGGING_MEMORY_SINK_CAPACITY
+#define WIL_TRACELOGGING_MEMORY_SINK_CAPACITY 256
+#endif
+
+// Define WIL_TRACELOGGING_DEFER_CONTEXT_MESSAGES (consistently for every translation unit of a module) to format the
+// messages given to activities and thread watchers only when a failure reads them.  This adds about 170 bytes to every
+// activity and watcher, and relies on va_list being a pointer to contiguous argument slots (x86, x64 and ARM64 only).
+#if defined(WIL_TRACELOGGING_DEFER_CONTEXT_MESSAGES) && (defined(_WIN64) || defined(_M_IX86))
+#define _wiltlg_DEFER_CONTEXT_MESSAGES 1
+#else
+#define _wiltlg_DEFER_CONTEXT_MESSAGES 0
+#endif
+
 // For use only within wil/TraceLogging.h:
 #define _wiltlg_STRINGIZE(x) _wiltlg_STRINGIZE_imp(x)
 #define _wiltlg_STRINGIZE_imp(x) #x
@@ -172,10 +224,22 @@ enum class ActivityOptions
 {
     None = 0,
     TelemetryOnFailure = 0x1,
-    TraceLoggingOnFailure = 0x2
+    TraceLoggingOnFailure = 0x2,
+
+    // Successful activities do not write start/stop events.  Instead, the duration of each activity is recorded into
+    // a per-activity-class histogram and the provider periodically writes a single "ActivityDurationSummary" event
+    // with percentiles (see WIL_ACTIVITY_DURATION_SUMMARY_INTERVAL_MS).  Failed activities still write their stop event.
+    AggregateDuration = 0x4,
+
+    // Activity ids are a per-process prefix plus a process-wide counter rather than being created by ETW for each
+    // activity.  This makes starting high-rate activities cheaper while keeping the ids unique.  A provider-supplied
+    // CreateActivityId() still takes precedence.
+    FastActivityId = 0x8
 };
 DEFINE_ENUM_FLAG_OPERATORS(ActivityOptions)
 
+class TraceLoggingProvider;
+
 template <typename ActivityTraceLoggingType, ActivityOptions options, UINT64 keyword, UINT8 level, UINT64 privacyTag, typename TlgReflectorTag>
 class ActivityBase;
 
@@ -254,7 +318,9 @@ namespace details
 
     // This class serves as a simple RAII wrapper around CallContextInfo.  It presumes that
     // the contextName parameter is always a static string, but copies or allocates the
-    // contextMessage as needed.
+    // contextMessage as needed.  With WIL_TRACELOGGING_DEFER_CONTEXT_MESSAGES, formatted messages
+    // are deferred when possible: the format string and the argument values are copied into small
+    // inline buffers and only formatted (and allocated) when a failure actually reads the context.
 
     class StoredCallContextInfo : public wil::CallContextInfo
     {
@@ -279,6 +345,8 @@ namespace details
             other.contextMessage = nullptr;
             m_ownsMessage = other.m_ownsMessage;
             other.m_ownsMessage = false;
+            CopyPendingMessage(other);
+            other.m_messagePending = 0;
             return *this;
         }
 
@@ -293,6 +361,7 @@ namespace details
             else
             {
                 contextMessage = other.contextMessage;
+                CopyPendingMessage(other);
             }
         }
 
@@ -311,10 +380,13 @@ namespace details
 
         void SetMessage(_Printf_format_string_ PCSTR formatString, va_list argList)
         {
-            wchar_t loggingMessage[2048];
-            PrintLoggingMessage(loggingMessage, ARRAYSIZE(loggingMessage), formatString, argList);
             ClearMessage();
-            AssignMessage(loggingMessage);
+            if (!TryDeferMessage(formatString, argList))
+            {
+                wchar_t loggingMessage[2048];
+                PrintLoggingMessage(loggingMessage, ARRAYSIZE(loggingMessage), formatString, argList);
+                AssignMessage(loggingMessage);
+            }
         }
 
         void SetMessage(_In_opt_ PCWSTR message)
@@ -340,6 +412,36 @@ namespace details
                 m_ownsMessage = false;
             }
             contextMessage = nullptr;
+            m_messagePending = 0;
+        }
+
+        // Formats a message deferred by SetMessage so that contextMessage can be read.  The pending state stays set
+        // until contextMessage is assigned, so a thread racing the formatting thread waits for the message.
+        void FormatPendingMessage() WI_NOEXCEPT
+        {
+#if _wiltlg_DEFER_CONTEXT_MESSAGES
+            if (::InterlockedCompareExchange(&m_messagePending, c_messageFormatting, c_messageDeferred) == c_messageDeferred)
+            {
+                wchar_t loggingMessage[2048];
+                PrintLoggingMessage(
+                    loggingMessage, ARRAYSIZE(loggingMessage), m_pendingFormat, reinterpret_cast<va_list>(m_pendingArguments));
+                AssignMessage(loggingMessage);
+                ::InterlockedExchange(&m_messagePending, 0);
+            }
+            else
+            {
+                while (::ReadAcquire(&m_messagePending) == c_messageFormatting)
+                {
+                    YieldProcessor();
+                }
+            }
+#endif
+        }
+
+        // ThreadFailureCallbackHolder invokes this when a failure is about to read the call context
+        static void __stdcall PrepareForFailure(_Inout_ wil::CallContextInfo* pCallContext) WI_NOEXCEPT
+        {
+            static_cast<StoredCallContextInfo*>(pCallContext)->FormatPendingMessage();
         }
 
         ~StoredCallContextInfo()
@@ -365,7 +467,168 @@ namespace details
             }
         }
 
+#if _wiltlg_DEFER_CONTEXT_MESSAGES
+        void CopyPendingMessage(StoredCallContextInfo const& other) WI_NOEXCEPT
+        {
+            m_messagePending = other.m_messagePending;
+            if (m_messagePending != 0)
+            {
+                memcpy_s(m_pendingFormat, sizeof(m_pendingFormat), other.m_pendingFormat, sizeof(other.m_pendingFormat));
+                memcpy_s(
+                    m_pendingArguments, sizeof(m_pendingArguments), other.m_pendingArguments, sizeof(other.m_pendingArguments));
+            }
+        }
+
+        // Size of an argument's slot in a va_list, where arguments smaller than int have already been promoted
+        static size_t ArgumentSlotSize(size_t argumentSize) WI_NOEXCEPT
+        {
+#ifdef _WIN64
+            return (argumentSize + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+#else
+            return argumentSize;
+#endif
+        }
+
+        // Copies the format string and the va_list slots it consumes so that the message can be formatted after
+        // the caller's arguments are gone.  Only formats whose arguments are all passed by value qualify; strings
+        // (%s, %S, %Z) are passed by pointer and may not outlive the call, so those are formatted immediately, as
+        // is anything that does not fit in the inline buffers.
+        bool TryDeferMessage(_In_opt_ _Printf_format_string_ PCSTR formatString, _In_opt_ va_list argList) WI_NOEXCEPT
+        {
+            if ((formatString == nullptr) || (argList == nullptr))
+            {
+                return false;
+            }
+
+            size_t argumentBytes = 0;
+            auto format = formatString;
+            while (*format != '\0')
+            {
+                if (*format++ != '%')
+                {
+                    continue;
+                }
+                if (*format == '%')
+                {
+                    format++;
+                    continue;
+                }
+
+                while ((*format == '-') || (*format == '+') || (*format == ' ') || (*format == '#') || (*format == '0'))
+                {
+                    format++;
+                }
+
+                // Width and precision may each be taken from an int argument
+                for (auto isPrecision = false;; isPrecision = true)
+                {
+                    if (*format == '*')
+                    {
+                        argumentBytes += ArgumentSlotSize(sizeof(int));
+                        format++;
+                    }
+                    while ((*format >= '0') && (*format <= '9'))
+                    {
+                        format++;
+                    }
+                    if (isPrecision || (*format != '.'))
+                    {
+                        break;
+                    }
+                    format++;
+                }
+
+                size_t integerSize = sizeof(int);
+                if ((format[0] == 'l') && (format[1] == 'l'))
+                {
+                    integerSize = sizeof(long long);
+                    format += 2;
+                }
+                else if ((format[0] == 'I') && (format[1] == '6') && (format[2] == '4'))
+                {
+                    integerSize = sizeof(__int64);
+                    format += 3;
+                }
+                else if ((format[0] == 'I') && (format[1] == '3') && (format[2] == '2'))
+                {
+                    integerSize = sizeof(__int32);
+                    format += 3;
+                }
+                else if ((*format == 'I') || (*format == 'z') || (*format == 't') || (*format == 'j'))
+                {
+                    integerSize = (*format == 'j') ? sizeof(long long) : sizeof(size_t);
+                    format++;
+                }
+                else
+                {
+                    while ((*format == 'h') || (*format == 'l') || (*format == 'L') || (*format == 'w'))
+                    {
+                        format++;
+                    }
+                }
+
+                switch (*format++)
+                {
+                case 'd':
+                case 'i':
+                case 'o':
+                case 'u':
+                case 'x':
+                case 'X':
+                    argumentBytes += ArgumentSlotSize(integerSize);
+                    break;
+                case 'c':
+                case 'C':
+                    argumentBytes += ArgumentSlotSize(sizeof(int));
+                    break;
+                case 'p':
+                    argumentBytes += ArgumentSlotSize(sizeof(void*));
+                    break;
+                case 'a':
+                case 'A':
+                case 'e':
+                case 'E':
+                case 'f':
+                case 'F':
+                case 'g':
+                case 'G':
+                    argumentBytes += ArgumentSlotSize(sizeof(double));
+                    break;
+                default:
+                    return false;
+                }
+            }
+
+            auto const formatBytes = static_cast<size_t>(format - formatString) + 1;
+            if ((argumentBytes > sizeof(m_pendingArguments)) || (formatBytes > sizeof(m_pendingFormat)))
+            {
+                return false;
+            }
+
+            memcpy_s(m_pendingFormat, sizeof(m_pendingFormat), formatString, formatBytes);
+            memcpy_s(m_pendingArguments, sizeof(m_pendingArguments), argList, argumentBytes);
+            m_messagePending = c_messageDeferred;
+            return true;
+        }
+#else
+        void CopyPendingMessage(StoredCallContextInfo const&) WI_NOEXCEPT
+        {
+        }
+
+        bool TryDeferMessage(PCSTR, va_list) WI_NOEXCEPT
+        {
+            return false;
+        }
+#endif
+
         bool m_ownsMessage{false};
+        long m_messagePending{0};
+#if _wiltlg_DEFER_CONTEXT_MESSAGES
+        static long const c_messageDeferred = 1;
+        static long const c_messageFormatting = 2;
+        char m_pendingFormat[96];
+        alignas(8) unsigned char m_pendingArguments[64];
+#endif
     };
 
     template <typename TActivity>
@@ -385,2052 +648,2267 @@ namespace details
 
     typedef wistd::integral_constant<char, 0> tag_start;
     typedef wistd::integral_constant<char, 1> tag_start_cv;
-} // namespace details
-/// @endcond
-
-// This class acts as a simple RAII class returned by a call to ContinueOnCurrentThread() for an activity
-// or by a call to WatchCurrentThread() on a provider.  The result is meant to be a stack local variable
-// whose scope controls the lifetime of an error watcher on the given thread.  That error watcher re-directs
-// errors occurrent within the object's lifetime to the associated provider or activity.
-
-class ActivityThreadWatcher
-{
-public:
-    ActivityThreadWatcher() WI_NOEXCEPT : m_callbackHolder(nullptr, nullptr, false)
-    {
-    }
-
-    ActivityThreadWatcher(_In_ details::IFailureCallback* pCallback, PCSTR staticContextName) WI_NOEXCEPT
-        : m_callContext(staticContextName),
-          m_callbackHolder(pCallback, &m_callContext)
-    {
-    }
 
-    ActivityThreadWatcher(
-        _In_ details::IFailureCallback* pCallback, PCSTR staticContextName, _Printf_format_string_ PCSTR formatString, va_list argList) WI_NOEXCEPT
-        : ActivityThreadWatcher(pCallback, staticContextName)
-    {
-        m_callContext.SetMessage(formatString, argList);
-    }
-
-    // Uses the supplied StoredCallContextInfo rather than producing one itself
-    ActivityThreadWatcher(_In_ details::IFailureCallback* pCallback, _In_ details::StoredCallContextInfo const& callContext) WI_NOEXCEPT
-        : m_callContext(callContext),
-          m_callbackHolder(pCallback, &m_callContext)
+    // Creates an activity id for ActivityOptions::FastActivityId.  The first nine bytes are a prefix computed once per
+    // process by mixing an ETW-created id with the process id and start time; the remaining seven bytes are a
+    // process-wide counter.  The version and variant bits are set so that the result is a well-formed (version 4) GUID.
+    inline void CreateFastActivityId(_Out_ GUID& activityId) WI_NOEXCEPT
     {
-    }
+        struct fast_activity_id_prefix
+        {
+            GUID value;
 
-    ActivityThreadWatcher(ActivityThreadWatcher&& other) WI_NOEXCEPT : m_callContext(wistd::move(other.m_callContext)),
-                                                                       m_callbackHolder(wistd::move(other.m_callbackHolder))
-    {
-        m_callbackHolder.SetCallContext(&m_callContext);
-    }
+            fast_activity_id_prefix() WI_NOEXCEPT
+            {
+                GUID seed{};
+                ::EventActivityIdControl(EVENT_ACTIVITY_CTRL_CREATE_ID, &seed);
+                LARGE_INTEGER now;
+                ::QueryPerformanceCounter(&now);
+
+                ULONGLONG halves[2];
+                memcpy_s(halves, sizeof(halves), &seed, sizeof(seed));
+                halves[0] = Mix(halves[0] ^ ::GetCurrentProcessId());
+                halves[1] = Mix(halves[1] ^ static_cast<ULONGLONG>(now.QuadPart) ^ halves[0]);
+                memcpy_s(&value, sizeof(value), halves, sizeof(halves));
+                value.Data3 = static_cast<unsigned short>((value.Data3 & 0x0FFF) | 0x4000);
+                value.Data4[0] = static_cast<unsigned char>((value.Data4[0] & 0x3F) | 0x80);
+            }
 
-    ActivityThreadWatcher(ActivityThreadWatcher const&) = delete;
-    ActivityThreadWatcher& operator=(ActivityThreadWatcher const&) = delete;
+            // splitmix64 finalizer
+            static ULONGLONG Mix(ULONGLONG value) WI_NOEXCEPT
+            {
+                value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+                value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+                return value ^ (value >> 31);
+            }
+        };
+        static fast_activity_id_prefix const s_prefix;
+        static LONG64 volatile s_sequence = 0;
 
-    void SetMessage(_Printf_format_string_ PCSTR formatString, ...)
-    {
-        va_list argList;
-        va_start(argList, formatString);
-        m_callContext.SetMessage(formatString, argList);
-        va_end(argList);
+        auto const sequence = static_cast<ULONGLONG>(::InterlockedIncrement64(&s_sequence));
+        activityId = s_prefix.value;
+        for (unsigned int index = 1; index < ARRAYSIZE(activityId.Data4); ++index)
+        {
+            activityId.Data4[index] = static_cast<unsigned char>(sequence >> ((ARRAYSIZE(activityId.Data4) - 1 - index) * 8));
+        }
     }
 
-    void SetMessage(_In_opt_ PCWSTR message)
+    // Snapshot of an activity_duration_histogram produced when it is drained; all durations are in microseconds.
+    struct activity_duration_summary
     {
-        m_callContext.SetMessage(message);
-    }
+        ULONGLONG count;
+        ULONGLONG meanMicroseconds;
+        ULONGLONG p50Microseconds;
+        ULONGLONG p90Microseconds;
+        ULONGLONG p99Microseconds;
+        ULONGLONG maxMicroseconds;
+    };
 
-    void SetMessageCopy(_In_opt_ PCWSTR message)
+    // Cached enablement state of one provider class, used by DEFINE_TRACELOGGING_EVENT_PARAM* methods so that a
+    // disabled event costs a relaxed load and a predictable branch.  Each distinct (level, keywords) pair tested
+    // through the cache is assigned one bit of enabledMask on first use; the provider's ETW enable callback recomputes
+    // every assigned bit.  Instances are zero-initialized statics (see event_enablement) and are only written while
+    // holding the lock, so they remain valid for the whole lifetime of the process.
+    struct event_enablement_cache
     {
-        m_callContext.SetMessageCopy(message);
-    }
-
-private:
-    details::StoredCallContextInfo m_callContext;
-    details::ThreadFailureCallbackHolder m_callbackHolder;
-};
+        static constexpr long c_slotCount = 64;
+
+        TraceLoggingHProvider provider;
+        TLG_PENABLECALLBACK forwardCallback;
+        SRWLOCK lock;
+        LONG64 volatile enabledMask;
+        long slotCount;
+        UCHAR slotLevels[c_slotCount];
+        ULONGLONG slotKeywords[c_slotCount];
+
+        // Binds the cache to a registered provider; called before TraceLoggingRegisterEx so that the first enable
+        // callback already sees the handle.
+        void Attach(TraceLoggingHProvider providerHandle, TLG_PENABLECALLBACK callback) WI_NOEXCEPT
+        {
+            ::AcquireSRWLockExclusive(&lock);
+            provider = providerHandle;
+            forwardCallback = callback;
+            ::ReleaseSRWLockExclusive(&lock);
+        }
 
-// This is the base-class implementation of a TraceLogging class.  TraceLogging classes are defined with
-// BEGIN_TRACELOGGING_CLASS and automatically derive from this class
+        // Clears every bit so that cached events stop writing once the provider is unregistered.
+        void Detach() WI_NOEXCEPT
+        {
+            ::AcquireSRWLockExclusive(&lock);
+            provider = nullptr;
+            ::InterlockedExchange64(&enabledMask, 0);
+            ::ReleaseSRWLockExclusive(&lock);
+        }
 
-enum class ErrorReportingType
-{
-    None = 0,
-    Telemetry,
-    TraceLogging
-};
+        void Refresh() WI_NOEXCEPT
+        {
+            ::AcquireSRWLockExclusive(&lock);
+            RefreshLocked();
+            ::ReleaseSRWLockExclusive(&lock);
+        }
 
-class TraceLoggingProvider : public details::IFailureCallback
-{
-public:
-    // Only one instance of each of these derived classes should be created
-    TraceLoggingProvider(_In_ TraceLoggingProvider const&) = delete;
-    TraceLoggingProvider& operator=(TraceLoggingProvider const&) = delete;
-    void* operator new(size_t) = delete;
-    void* operator new[](size_t) = delete;
+        // Returns the 1-based slot for the given level and keywords, 0 when the provider is not bound yet or -1 when
+        // every slot is taken.  Callers fall back to querying TraceLogging directly for anything but a positive slot.
+        long AssignSlot(UCHAR level, ULONGLONG keywords) WI_NOEXCEPT
+        {
+            ::AcquireSRWLockExclusive(&lock);
+            long slot = 0;
+            if (provider != nullptr)
+            {
+                for (long index = 0; index < slotCount; index++)
+                {
+                    if ((slotLevels[index] == level) && (slotKeywords[index] == keywords))
+                    {
+                        slot = index + 1;
+                        break;
+                    }
+                }
+                if (slot == 0)
+                {
+                    slot = -1;
+                    if (slotCount < c_slotCount)
+                    {
+                        slotLevels[slotCount] = level;
+                        slotKeywords[slotCount] = keywords;
+                        slot = ++slotCount;
+                        RefreshLocked();
+                    }
+                }
+            }
+            ::ReleaseSRWLockExclusive(&lock);
+            return slot;
+        }
 
-protected:
-    // This can be overridden to provide specific initialization code for any individual provider.
-    // It will be ran once when the single static singleton instance of this class is created.
-    virtual void Initialize() WI_NOEXCEPT
-    {
-    }
+        bool IsSlotEnabled(long slot) const WI_NOEXCEPT
+        {
+            return ((static_cast<ULONGLONG>(::ReadNoFence64(&enabledMask)) >> (slot - 1)) & 1) != 0;
+        }
 
-    // This method can be overridden by a provider to more tightly control what happens in the event
-    // of a failure in a CallContext activity, WatchCurrentThread() object, or attributed to a specific failure.
-    virtual void OnErrorReported(bool alreadyReported, FailureInfo const& failure) WI_NOEXCEPT
-    {
-        if (!alreadyReported && WI_IsFlagClear(failure.flags, FailureFlags::RequestSuppressTelemetry))
+        static void NTAPI EnableCallback(
+            _In_ LPCGUID sourceId,
+            ULONG controlCode,
+            UCHAR level,
+            ULONGLONG matchAnyKeyword,
+            ULONGLONG matchAllKeyword,
+            _In_opt_ PEVENT_FILTER_DESCRIPTOR filterData,
+            _In_opt_ PVOID callbackContext)
         {
-            if (m_errorReportingType == ErrorReportingType::Telemetry)
+            // TraceLogging updates the provider's level and keywords before invoking this callback
+            auto const cache = static_cast<event_enablement_cache*>(callbackContext);
+            cache->Refresh();
+            if (cache->forwardCallback != nullptr)
             {
-                ReportTelemetryFailure(failure);
+                cache->forwardCallback(sourceId, controlCode, level, matchAnyKeyword, matchAllKeyword, filterData, nullptr);
             }
-            else if (m_errorReportingType == ErrorReportingType::TraceLogging)
+        }
+
+    private:
+        void RefreshLocked() WI_NOEXCEPT
+        {
+            ULONGLONG mask = 0;
+            if (provider != nullptr)
             {
-                ReportTraceLoggingFailure(failure);
+                for (long index = 0; index < slotCount; index++)
+                {
+                    if (TraceLoggingProviderEnabled(provider, slotLevels[index], slotKeywords[index]))
+                    {
+                        mask |= (1ull << index);
+                    }
+                }
             }
+            ::InterlockedExchange64(&enabledMask, static_cast<LONG64>(mask));
         }
-    }
+    };
 
-public:
-    WI_NODISCARD TraceLoggingHProvider Provider_() const WI_NOEXCEPT
+    // The enablement cache and the per-(level, keywords) slots of the provider class TraceLoggingType.  Both are
+    // constant-initialized so the hot path needs neither a guard nor the provider singleton.
+    template <typename TraceLoggingType>
+    struct event_enablement
     {
-        return m_providerHandle;
-    }
+        static event_enablement_cache cache;
 
-protected:
-    TraceLoggingProvider() WI_NOEXCEPT
-    {
-    }
+        template <UCHAR level, ULONGLONG keywords>
+        struct slot
+        {
+            static long index;
+        };
+    };
 
-    virtual ~TraceLoggingProvider() WI_NOEXCEPT
+    template <typename TraceLoggingType>
+    event_enablement_cache event_enablement<TraceLoggingType>::cache{};
+
+    template <typename TraceLoggingType>
+    template <UCHAR level, ULONGLONG keywords>
+    long event_enablement<TraceLoggingType>::slot<level, keywords>::index = 0;
+
+    // Assigns the slot of an event_enablement<TraceLoggingType>::slot on first use.  Until the provider registers
+    // with its cache (or once every slot is taken) enablement is queried from TraceLogging directly.
+    template <typename TraceLoggingType>
+    __declspec(noinline) bool IsEventEnabledSlow(
+        _Inout_ long* slot, UCHAR level, ULONGLONG keywords, TraceLoggingHProvider provider) WI_NOEXCEPT
     {
-        if (m_ownsProviderHandle)
+        auto& cache = event_enablement<TraceLoggingType>::cache;
+        auto const index = cache.AssignSlot(level, keywords);
+        if (index != 0)
         {
-            TraceLoggingUnregister(m_providerHandle);
+            ::WriteRelease(slot, index);
+        }
+        if (index > 0)
+        {
+            return cache.IsSlotEnabled(index);
         }
+        return (provider != nullptr) && TraceLoggingProviderEnabled(provider, level, keywords);
     }
 
-    WI_NODISCARD bool IsEnabled_(
-        UCHAR eventLevel /* WINEVENT_LEVEL_XXX, e.g. WINEVENT_LEVEL_VERBOSE */,
-        ULONGLONG eventKeywords /* MICROSOFT_KEYWORD_XXX */) const WI_NOEXCEPT
+    // State that a TraceLoggingProvider drains into events on a timer and once more when the provider is destroyed,
+    // such as activity duration histograms and batched events.  Sources are function-local statics that register
+    // themselves on first use and are never unregistered, so they must remain trivially destructible.
+    class periodic_event_source
     {
-        return ((m_providerHandle != nullptr) && TraceLoggingProviderEnabled(m_providerHandle, eventLevel, eventKeywords)) ||
-               __TRACELOGGING_TEST_HOOK_SET_ENABLED;
-    }
+    public:
+        virtual void Flush(TraceLoggingHProvider provider) WI_NOEXCEPT = 0;
 
-    void SetErrorReportingType_(ErrorReportingType type)
-    {
-        m_errorReportingType = type;
-    }
+    protected:
+        explicit periodic_event_source(ULONG flushIntervalMs) WI_NOEXCEPT : m_flushIntervalMs(flushIntervalMs)
+        {
+        }
 
-    static bool WasAlreadyReportedToTelemetry(long failureId) WI_NOEXCEPT
-    {
-        static long volatile s_lastFailureSeen = -1;
-        long oldValue = InterlockedExchange(&s_lastFailureSeen, failureId);
-        auto wasSeen = (oldValue == failureId);
-        return wasSeen;
-    }
+        ~periodic_event_source() = default;
 
-    void ReportTelemetryFailure(FailureInfo const& failure) WI_NOEXCEPT
+    private:
+        friend class ::wil::TraceLoggingProvider;
+
+        periodic_event_source* m_next{};
+        ULONG m_flushIntervalMs;
+        ULONGLONG m_nextFlushTick{};
+    };
+
+    typedef void(__stdcall* periodic_event_source_registrar)(periodic_event_source* source) WI_PFN_NOEXCEPT;
+
+    typedef void(__stdcall* activity_duration_writer)(
+        TraceLoggingHProvider provider, PCSTR activityName, activity_duration_summary const& summary) WI_PFN_NOEXCEPT;
+
+    // Log-linear histogram of activity durations used by activities declared with ActivityOptions::AggregateDuration.
+    // Durations are recorded in QueryPerformanceCounter ticks into buckets that are linear within each power of two
+    // (four buckets per octave, so any reported percentile is within 25% of the true value).  Counts are sharded by
+    // processor so that concurrent Stop() calls do not contend on a single cache line.
+    //
+    // Instances are function-local statics (one per activity class) with a trivial destructor so that they remain
+    // valid until the owning TraceLoggingProvider performs its final flush during teardown.
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+    class activity_duration_histogram final : public periodic_event_source
     {
-        __TRACELOGGING_TEST_HOOK_ERROR(failure);
-        TraceLoggingWrite(
-            m_providerHandle,
-            "FallbackError",
-            TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
-            TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY),
-            TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
-            __RESULT_TELEMETRY_FAILURE_PARAMS(failure));
-    }
+    public:
+        activity_duration_histogram(
+            PCSTR activityName, activity_duration_writer writer, periodic_event_source_registrar registrar) WI_NOEXCEPT
+            : periodic_event_source(WIL_ACTIVITY_DURATION_SUMMARY_INTERVAL_MS),
+              m_activityName(activityName),
+              m_writer(writer)
+        {
+            registrar(this);
+        }
 
-    void ReportTraceLoggingFailure(FailureInfo const& failure) WI_NOEXCEPT
+        activity_duration_histogram(activity_duration_histogram const&) = delete;
+        activity_duration_histogram& operator=(activity_duration_histogram const&) = delete;
+
+        void Record(LONGLONG elapsedTicks) WI_NOEXCEPT
+        {
+            auto const ticks = static_cast<ULONGLONG>((elapsedTicks > 0) ? elapsedTicks : 0);
+            auto& counts = m_shards[::GetCurrentProcessorNumber() & (c_shardCount - 1)];
+            ::InterlockedIncrementNoFence(&counts.buckets[BucketIndex(ticks)]);
+            ::InterlockedExchangeAdd64(&counts.totalTicks, static_cast<LONG64>(ticks));
+        }
+
+        // Drains all recorded durations and writes a single summary event to the given provider.  Nothing is
+        // written when no durations were recorded since the previous flush.
+        void Flush(TraceLoggingHProvider provider) WI_NOEXCEPT override
+        {
+            ULONG counts[c_bucketCount]{};
+            ULONGLONG totalCount = 0;
+            ULONGLONG totalTicks = 0;
+            for (auto& shard : m_shards)
+            {
+                for (unsigned int index = 0; index < c_bucketCount; ++index)
+                {
+                    auto const count = static_cast<ULONG>(::InterlockedExchangeNoFence(&shard.buckets[index], 0));
+                    counts[index] += count;
+                    totalCount += count;
+                }
+                totalTicks += static_cast<ULONGLONG>(::InterlockedExchange64(&shard.totalTicks, 0));
+            }
+
+            if (totalCount == 0)
+            {
+                return;
+            }
+
+            LARGE_INTEGER frequency;
+            ::QueryPerformanceFrequency(&frequency);
+            auto const ticksPerSecond = static_cast<ULONGLONG>(frequency.QuadPart);
+
+            activity_duration_summary summary{};
+            summary.count = totalCount;
+            summary.meanMicroseconds = TicksToMicroseconds(totalTicks / totalCount, ticksPerSecond);
+            summary.p50Microseconds = TicksToMicroseconds(Percentile(counts, totalCount, 500), ticksPerSecond);
+            summary.p90Microseconds = TicksToMicroseconds(Percentile(counts, totalCount, 900), ticksPerSecond);
+            summary.p99Microseconds = TicksToMicroseconds(Percentile(counts, totalCount, 990), ticksPerSecond);
+            summary.maxMicroseconds = TicksToMicroseconds(Percentile(counts, totalCount, 1000), ticksPerSecond);
+            m_writer(provider, m_activityName, summary);
+        }
+
+    private:
+        static unsigned int const c_subBucketBits = 2;
+        static unsigned int const c_subBucketCount = 1u << c_subBucketBits;
+        static unsigned long const c_maxHighestBit = 47; // Longer durations are clamped into the final bucket
+        static unsigned int const c_bucketCount = (c_maxHighestBit - c_subBucketBits + 2) * c_subBucketCount;
+        static unsigned int const c_shardCount = 8;
+
+        static unsigned long HighestSetBit(ULONGLONG value) WI_NOEXCEPT
+        {
+            unsigned long index = 0;
+#if defined(_WIN64)
+            _BitScanReverse64(&index, value);
+#else
+            if (_BitScanReverse(&index, static_cast<unsigned long>(value >> 32)))
+            {
+                index += 32;
+            }
+            else
+            {
+                _BitScanReverse(&index, static_cast<unsigned long>(value));
+            }
+#endif
+            return index;
+        }
+
+        static unsigned int BucketIndex(ULONGLONG ticks) WI_NOEXCEPT
+        {
+            if (ticks < c_subBucketCount)
+            {
+                return static_cast<unsigned int>(ticks);
+            }
+
+            auto const highestBit = HighestSetBit(ticks);
+            if (highestBit > c_maxHighestBit)
+            {
+                return c_bucketCount - 1;
+            }
+
+            auto const subBucket = static_cast<unsigned int>(ticks >> (highestBit - c_subBucketBits)) & (c_subBucketCount - 1);
+            return ((highestBit - c_subBucketBits + 1) << c_subBucketBits) | subBucket;
+        }
+
+        // Returns the largest tick count that falls into the given bucket
+        static ULONGLONG BucketHighestValue(unsigned int index) WI_NOEXCEPT
+        {
+            if (index < c_subBucketCount)
+            {
+                return index;
+            }
+
+            auto const shift = (index >> c_subBucketBits) - 1;
+            auto const subBucket = index & (c_subBucketCount - 1);
+            return ((static_cast<ULONGLONG>(c_subBucketCount + subBucket + 1) << shift) - 1);
+        }
+
+        static ULONGLONG Percentile(ULONG const (&counts)[c_bucketCount], ULONGLONG totalCount, ULONGLONG permille) WI_NOEXCEPT
+        {
+            auto const threshold = ((totalCount * permille) + 999) / 1000;
+            ULONGLONG seen = 0;
+            for (unsigned int index = 0; index < c_bucketCount; ++index)
+            {
+                seen += counts[index];
+                if ((counts[index] != 0) && (seen >= threshold))
+                {
+                    return BucketHighestValue(index);
+                }
+            }
+            return BucketHighestValue(c_bucketCount - 1);
+        }
+
+        static ULONGLONG TicksToMicroseconds(ULONGLONG ticks, ULONGLONG ticksPerSecond) WI_NOEXCEPT
+        {
+            // Split the conversion to avoid overflowing on long durations
+            return ((ticks / ticksPerSecond) * 1000000) + (((ticks % ticksPerSecond) * 1000000) / ticksPerSecond);
+        }
+
+        struct alignas(64) shard_counts
+        {
+            volatile LONG buckets[c_bucketCount];
+            volatile LONG64 totalTicks;
+        };
+
+        PCSTR m_activityName;
+        activity_duration_writer m_writer;
+        shard_counts m_shards[c_shardCount]{};
+    };
+#pragma warning(pop)
+
+    template <UINT64 keyword, UINT8 level, UINT64 privacyTag>
+    void __stdcall WriteActivityDurationSummary(
+        TraceLoggingHProvider provider, PCSTR activityName, activity_duration_summary const& summary) WI_NOEXCEPT
     {
         TraceLoggingWrite(
-            m_providerHandle, "FallbackError", TraceLoggingLevel(WINEVENT_LEVEL_ERROR), __RESULT_TRACELOGGING_FAILURE_PARAMS(failure));
-    }
-
-    // Helper function for TraceLoggingError.
-    // It prints out a trace message for debug purposes. The message does not go into the telemetry.
-    void ReportTraceLoggingError(_In_ _Printf_format_string_ PCSTR formatString, va_list argList) WI_NOEXCEPT
+            provider,
+            "ActivityDurationSummary",
+            TraceLoggingKeyword(keyword),
+            TraceLoggingLevel(level),
+            TelemetryPrivacyDataTag(privacyTag),
+            TraceLoggingString(activityName, "activityName", "Name of the activity class whose durations are summarized"),
+            TraceLoggingUInt64(summary.count, "count", "Number of activities stopped since the previous summary"),
+            TraceLoggingUInt64(summary.meanMicroseconds, "meanMicroseconds"),
+            TraceLoggingUInt64(summary.p50Microseconds, "p50Microseconds"),
+            TraceLoggingUInt64(summary.p90Microseconds, "p90Microseconds"),
+            TraceLoggingUInt64(summary.p99Microseconds, "p99Microseconds"),
+            TraceLoggingUInt64(summary.maxMicroseconds, "maxMicroseconds"));
+    }
+
+    // Maps the field types supported by DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM* onto TraceLogging packed field types.
+    // Only fixed-size values can be batched; strings and other pointers must use the unbatched event macros.
+    template <typename T>
+    struct batched_event_field;
+
+#define __WI_BATCHED_EVENT_FIELD(FieldType, InType, OutType) \
+    template <> \
+    struct batched_event_field<FieldType> \
+    { \
+        static UINT8 const inType = InType; \
+        static UINT8 const outType = OutType; \
+    };
+    __WI_BATCHED_EVENT_FIELD(bool, TlgInUINT8, TlgOutBOOLEAN)
+    __WI_BATCHED_EVENT_FIELD(char, TlgInINT8, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(signed char, TlgInINT8, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(unsigned char, TlgInUINT8, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(short, TlgInINT16, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(unsigned short, TlgInUINT16, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(int, TlgInINT32, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(unsigned int, TlgInUINT32, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(long, TlgInINT32, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(unsigned long, TlgInUINT32, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(long long, TlgInINT64, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(unsigned long long, TlgInUINT64, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(float, TlgInFLOAT, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(double, TlgInDOUBLE, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(GUID, TlgInGUID, TlgOutDEFAULT)
+    __WI_BATCHED_EVENT_FIELD(FILETIME, TlgInFILETIME, TlgOutDEFAULT)
+#undef __WI_BATCHED_EVENT_FIELD
+
+    typedef void (*batched_event_writer)(TraceLoggingHProvider provider, UINT16 count, void const* entries) WI_PFN_NOEXCEPT;
+
+    // Buffers the field values of a DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM* method and writes them as a single event
+    // holding an array of entries, either when a buffer fills or when the provider's periodic flush runs (at least
+    // every WIL_BATCHED_EVENT_FLUSH_INTERVAL_MS).  Entries are the field values packed back to back without padding.
+    // Buffers are sharded by processor so that concurrent writers rarely contend for the same lock.
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+    template <size_t entrySize>
+    class batched_event final : public periodic_event_source
     {
-        if (IsEnabled_(WINEVENT_LEVEL_ERROR, 0))
+    public:
+        batched_event(batched_event_writer writer, periodic_event_source_registrar registrar) WI_NOEXCEPT
+            : periodic_event_source(WIL_BATCHED_EVENT_FLUSH_INTERVAL_MS),
+              m_writer(writer)
         {
-            wchar_t loggingMessage[2048];
-            details::PrintLoggingMessage(loggingMessage, ARRAYSIZE(loggingMessage), formatString, argList);
-            TraceLoggingWrite(
-                m_providerHandle,
-                "TraceLoggingError",
-                TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
-                TraceLoggingWideString(loggingMessage, "traceLoggingMessage"));
+            registrar(this);
         }
-    }
 
-    // Helper function for TraceLoggingInfo.
-    // It prints out a trace message for debug purposes. The message does not go into the telemetry.
-    void ReportTraceLoggingMessage(_In_ _Printf_format_string_ PCSTR formatString, va_list argList) WI_NOEXCEPT
-    {
-        if (IsEnabled_(WINEVENT_LEVEL_VERBOSE, 0))
+        batched_event(batched_event const&) = delete;
+        batched_event& operator=(batched_event const&) = delete;
+
+        template <typename... TFields>
+        void Add(TraceLoggingHProvider provider, TFields const&... fields) WI_NOEXCEPT
         {
-            wchar_t loggingMessage[2048];
-            details::PrintLoggingMessage(loggingMessage, ARRAYSIZE(loggingMessage), formatString, argList);
-            TraceLoggingWrite(
-                m_providerHandle,
-                "TraceLoggingInfo",
-                TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
-                TraceLoggingWideString(loggingMessage, "traceLoggingMessage"));
+            static_assert(SumOfSizes<TFields...>::value == entrySize, "Batched event fields must match the entry size");
+            auto& shard = m_shards[::GetCurrentProcessorNumber() & (c_shardCount - 1)];
+            auto lock = shard.lock.lock_exclusive();
+            Pack(shard.entries + (shard.count * entrySize), fields...);
+            if (++shard.count == c_capacity)
+            {
+                WriteShard(provider, shard);
+            }
         }
-    }
 
-    void Register(TraceLoggingHProvider const providerHandle, TLG_PENABLECALLBACK callback = nullptr) WI_NOEXCEPT
-    {
-        // taking over the lifetime and management of providerHandle
-        m_providerHandle = providerHandle;
-        m_ownsProviderHandle = true;
-        TraceLoggingRegisterEx(providerHandle, callback, nullptr);
-        InternalInitialize();
-    }
+        void Flush(TraceLoggingHProvider provider) WI_NOEXCEPT override
+        {
+            for (auto& shard : m_shards)
+            {
+                auto lock = shard.lock.lock_exclusive();
+                if (shard.count != 0)
+                {
+                    WriteShard(provider, shard);
+                }
+            }
+        }
 
-    void AttachProvider(TraceLoggingHProvider const providerHandle) WI_NOEXCEPT
-    {
-        m_providerHandle = providerHandle;
-        m_ownsProviderHandle = false;
-        InternalInitialize();
-    }
+    private:
+        // Keep each emitted event well below the 64KB ETW event size limit
+        static size_t const c_maxPayloadBytes = 16 * 1024;
+        static size_t const c_capacity = (WIL_BATCHED_EVENT_CAPACITY * entrySize <= c_maxPayloadBytes)
+                                             ? WIL_BATCHED_EVENT_CAPACITY
+                                             : (c_maxPayloadBytes / entrySize);
+        static unsigned int const c_shardCount = 8;
+        static_assert(c_capacity > 0, "Batched event fields are too large");
+
+        struct alignas(64) shard_buffer
+        {
+            srwlock lock;
+            size_t count;
+            unsigned char entries[c_capacity * entrySize];
+        };
 
-private:
-    // IFailureCallback
-    bool NotifyFailure(FailureInfo const& failure) WI_NOEXCEPT override
-    {
-        if (!WasAlreadyReportedToTelemetry(failure.failureId))
+        template <typename... TFields>
+        struct SumOfSizes : wistd::integral_constant<size_t, 0>
+        {
+        };
+
+        template <typename TField, typename... TFields>
+        struct SumOfSizes<TField, TFields...> : wistd::integral_constant<size_t, sizeof(TField) + SumOfSizes<TFields...>::value>
+        {
+        };
+
+        static void Pack(unsigned char*) WI_NOEXCEPT
         {
-            OnErrorReported(false, failure);
         }
-        return true;
-    }
 
-    void InternalInitialize()
-    {
-        m_errorReportingType = ErrorReportingType::Telemetry;
-        Initialize();
-    }
+        template <typename TField, typename... TFields>
+        static void Pack(unsigned char* entry, TField const& field, TFields const&... fields) WI_NOEXCEPT
+        {
+            memcpy_s(entry, sizeof(field), &field, sizeof(field));
+            Pack(entry + sizeof(field), fields...);
+        }
 
-    TraceLoggingHProvider m_providerHandle{};
-    bool m_ownsProviderHandle{};
-    ErrorReportingType m_errorReportingType{};
-};
+        void WriteShard(TraceLoggingHProvider provider, shard_buffer& shard) WI_NOEXCEPT
+        {
+            m_writer(provider, static_cast<UINT16>(shard.count), shard.entries);
+            shard.count = 0;
+        }
 
-template <
-    typename TraceLoggingType,
-    UINT64 keyword = 0,
-    UINT8 level = WINEVENT_LEVEL_VERBOSE,
-    typename TlgReflectorTag = _TlgReflectorTag_Param0IsProviderType> // helps TlgReflector understand that this is a wrapper type
-class BasicActivity : public _TlgActivityBase<BasicActivity<TraceLoggingType, keyword, level, TlgReflectorTag>, keyword, level>
+        batched_event_writer m_writer;
+        shard_buffer m_shards[c_shardCount]{};
+    };
+#pragma warning(pop)
+} // namespace details
+/// @endcond
+
+#ifdef WIL_TRACELOGGING_MEMORY_SINK
+//! An event captured by wil::trace_memory_sink in place of an ETW write.
+struct trace_memory_sink_event
 {
-    using BaseTy = _TlgActivityBase<BasicActivity<TraceLoggingType, keyword, level, TlgReflectorTag>, keyword, level>;
-    friend BaseTy;
+    char name[64];         //!< Event name, truncated if necessary
+    char fieldNames[192];  //!< Field names in declaration order separated by ';', truncated if necessary
+    ULONG fieldCount;      //!< Number of fields described by the event metadata
+    ULONG payloadSize;     //!< Total size in bytes of the field values
+    ULONG metadataSize;    //!< Size in bytes of the event metadata (event name, field names and field types)
+    UCHAR level;           //!< WINEVENT_LEVEL_XXX of the event
+    UCHAR opcode;          //!< WINEVENT_OPCODE_XXX of the event (start and stop for activities)
+    ULONGLONG keyword;     //!< Keywords of the event
+    GUID activityId;       //!< Explicit activity id of the event, or GUID_NULL if written without one
+    UCHAR payload[64];     //!< Leading bytes of the field values, in field order; payloadSize may be larger
+};
 
-    void OnStarted()
+/** Captures the events written by a module built with WIL_TRACELOGGING_MEMORY_SINK.
+Every provider registered through wil::TraceLoggingProvider is enabled for all levels and keywords through a private,
+in-process ETW session owned by the sink (Windows 10 version 1703 or later), so providers see the same enable callbacks
+they would for a real trace session.  Each event written through the TraceLogging macros is then recorded into a ring
+holding the most recent WIL_TRACELOGGING_MEMORY_SINK_CAPACITY events instead of being written to ETW, so tests can
+assert on exactly which events were written and benchmarks can measure per-event cost and payload size reproducibly.
+Because the sink replaces the write for the whole module, a module built this way should contain only sink-aware code.
+~~~~
+wil::trace_memory_sink::instance().clear();
+MyProvider::MyEvent(42);
+wil::trace_memory_sink_event event;
+if (wil::trace_memory_sink::instance().try_get(0, event)) { ... event.name, event.payloadSize ... }
+~~~~
+*/
+class trace_memory_sink
+{
+public:
+    static trace_memory_sink& instance() WI_NOEXCEPT
     {
+        static trace_memory_sink s_instance;
+        return s_instance;
     }
 
-    void OnStopped()
+    ~trace_memory_sink() WI_NOEXCEPT
     {
+        if (m_session != 0)
+        {
+            session_properties properties{};
+            properties.properties.Wnode.BufferSize = sizeof(properties);
+            ::ControlTraceW(m_session, nullptr, &properties.properties, EVENT_TRACE_CONTROL_STOP);
+        }
     }
 
-public:
-    BasicActivity()
+    //! Discards all retained events and resets the running totals.
+    void clear() WI_NOEXCEPT
     {
+        auto lock = m_lock.lock_exclusive();
+        m_totalEvents = 0;
+        m_totalPayloadBytes = 0;
     }
 
-    BasicActivity(BasicActivity&& rhs) : BaseTy(wistd::move(rhs))
+    //! Returns the number of retained events; at most WIL_TRACELOGGING_MEMORY_SINK_CAPACITY.
+    WI_NODISCARD size_t size() const WI_NOEXCEPT
     {
+        auto lock = m_lock.lock_shared();
+        return RetainedCount();
     }
 
-    BasicActivity& operator=(BasicActivity&& rhs)
+    //! Returns the number of events written since the last clear, including those no longer retained.
+    WI_NODISCARD ULONGLONG total_events() const WI_NOEXCEPT
     {
-        BaseTy::operator=(wistd::move(rhs));
-        return *this;
+        auto lock = m_lock.lock_shared();
+        return m_totalEvents;
     }
 
-    /*
-    Returns a handle to the TraceLogging provider associated with this activity.
-    */
-    WI_NODISCARD TraceLoggingHProvider Provider() const
+    //! Returns the total size of the field values of all events written since the last clear.
+    WI_NODISCARD ULONGLONG total_payload_bytes() const WI_NOEXCEPT
     {
-        return TraceLoggingType::Provider();
+        auto lock = m_lock.lock_shared();
+        return m_totalPayloadBytes;
     }
 
-    /*
-    Sets the related (parent) activity.
-    May only be called once. If used, must be called before starting the activity.
-    */
-    template <typename ActivityTy>
-    void SetRelatedActivity(_In_ const ActivityTy& relatedActivity)
+    //! Copies a retained event, where index 0 is the oldest.  Returns false if index is not less than size().
+    bool try_get(size_t index, trace_memory_sink_event& event) const WI_NOEXCEPT
     {
-        this->SetRelatedId(*relatedActivity.Id());
+        auto lock = m_lock.lock_shared();
+        auto const retained = RetainedCount();
+        if (index >= retained)
+        {
+            return false;
+        }
+        event = m_events[static_cast<size_t>((m_totalEvents - retained + index) % c_capacity)];
+        return true;
     }
 
-    /*
-    Sets the related (parent) activity.
-    May only be called once. If used, must be called before starting the activity.
-    */
-    void SetRelatedActivityId(_In_ const GUID& relatedActivityId)
+    /** Enables a registered provider in the sink's session; its enable callback has run by the time this returns.
+    Providers registered through wil::TraceLoggingProvider are enabled for all levels and keywords automatically.  */
+    HRESULT enable_provider(TraceLoggingHProvider provider, UCHAR level = 0xff, ULONGLONG matchAnyKeyword = ~0ull) WI_NOEXCEPT
     {
-        this->SetRelatedId(relatedActivityId);
+        TRACEHANDLE session{};
+        RETURN_IF_FAILED(StartSession(session));
+        RETURN_IF_WIN32_ERROR(::EnableTraceEx2(
+            session,
+            TraceLoggingProviderId(provider),
+            EVENT_CONTROL_CODE_ENABLE_PROVIDER,
+            level,
+            matchAnyKeyword,
+            0,
+            c_enableTimeoutMilliseconds,
+            nullptr));
+        return S_OK;
+    }
+
+    //! Disables a provider in the sink's session; its enable callback has run by the time this returns.
+    HRESULT disable_provider(TraceLoggingHProvider provider) WI_NOEXCEPT
+    {
+        TRACEHANDLE session{};
+        {
+            auto lock = m_sessionLock.lock_shared();
+            session = m_session;
+        }
+        if (session != 0)
+        {
+            RETURN_IF_WIN32_ERROR(::EnableTraceEx2(
+                session,
+                TraceLoggingProviderId(provider),
+                EVENT_CONTROL_CODE_DISABLE_PROVIDER,
+                0,
+                0,
+                0,
+                c_enableTimeoutMilliseconds,
+                nullptr));
+        }
+        return S_OK;
     }
 
-    /*
-    Sets the related (parent) activity.
-    May only be called once. If used, must be called before starting the activity.
-    */
-    void SetRelatedActivityId(_In_ const GUID* relatedActivityId)
+private:
+    static ULONG const c_enableTimeoutMilliseconds = 5000;
+
+    struct session_properties
     {
-        __FAIL_FAST_IMMEDIATE_ASSERT__(relatedActivityId != NULL);
-        this->SetRelatedId(*relatedActivityId);
-    }
-};
+        EVENT_TRACE_PROPERTIES properties;
+        wchar_t name[64];
+    };
+    static size_t const c_capacity = WIL_TRACELOGGING_MEMORY_SINK_CAPACITY;
 
-template <
-    typename TraceLoggingType,
-    UINT64 keyword = 0,
-    UINT8 level = WINEVENT_LEVEL_VERBOSE,
-    typename TlgReflectorTag = _TlgReflectorTag_Param0IsProviderType> // helps TlgReflector understand that this is a wrapper type
-class BasicThreadActivity
-    : public _TlgActivityBase<BasicThreadActivity<TraceLoggingType, keyword, level, TlgReflectorTag>, keyword, level>
-{
-    using BaseTy = _TlgActivityBase<BasicThreadActivity<TraceLoggingType, keyword, level, TlgReflectorTag>, keyword, level>;
-    friend BaseTy;
+    // The TraceLogging macros pass the provider and event metadata as tagged data descriptors ahead of the field values
+    static ULONG const c_eventMetadataDescriptorType = 1;
+    static ULONG const c_providerMetadataDescriptorType = 2;
 
-    void OnStarted()
+    trace_memory_sink() WI_NOEXCEPT = default;
+
+    friend ULONG __stdcall ::wil_details_MemorySinkEventWriteTransfer(
+        REGHANDLE, PCEVENT_DESCRIPTOR, LPCGUID, LPCGUID, ULONG, PEVENT_DATA_DESCRIPTOR) WI_NOEXCEPT;
+
+    // Private sessions only deliver the enable notifications, nothing is ever logged to them since the sink replaces the
+    // write.  Sessions private to a process are named per process, so the name only needs to be unique within it.
+    // The session has its own lock: EnableTraceEx2 waits for enable callbacks, which may write events and so take m_lock.
+    HRESULT StartSession(TRACEHANDLE& session) WI_NOEXCEPT
     {
-        this->PushThreadActivityId();
+        auto lock = m_sessionLock.lock_exclusive();
+        if (m_session == 0)
+        {
+            session_properties properties{};
+            properties.properties.Wnode.BufferSize = sizeof(properties);
+            properties.properties.Wnode.Flags = WNODE_FLAG_TRACED_GUID;
+            properties.properties.Wnode.ClientContext = 1; // QueryPerformanceCounter timestamps
+            properties.properties.LogFileMode = EVENT_TRACE_PRIVATE_LOGGER_MODE | EVENT_TRACE_PRIVATE_IN_PROC;
+            properties.properties.LoggerNameOffset = offsetof(session_properties, name);
+            RETURN_IF_FAILED(
+                StringCchPrintfW(properties.name, ARRAYSIZE(properties.name), L"WilMemorySink%lu", ::GetCurrentProcessId()));
+            RETURN_IF_WIN32_ERROR(::StartTraceW(&m_session, properties.name, &properties.properties));
+        }
+        session = m_session;
+        return S_OK;
     }
 
-    void OnStopped()
+    void Record(PCEVENT_DESCRIPTOR eventDescriptor, LPCGUID activityId, ULONG dataCount, PEVENT_DATA_DESCRIPTOR data) WI_NOEXCEPT
     {
-        this->PopThreadActivityId();
+        trace_memory_sink_event event{};
+        event.level = eventDescriptor->Level;
+        event.opcode = eventDescriptor->Opcode;
+        event.keyword = eventDescriptor->Keyword;
+        if (activityId != nullptr)
+        {
+            event.activityId = *activityId;
+        }
+
+        for (ULONG index = 0; index < dataCount; index++)
+        {
+            if (data[index].Reserved == c_eventMetadataDescriptorType)
+            {
+                event.metadataSize = data[index].Size;
+                auto const metadata = reinterpret_cast<UINT8 const*>(static_cast<ULONG_PTR>(data[index].Ptr));
+                ParseEventMetadata(metadata, data[index].Size, event);
+            }
+            else if (data[index].Reserved != c_providerMetadataDescriptorType)
+            {
+                if (event.payloadSize < sizeof(event.payload))
+                {
+                    auto const available = static_cast<ULONG>(sizeof(event.payload)) - event.payloadSize;
+                    auto const copied = (data[index].Size < available) ? data[index].Size : available;
+                    auto const field = reinterpret_cast<void const*>(static_cast<ULONG_PTR>(data[index].Ptr));
+                    memcpy_s(event.payload + event.payloadSize, available, field, copied);
+                }
+                event.payloadSize += data[index].Size;
+            }
+        }
+
+        auto lock = m_lock.lock_exclusive();
+        m_events[static_cast<size_t>(m_totalEvents % c_capacity)] = event;
+        m_totalEvents++;
+        m_totalPayloadBytes += event.payloadSize;
     }
 
-public:
-    BasicThreadActivity()
+    // Event metadata is a UINT16 total size, a run of tag bytes (high bit set on all but the last), the event name and
+    // then for each field its name, in-type, optional out-type and field tags, and optional count or schema.
+    static void ParseEventMetadata(
+        _In_reads_bytes_(size) UINT8 const* metadata, ULONG size, trace_memory_sink_event& event) WI_NOEXCEPT
     {
+        ULONG offset = sizeof(UINT16);
+        SkipChainedBytes(metadata, size, offset);
+        if (!ReadName(metadata, size, offset, event.name, ARRAYSIZE(event.name)))
+        {
+            return;
+        }
+
+        while (offset < size)
+        {
+            char fieldName[64];
+            if (!ReadName(metadata, size, offset, fieldName, ARRAYSIZE(fieldName)) || (offset >= size))
+            {
+                return;
+            }
+            if (event.fieldCount != 0)
+            {
+                StringCchCatA(event.fieldNames, ARRAYSIZE(event.fieldNames), ";");
+            }
+            StringCchCatA(event.fieldNames, ARRAYSIZE(event.fieldNames), fieldName);
+            event.fieldCount++;
+
+            UINT8 const inType = metadata[offset++];
+            if (WI_IsFlagSet(inType, 0x80) && (offset < size))
+            {
+                UINT8 const outType = metadata[offset++];
+                if (WI_IsFlagSet(outType, 0x80))
+                {
+                    SkipChainedBytes(metadata, size, offset);
+                }
+            }
+
+            auto const countKind = inType & 0x60;
+            if (countKind == 0x20) // fixed element count
+            {
+                offset += sizeof(UINT16);
+            }
+            else if ((countKind == 0x60) && (offset + sizeof(UINT16) <= size)) // custom schema
+            {
+                offset += sizeof(UINT16) + *reinterpret_cast<UINT16 UNALIGNED const*>(metadata + offset);
+            }
+        }
     }
 
-    BasicThreadActivity(BasicThreadActivity&& rhs) : BaseTy(wistd::move(rhs))
+    static void SkipChainedBytes(_In_reads_bytes_(size) UINT8 const* metadata, ULONG size, ULONG& offset) WI_NOEXCEPT
     {
+        while ((offset < size) && WI_IsFlagSet(metadata[offset++], 0x80))
+        {
+        }
     }
 
-    BasicThreadActivity& operator=(BasicThreadActivity&& rhs)
+    static bool ReadName(
+        _In_reads_bytes_(size) UINT8 const* metadata,
+        ULONG size,
+        ULONG& offset,
+        _Out_writes_(nameLength) char* name,
+        size_t nameLength) WI_NOEXCEPT
     {
-        BaseTy::operator=(wistd::move(rhs));
-        return *this;
+        auto const start = offset;
+        while ((offset < size) && (metadata[offset] != 0))
+        {
+            offset++;
+        }
+        if (offset >= size)
+        {
+            return false;
+        }
+        StringCchCopyA(name, nameLength, reinterpret_cast<PCSTR>(metadata + start));
+        offset++;
+        return true;
     }
 
-    /*
-    Returns a handle to the TraceLogging provider associated with this activity.
-    */
-    WI_NODISCARD TraceLoggingHProvider Provider() const
+    WI_NODISCARD size_t RetainedCount() const WI_NOEXCEPT
     {
-        return TraceLoggingType::Provider();
+        return (m_totalEvents < c_capacity) ? static_cast<size_t>(m_totalEvents) : c_capacity;
     }
-};
 
-/// @cond
-#define __WI_TraceLoggingWriteTagged(activity, name, ...) \
-    __pragma(warning(push)) __pragma(warning(disable : 4127)) do \
-    { \
-        _tlgActivityDecl(activity) \
-            TraceLoggingWriteActivity(TraceLoggingType::Provider(), (name), _tlgActivityRef(activity).Id(), NULL, ##__VA_ARGS__); \
-    } \
-    while (0) \
-    __pragma(warning(pop)) /// @endcond
+    mutable srwlock m_lock;
+    ULONGLONG m_totalEvents{};
+    ULONGLONG m_totalPayloadBytes{};
+    srwlock m_sessionLock;
+    TRACEHANDLE m_session{};
+    trace_memory_sink_event m_events[c_capacity]{};
+};
+#endif
 
-// This is the ultimate base class implementation for all activities.  Activity classes are defined with
-// DEFINE_TRACELOGGING_ACTIVITY, DEFINE_CALLCONTEXT_ACTIVITY, DEFINE_TELEMETRY_ACTIVITY and others
+// This class acts as a simple RAII class returned by a call to ContinueOnCurrentThread() for an activity
+// or by a call to WatchCurrentThread() on a provider.  The result is meant to be a stack local variable
+// whose scope controls the lifetime of an error watcher on the given thread.  That error watcher re-directs
+// errors occurrent within the object's lifetime to the associated provider or activity.
 
-template <typename ActivityTraceLoggingType, ActivityOptions options = ActivityOptions::None, UINT64 keyword = 0, UINT8 level = WINEVENT_LEVEL_VERBOSE, UINT64 privacyTag = 0, typename TlgReflectorTag = _TlgReflectorTag_Param0IsProviderType>
-class ActivityBase : public details::IFailureCallback
+class ActivityThreadWatcher
 {
 public:
-    typedef ActivityTraceLoggingType TraceLoggingType;
-
-    static UINT64 const Keyword = keyword;
-    static UINT8 const Level = level;
-    static UINT64 const PrivacyTag = privacyTag;
-
-    ActivityBase(PCSTR contextName, bool shouldWatchErrors = false) WI_NOEXCEPT
-        : m_activityData(contextName),
-          m_pActivityData(&m_activityData),
-          m_callbackHolder(this, m_activityData.GetCallContext(), shouldWatchErrors)
-    {
-    }
-
-    ActivityBase(ActivityBase&& other, bool shouldWatchErrors) WI_NOEXCEPT
-        : m_activityData(wistd::move(other.m_activityData)),
-          m_sharedActivityData(wistd::move(other.m_sharedActivityData)),
-          m_callbackHolder(this, nullptr, shouldWatchErrors)
+    ActivityThreadWatcher() WI_NOEXCEPT : m_callbackHolder(nullptr, nullptr, false)
     {
-        m_pActivityData = m_sharedActivityData ? m_sharedActivityData.get() : &m_activityData;
-        m_callbackHolder.SetCallContext(m_pActivityData->GetCallContext());
-        other.m_pActivityData = &other.m_activityData;
-        if (other.m_callbackHolder.IsWatching())
-        {
-            other.m_callbackHolder.StopWatching();
-        }
     }
 
-    ActivityBase(ActivityBase&& other) WI_NOEXCEPT : ActivityBase(wistd::move(other), other.m_callbackHolder.IsWatching())
+    ActivityThreadWatcher(_In_ details::IFailureCallback* pCallback, PCSTR staticContextName) WI_NOEXCEPT
+        : m_callContext(staticContextName),
+          m_callbackHolder(pCallback, &m_callContext, true, &details::StoredCallContextInfo::PrepareForFailure)
     {
     }
 
-    ActivityBase(ActivityBase const& other) WI_NOEXCEPT
-        : m_activityData(),
-          m_pActivityData(&m_activityData),
-          m_callbackHolder(this, nullptr, false) // false = do not automatically watch for failures
+    ActivityThreadWatcher(
+        _In_ details::IFailureCallback* pCallback, PCSTR staticContextName, _Printf_format_string_ PCSTR formatString, va_list argList) WI_NOEXCEPT
+        : ActivityThreadWatcher(pCallback, staticContextName)
     {
-        operator=(other);
+        m_callContext.SetMessage(formatString, argList);
     }
 
-    ActivityBase& operator=(ActivityBase&& other) WI_NOEXCEPT
+    // Uses the supplied StoredCallContextInfo rather than producing one itself
+    ActivityThreadWatcher(_In_ details::IFailureCallback* pCallback, _In_ details::StoredCallContextInfo const& callContext) WI_NOEXCEPT
+        : m_callContext(callContext),
+          m_callbackHolder(pCallback, &m_callContext, true, &details::StoredCallContextInfo::PrepareForFailure)
     {
-        m_activityData = wistd::move(other.m_activityData);
-        m_sharedActivityData = wistd::move(other.m_sharedActivityData);
-        m_pActivityData = m_sharedActivityData ? m_sharedActivityData.get() : &m_activityData;
-        m_callbackHolder.SetCallContext(m_pActivityData->GetCallContext());
-        m_callbackHolder.SetWatching(other.m_callbackHolder.IsWatching());
-        other.m_pActivityData = &other.m_activityData;
-        if (other.m_callbackHolder.IsWatching())
-        {
-            other.m_callbackHolder.StopWatching();
-        }
-        return *this;
     }
 
-    ActivityBase& operator=(ActivityBase const& other) WI_NOEXCEPT
+    ActivityThreadWatcher(ActivityThreadWatcher&& other) WI_NOEXCEPT : m_callContext(wistd::move(other.m_callContext)),
+                                                                       m_callbackHolder(wistd::move(other.m_callbackHolder))
     {
-        if (m_callbackHolder.IsWatching())
-        {
-            m_callbackHolder.StopWatching();
-        }
-
-        if (other.m_sharedActivityData)
-        {
-            m_pActivityData = other.m_pActivityData;
-            m_sharedActivityData = other.m_sharedActivityData;
-        }
-        else if (m_sharedActivityData.create(wistd::move(other.m_activityData)))
-        {
-            // Locking should not be required as the first copy should always take place on the owning
-            // thread...
-            m_pActivityData = m_sharedActivityData.get();
-            other.m_sharedActivityData = m_sharedActivityData;
-            other.m_pActivityData = m_pActivityData;
-            other.m_callbackHolder.SetCallContext(m_pActivityData->GetCallContext());
-        }
-        m_callbackHolder.SetCallContext(m_pActivityData->GetCallContext());
-        return *this;
+        m_callbackHolder.SetCallContext(&m_callContext, &details::StoredCallContextInfo::PrepareForFailure);
     }
 
-    // These calls all result in setting a message to associate with any failures that might occur while
-    // running the activity.  For example, you could associate a filename with a call context activity
-    // so that the file name is only reported if the activity fails with the failure.
+    ActivityThreadWatcher(ActivityThreadWatcher const&) = delete;
+    ActivityThreadWatcher& operator=(ActivityThreadWatcher const&) = delete;
 
-    void SetMessage(_In_ _Printf_format_string_ PCSTR formatString, ...)
+    void SetMessage(_Printf_format_string_ PCSTR formatString, ...)
     {
         va_list argList;
         va_start(argList, formatString);
-        auto lock = LockExclusive();
-        GetCallContext()->SetMessage(formatString, argList);
+        m_callContext.SetMessage(formatString, argList);
         va_end(argList);
     }
 
     void SetMessage(_In_opt_ PCWSTR message)
     {
-        auto lock = LockExclusive();
-        GetCallContext()->SetMessage(message);
+        m_callContext.SetMessage(message);
     }
 
     void SetMessageCopy(_In_opt_ PCWSTR message)
     {
-        auto lock = LockExclusive();
-        GetCallContext()->SetMessageCopy(message);
+        m_callContext.SetMessageCopy(message);
     }
 
-    // This call stops watching for errors on the thread that the activity was originally
-    // created on.  Use it when moving the activity into a thread-agnostic class or moving
-    // an activity across threads.
+private:
+    details::StoredCallContextInfo m_callContext;
+    details::ThreadFailureCallbackHolder m_callbackHolder;
+};
 
-    void IgnoreCurrentThread() WI_NOEXCEPT
+// This is the base-class implementation of a TraceLogging class.  TraceLogging classes are defined with
+// BEGIN_TRACELOGGING_CLASS and automatically derive from this class
+
+enum class ErrorReportingType
+{
+    None = 0,
+    Telemetry,
+    TraceLogging
+};
+
+class TraceLoggingProvider : public details::IFailureCallback
+{
+public:
+    // Only one instance of each of these derived classes should be created
+    TraceLoggingProvider(_In_ TraceLoggingProvider const&) = delete;
+    TraceLoggingProvider& operator=(TraceLoggingProvider const&) = delete;
+    void* operator new(size_t) = delete;
+    void* operator new[](size_t) = delete;
+
+protected:
+    // This can be overridden to provide specific initialization code for any individual provider.
+    // It will be ran once when the single static singleton instance of this class is created.
+    virtual void Initialize() WI_NOEXCEPT
     {
-        if (m_callbackHolder.IsWatching())
-        {
-            m_callbackHolder.StopWatching();
-        }
     }
 
-    // Call this API to retrieve an RAII object to watch events on the current thread.  The returned
-    // object should only be used on the stack.
-
-    WI_NODISCARD ActivityThreadWatcher ContinueOnCurrentThread() WI_NOEXCEPT
+    // This method can be overridden by a provider to more tightly control what happens in the event
+    // of a failure in a CallContext activity, WatchCurrentThread() object, or attributed to a specific failure.
+    virtual void OnErrorReported(bool alreadyReported, FailureInfo const& failure) WI_NOEXCEPT
     {
-        if (IsRunning())
+        if (!alreadyReported && WI_IsFlagClear(failure.flags, FailureFlags::RequestSuppressTelemetry))
         {
-            return ActivityThreadWatcher(this, *m_pActivityData->GetCallContext());
+            if (m_errorReportingType == ErrorReportingType::Telemetry)
+            {
+                ReportTelemetryFailure(failure);
+            }
+            else if (m_errorReportingType == ErrorReportingType::TraceLogging)
+            {
+                ReportTraceLoggingFailure(failure);
+            }
         }
-        return ActivityThreadWatcher();
     }
 
-    // This is the 'default' Stop routine that accepts an HRESULT and completes the activity...
+public:
+    WI_NODISCARD TraceLoggingHProvider Provider_() const WI_NOEXCEPT
+    {
+        return m_providerHandle;
+    }
 
-    void Stop(HRESULT hr = S_OK) WI_NOEXCEPT
+protected:
+    TraceLoggingProvider() WI_NOEXCEPT
     {
-        bool stopActivity;
-        HRESULT hrLocal;
+    }
+
+    virtual ~TraceLoggingProvider() WI_NOEXCEPT
+    {
+        if (m_periodicEventTimer)
         {
-            auto lock = LockExclusive();
-            stopActivity = m_pActivityData->SetStopResult(hr, &hrLocal);
+            // Destroying a threadpool timer is invalid during process termination, so just abandon it
+            if (ProcessShutdownInProgress())
+            {
+                m_periodicEventTimer.release();
+            }
+            else
+            {
+                m_periodicEventTimer.reset();
+            }
         }
-        if (stopActivity)
+        FlushPeriodicEvents_();
+
+        if (m_enablementCache != nullptr)
         {
-            ReportStopActivity(hrLocal);
+            m_enablementCache->Detach();
         }
-        else
+        if (m_ownsProviderHandle)
         {
-            __WI_TraceLoggingWriteTagged(
-                *this,
-                "ActivityIntermediateStop",
-                TraceLoggingKeyword(Keyword),
-                TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
-                __ACTIVITY_STOP_PARAMS(hr));
+            TraceLoggingUnregister(m_providerHandle);
         }
-        IgnoreCurrentThread();
     }
 
-    // IFailureCallback
-
-    bool NotifyFailure(FailureInfo const& failure) WI_NOEXCEPT override
+    WI_NODISCARD bool IsEnabled_(
+        UCHAR eventLevel /* WINEVENT_LEVEL_XXX, e.g. WINEVENT_LEVEL_VERBOSE */,
+        ULONGLONG eventKeywords /* MICROSOFT_KEYWORD_XXX */) const WI_NOEXCEPT
     {
-        // We always report errors to the ETW stream, but we hold-back the telemetry keyword if we've already reported this error
-        // to this particular telemetry provider.
-
-        __TRACELOGGING_TEST_HOOK_ACTIVITY_ERROR(failure);
-
-        if (WI_IsFlagClear(failure.flags, FailureFlags::RequestSuppressTelemetry))
-        {
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wunused-value"
-#endif
-#pragma warning(push)
-#pragma warning(disable : 6319)
-            if (false, WI_IsFlagSet(options, ActivityOptions::TelemetryOnFailure) && !WasAlreadyReportedToTelemetry(failure.failureId))
-            {
-                __WI_TraceLoggingWriteTagged(
-                    *this,
-                    "ActivityError",
-                    TraceLoggingKeyword(Keyword | MICROSOFT_KEYWORD_TELEMETRY),
-                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
-                    __ACTIVITY_ERROR_TELEMETRY_FAILURE_PARAMS(failure));
-            }
-            else if (false, WI_IsFlagSet(options, ActivityOptions::TraceLoggingOnFailure))
-            {
-                __WI_TraceLoggingWriteTagged(
-                    *this,
-                    "ActivityError",
-                    TraceLoggingKeyword(0),
-                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
-                    __ACTIVITY_ERROR_TRACELOGGING_FAILURE_PARAMS(failure));
-            }
-            else
-            {
-                __WI_TraceLoggingWriteTagged(
-                    *this,
-                    "ActivityError",
-                    TraceLoggingKeyword(Keyword),
-                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
-                    __ACTIVITY_ERROR_TRACELOGGING_FAILURE_PARAMS(failure));
-            }
-#pragma warning(pop)
-#ifdef __clang__
-#pragma clang diagnostic pop
-#endif
-        }
-
-        auto lock = LockExclusive();
-        m_pActivityData->NotifyFailure(failure);
-        return true;
+        return ((m_providerHandle != nullptr) && TraceLoggingProviderEnabled(m_providerHandle, eventLevel, eventKeywords)) ||
+               __TRACELOGGING_TEST_HOOK_SET_ENABLED;
     }
 
-    // This is the base TraceLoggingActivity<> contract...  we implement it so that this class
-    // can be used by all of the activity macros and we re-route the request as needed.
-    //
-    // The contract required by the TraceLogging Activity macros is:
-    // - activity.Keyword    // compile-time constant
-    // - activity.Level      // compile-time constant
-    // - activity.PrivacyTag // compile-time constant
-    // - activity.Provider()
-    // - activity.Id()
-    // - activity.zInternalRelatedId()
-    // - activity.zInternalStart()
-    // - activity.zInternalStop()
-    // In addition, for TlgReflector to work correctly, it must be possible for
-    // TlgReflector to statically map from typeof(activity) to hProvider.
-
-    WI_NODISCARD GUID const* zInternalRelatedId() const WI_NOEXCEPT
+    void SetErrorReportingType_(ErrorReportingType type)
     {
-        return m_pActivityData->zInternalRelatedId();
+        m_errorReportingType = type;
     }
 
-    void zInternalStart() WI_NOEXCEPT
+    static bool WasAlreadyReportedToTelemetry(long failureId) WI_NOEXCEPT
     {
-        auto lock = LockExclusive();
-        m_pActivityData->zInternalStart();
+        static long volatile s_lastFailureSeen = -1;
+        long oldValue = InterlockedExchange(&s_lastFailureSeen, failureId);
+        auto wasSeen = (oldValue == failureId);
+        return wasSeen;
     }
 
-    void zInternalStop() WI_NOEXCEPT
+    void ReportTelemetryFailure(FailureInfo const& failure) WI_NOEXCEPT
     {
-        auto lock = LockExclusive();
-        m_pActivityData->zInternalStop();
+        __TRACELOGGING_TEST_HOOK_ERROR(failure);
+        TraceLoggingWrite(
+            m_providerHandle,
+            "FallbackError",
+            TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
+            TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY),
+            TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
+            __RESULT_TELEMETRY_FAILURE_PARAMS(failure));
     }
 
-    static TraceLoggingHProvider Provider() WI_NOEXCEPT
+    void ReportTraceLoggingFailure(FailureInfo const& failure) WI_NOEXCEPT
     {
-        return ActivityTraceLoggingType::Provider();
+        TraceLoggingWrite(
+            m_providerHandle, "FallbackError", TraceLoggingLevel(WINEVENT_LEVEL_ERROR), __RESULT_TRACELOGGING_FAILURE_PARAMS(failure));
     }
 
-    WI_NODISCARD GUID const* Id() const WI_NOEXCEPT
+    // Helper function for TraceLoggingError.
+    // It prints out a trace message for debug purposes. The message does not go into the telemetry.
+    void ReportTraceLoggingError(_In_ _Printf_format_string_ PCSTR formatString, va_list argList) WI_NOEXCEPT
     {
-        return m_pActivityData->Id();
+        if (IsEnabled_(WINEVENT_LEVEL_ERROR, 0))
+        {
+            wchar_t loggingMessage[2048];
+            details::PrintLoggingMessage(loggingMessage, ARRAYSIZE(loggingMessage), formatString, argList);
+            TraceLoggingWrite(
+                m_providerHandle,
+                "TraceLoggingError",
+                TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
+                TraceLoggingWideString(loggingMessage, "traceLoggingMessage"));
+        }
     }
 
-    WI_NODISCARD GUID const* providerGuid() const WI_NOEXCEPT
+    // Helper function for TraceLoggingInfo.
+    // It prints out a trace message for debug purposes. The message does not go into the telemetry.
+    void ReportTraceLoggingMessage(_In_ _Printf_format_string_ PCSTR formatString, va_list argList) WI_NOEXCEPT
     {
-        return m_pActivityData->providerGuid();
+        if (IsEnabled_(WINEVENT_LEVEL_VERBOSE, 0))
+        {
+            wchar_t loggingMessage[2048];
+            details::PrintLoggingMessage(loggingMessage, ARRAYSIZE(loggingMessage), formatString, argList);
+            TraceLoggingWrite(
+                m_providerHandle,
+                "TraceLoggingInfo",
+                TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                TraceLoggingWideString(loggingMessage, "traceLoggingMessage"));
+        }
     }
 
-    template <class OtherTy>
-    void SetRelatedActivity(OtherTy const& relatedActivity) WI_NOEXCEPT
+    // Adds a source (such as an activity duration histogram or a batched event) to the set that this provider
+    // periodically drains into events.  Sources are never removed; they are static and outlive the provider.
+    void RegisterPeriodicEventSource_(_In_ details::periodic_event_source* source) WI_NOEXCEPT
     {
-        auto lock = LockExclusive();
-        m_pActivityData->SetRelatedActivityId(relatedActivity.Id());
+        auto lock = m_periodicEventLock.lock_exclusive();
+        source->m_nextFlushTick = ::GetTickCount64() + source->m_flushIntervalMs;
+        source->m_next = m_periodicEventSources;
+        m_periodicEventSources = source;
+
+        // The timer ticks at the shortest interval of any registered source
+        auto const shortensInterval = (m_periodicEventIntervalMs == 0) || (source->m_flushIntervalMs < m_periodicEventIntervalMs);
+        if (shortensInterval && !ProcessShutdownInProgress())
+        {
+            if (!m_periodicEventTimer)
+            {
+                m_periodicEventTimer.reset(::CreateThreadpoolTimer(&PeriodicEventTimerCallback, this, nullptr));
+            }
+            if (m_periodicEventTimer)
+            {
+                m_periodicEventIntervalMs = source->m_flushIntervalMs;
+                FILETIME dueTime{};
+                *reinterpret_cast<PLONGLONG>(&dueTime) = -static_cast<LONGLONG>(m_periodicEventIntervalMs) * 10000;
+                ::SetThreadpoolTimer(m_periodicEventTimer.get(), &dueTime, m_periodicEventIntervalMs, 0);
+            }
+        }
     }
 
-    void SetRelatedActivityId(_In_ const GUID& relatedActivityId) WI_NOEXCEPT
+    // Drains every registered periodic event source, such as writing one "ActivityDurationSummary" event for each
+    // activity histogram that recorded durations and emitting all buffered batched events.
+    void FlushPeriodicEvents_() WI_NOEXCEPT
     {
-        auto lock = LockExclusive();
-        m_pActivityData->SetRelatedActivityId(&relatedActivityId);
+        auto lock = m_periodicEventLock.lock_exclusive();
+        for (auto source = m_periodicEventSources; source != nullptr; source = source->m_next)
+        {
+            source->Flush(m_providerHandle);
+        }
     }
 
-    void SetRelatedActivityId(_In_ const GUID* relatedActivityId) WI_NOEXCEPT
+    // When an enablement cache is given, the cache's enable callback is registered in place of 'callback', refreshing
+    // the cache before forwarding to 'callback' (with a null context).
+    void Register(
+        TraceLoggingHProvider const providerHandle,
+        TLG_PENABLECALLBACK callback = nullptr,
+        _In_opt_ details::event_enablement_cache* enablementCache = nullptr) WI_NOEXCEPT
     {
-        auto lock = LockExclusive();
-        m_pActivityData->SetRelatedActivityId(relatedActivityId);
+        // taking over the lifetime and management of providerHandle
+        m_providerHandle = providerHandle;
+        m_ownsProviderHandle = true;
+        m_enablementCache = enablementCache;
+        if (enablementCache != nullptr)
+        {
+            enablementCache->Attach(providerHandle, callback);
+            TraceLoggingRegisterEx(providerHandle, &details::event_enablement_cache::EnableCallback, enablementCache);
+        }
+        else
+        {
+            TraceLoggingRegisterEx(providerHandle, callback, nullptr);
+        }
+#ifdef WIL_TRACELOGGING_MEMORY_SINK
+        LOG_IF_FAILED(trace_memory_sink::instance().enable_provider(providerHandle));
+#endif
+        InternalInitialize();
     }
 
-    WI_NODISCARD inline bool IsRunning() const WI_NOEXCEPT
+    void AttachProvider(TraceLoggingHProvider const providerHandle) WI_NOEXCEPT
     {
-        return m_pActivityData->NeedsStopped();
+        m_providerHandle = providerHandle;
+        m_ownsProviderHandle = false;
+#ifdef WIL_TRACELOGGING_MEMORY_SINK
+        LOG_IF_FAILED(trace_memory_sink::instance().enable_provider(providerHandle));
+#endif
+        InternalInitialize();
     }
 
-protected:
-    virtual void StopActivity() WI_NOEXCEPT = 0;
-    virtual bool WasAlreadyReportedToTelemetry(long failureId) WI_NOEXCEPT = 0;
-
-    void EnsureWatchingCurrentThread()
+private:
+    // IFailureCallback
+    bool NotifyFailure(FailureInfo const& failure) WI_NOEXCEPT override
     {
-        if (!m_callbackHolder.IsWatching())
+        if (!WasAlreadyReportedToTelemetry(failure.failureId))
         {
-            m_callbackHolder.StartWatching();
+            OnErrorReported(false, failure);
         }
+        return true;
     }
 
-    void SetStopResult(HRESULT hr, _Out_opt_ HRESULT* phr = nullptr) WI_NOEXCEPT
+    void InternalInitialize()
     {
-        auto lock = LockExclusive();
-        m_pActivityData->SetStopResult(hr, phr);
+        m_errorReportingType = ErrorReportingType::Telemetry;
+        Initialize();
     }
 
-    void IncrementExpectedStopCount() WI_NOEXCEPT
+    static void __stdcall PeriodicEventTimerCallback(PTP_CALLBACK_INSTANCE, PVOID context, PTP_TIMER) WI_NOEXCEPT
     {
-        auto lock = LockExclusive();
-        m_pActivityData->IncrementExpectedStopCount();
+        auto const pThis = static_cast<TraceLoggingProvider*>(context);
+        auto const now = ::GetTickCount64();
+        auto lock = pThis->m_periodicEventLock.lock_exclusive();
+        for (auto source = pThis->m_periodicEventSources; source != nullptr; source = source->m_next)
+        {
+            if (now >= source->m_nextFlushTick)
+            {
+                source->m_nextFlushTick = now + source->m_flushIntervalMs;
+                source->Flush(pThis->m_providerHandle);
+            }
+        }
     }
 
-    // Locking should not be required on these accessors as we only use this at reporting (which will only happen from
-    // the final stop)
+    TraceLoggingHProvider m_providerHandle{};
+    bool m_ownsProviderHandle{};
+    details::event_enablement_cache* m_enablementCache{};
+    ErrorReportingType m_errorReportingType{};
+    details::periodic_event_source* m_periodicEventSources{};
+    ULONG m_periodicEventIntervalMs{};
+    wil::srwlock m_periodicEventLock;
+    wil::unique_threadpool_timer m_periodicEventTimer;
+};
 
-    FailureInfo const* GetFailureInfo() WI_NOEXCEPT
+template <
+    typename TraceLoggingType,
+    UINT64 keyword = 0,
+    UINT8 level = WINEVENT_LEVEL_VERBOSE,
+    typename TlgReflectorTag = _TlgReflectorTag_Param0IsProviderType> // helps TlgReflector understand that this is a wrapper type
+class BasicActivity : public _TlgActivityBase<BasicActivity<TraceLoggingType, keyword, level, TlgReflectorTag>, keyword, level>
+{
+    using BaseTy = _TlgActivityBase<BasicActivity<TraceLoggingType, keyword, level, TlgReflectorTag>, keyword, level>;
+    friend BaseTy;
+
+    void OnStarted()
     {
-        return m_pActivityData->GetFailureInfo();
     }
 
-    WI_NODISCARD inline HRESULT GetResult() const WI_NOEXCEPT
+    void OnStopped()
     {
-        return m_pActivityData->GetResult();
     }
 
-    WI_NODISCARD details::StoredCallContextInfo* GetCallContext() const WI_NOEXCEPT
+public:
+    BasicActivity()
     {
-        return m_pActivityData->GetCallContext();
     }
 
-    // Think of this routine as the destructor -- since we need to call virtual derived methods, we can't use it as
-    // a destructor without a pure virtual method call, so we have the derived class call it in its destructor...
-
-    void Destroy() WI_NOEXCEPT
+    BasicActivity(BasicActivity&& rhs) : BaseTy(wistd::move(rhs))
     {
-        bool fStop = true;
-        if (m_sharedActivityData)
-        {
-            // The lock unifies the 'unique()' check and the 'reset()' of any non-unique activity so that we
-            // can positively identify the final release of the internal data
+    }
 
-            auto lock = LockExclusive();
-            if (!m_sharedActivityData.unique())
-            {
-                fStop = false;
-                m_sharedActivityData.reset();
-            }
-        }
+    BasicActivity& operator=(BasicActivity&& rhs)
+    {
+        BaseTy::operator=(wistd::move(rhs));
+        return *this;
+    }
 
-        if (fStop && m_pActivityData->NeedsStopped())
-        {
-            ReportStopActivity(m_pActivityData->SetUnhandledException());
-        }
+    /*
+    Returns a handle to the TraceLogging provider associated with this activity.
+    */
+    WI_NODISCARD TraceLoggingHProvider Provider() const
+    {
+        return TraceLoggingType::Provider();
     }
 
-private:
-    void ReportStopActivity(HRESULT hr) WI_NOEXCEPT
+    /*
+    Sets the related (parent) activity.
+    May only be called once. If used, must be called before starting the activity.
+    */
+    template <typename ActivityTy>
+    void SetRelatedActivity(_In_ const ActivityTy& relatedActivity)
     {
-        if (FAILED(hr) &&
-            WI_AreAllFlagsClear(Keyword, (MICROSOFT_KEYWORD_TELEMETRY | MICROSOFT_KEYWORD_MEASURES | MICROSOFT_KEYWORD_CRITICAL_DATA)) &&
-            WI_IsFlagSet(options, ActivityOptions::TelemetryOnFailure))
-        {
-            wil::FailureInfo const* pFailure = GetFailureInfo();
-            if (pFailure != nullptr)
-            {
-                __TRACELOGGING_TEST_HOOK_CALLCONTEXT_ERROR(pFailure, pFailure->hr);
-                auto& failure = *pFailure;
-                __WI_TraceLoggingWriteTagged(
-                    *this,
-                    "ActivityFailure",
-                    TraceLoggingKeyword(Keyword | MICROSOFT_KEYWORD_TELEMETRY),
-                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
-                    __ACTIVITY_FAILURE_TELEMETRY_FAILURE_PARAMS(failure));
-            }
-            else
-            {
-                __TRACELOGGING_TEST_HOOK_CALLCONTEXT_ERROR(nullptr, hr);
-                __WI_TraceLoggingWriteTagged(
-                    *this,
-                    "ActivityFailure",
-                    TraceLoggingKeyword(Keyword | MICROSOFT_KEYWORD_TELEMETRY),
-                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
-                    __ACTIVITY_FAILURE_TELEMETRY_PARAMS(
-                        hr, m_pActivityData->GetCallContext()->contextName, m_pActivityData->GetCallContext()->contextMessage));
-            }
-        }
-
-        StopActivity();
+        this->SetRelatedId(*relatedActivity.Id());
     }
 
-    rwlock_release_exclusive_scope_exit LockExclusive() WI_NOEXCEPT
+    /*
+    Sets the related (parent) activity.
+    May only be called once. If used, must be called before starting the activity.
+    */
+    void SetRelatedActivityId(_In_ const GUID& relatedActivityId)
     {
-        // We only need to lock when we're sharing....
-        return (m_sharedActivityData ? m_sharedActivityData->LockExclusive() : rwlock_release_exclusive_scope_exit());
+        this->SetRelatedId(relatedActivityId);
     }
 
-    template <typename ActivityTraceLoggingTypeOther, typename TlgReflectorTagOther = _TlgReflectorTag_Param0IsProviderType>
-    class ActivityData : public _TlgActivityBase<ActivityData<ActivityTraceLoggingTypeOther, TlgReflectorTagOther>, keyword, level>
+    /*
+    Sets the related (parent) activity.
+    May only be called once. If used, must be called before starting the activity.
+    */
+    void SetRelatedActivityId(_In_ const GUID* relatedActivityId)
     {
-        using BaseTy = _TlgActivityBase<ActivityData<ActivityTraceLoggingTypeOther, TlgReflectorTagOther>, keyword, level>;
-        friend BaseTy;
-        void OnStarted()
-        {
-        }
-        void OnStopped()
-        {
-        }
+        __FAIL_FAST_IMMEDIATE_ASSERT__(relatedActivityId != NULL);
+        this->SetRelatedId(*relatedActivityId);
+    }
+};
 
-        // SFINAE dispatching on presence of ActivityTraceLoggingTypeOther::CreateActivityId(_Out_ GUID& childActivityId, _In_opt_ const GUID* relatedActivityId)
-        template <typename ProviderType>
-        auto CreateActivityIdByProviderType(int, _Out_ GUID& childActivityId)
-            -> decltype(ProviderType::CreateActivityId(childActivityId, this->GetRelatedId()), (void)0)
-        {
-            ProviderType::CreateActivityId(childActivityId, this->GetRelatedId());
-        }
+template <
+    typename TraceLoggingType,
+    UINT64 keyword = 0,
+    UINT8 level = WINEVENT_LEVEL_VERBOSE,
+    typename TlgReflectorTag = _TlgReflectorTag_Param0IsProviderType> // helps TlgReflector understand that this is a wrapper type
+class BasicThreadActivity
+    : public _TlgActivityBase<BasicThreadActivity<TraceLoggingType, keyword, level, TlgReflectorTag>, keyword, level>
+{
+    using BaseTy = _TlgActivityBase<BasicThreadActivity<TraceLoggingType, keyword, level, TlgReflectorTag>, keyword, level>;
+    friend BaseTy;
 
-        template <typename ProviderType>
-        auto CreateActivityIdByProviderType(long, _Out_ GUID& childActivityId) -> void
-        {
-            EventActivityIdControl(EVENT_ACTIVITY_CTRL_CREATE_ID, &childActivityId);
-        }
+    void OnStarted()
+    {
+        this->PushThreadActivityId();
+    }
 
-        void CreateActivityId(_Out_ GUID& childActivityId)
-        {
-            CreateActivityIdByProviderType<ActivityTraceLoggingTypeOther>(0, childActivityId);
-        }
+    void OnStopped()
+    {
+        this->PopThreadActivityId();
+    }
 
-    public:
-        ActivityData(_In_opt_ PCSTR contextName = nullptr) WI_NOEXCEPT : BaseTy(),
-                                                                         m_callContext(contextName),
-                                                                         m_result(S_OK),
-                                                                         m_stopCountExpected(1)
-        {
-        }
+public:
+    BasicThreadActivity()
+    {
+    }
 
-        ActivityData(ActivityData&& other) WI_NOEXCEPT : BaseTy(wistd::move(other)),
-                                                         m_callContext(wistd::move(other.m_callContext)),
-                                                         m_result(other.m_result),
-                                                         m_failure(wistd::move(other.m_failure)),
-                                                         m_stopCountExpected(other.m_stopCountExpected)
-        {
-        }
+    BasicThreadActivity(BasicThreadActivity&& rhs) : BaseTy(wistd::move(rhs))
+    {
+    }
 
-        ActivityData& operator=(ActivityData&& other) WI_NOEXCEPT
-        {
-            BaseTy::operator=(wistd::move(other));
-            m_callContext = wistd::move(other.m_callContext);
-            m_result = other.m_result;
-            m_failure = wistd::move(other.m_failure);
-            m_stopCountExpected = other.m_stopCountExpected;
-            return *this;
-        }
+    BasicThreadActivity& operator=(BasicThreadActivity&& rhs)
+    {
+        BaseTy::operator=(wistd::move(rhs));
+        return *this;
+    }
 
-        ActivityData(ActivityData const& other) = delete;
-        ActivityData& operator=(ActivityData const& other) = delete;
+    /*
+    Returns a handle to the TraceLogging provider associated with this activity.
+    */
+    WI_NODISCARD TraceLoggingHProvider Provider() const
+    {
+        return TraceLoggingType::Provider();
+    }
+};
 
-        // returns true if the event was reported to telemetry
-        void NotifyFailure(FailureInfo const& failure) WI_NOEXCEPT
-        {
-            if ((failure.hr != m_failure.GetFailureInfo().hr) && // don't replace with the same error (likely propagation up the stack)
-                ((failure.hr != m_result) ||
-                 SUCCEEDED(m_result))) // don't replace if we've already got the current explicitly supplied failure code
-            {
-                m_failure.SetFailureInfo(failure);
-            }
-        }
+/// @cond
+#define __WI_TraceLoggingWriteTagged(activity, name, ...) \
+    __pragma(warning(push)) __pragma(warning(disable : 4127)) do \
+    { \
+        _tlgActivityDecl(activity) \
+            TraceLoggingWriteActivity(TraceLoggingType::Provider(), (name), _tlgActivityRef(activity).Id(), NULL, ##__VA_ARGS__); \
+    } \
+    while (0) \
+    __pragma(warning(pop)) /// @endcond
 
-        rwlock_release_exclusive_scope_exit LockExclusive() WI_NOEXCEPT
-        {
-            return m_lock.lock_exclusive();
-        }
+// This is the ultimate base class implementation for all activities.  Activity classes are defined with
+// DEFINE_TRACELOGGING_ACTIVITY, DEFINE_CALLCONTEXT_ACTIVITY, DEFINE_TELEMETRY_ACTIVITY and others
 
-        static TraceLoggingHProvider Provider()
-        {
-            return ActivityTraceLoggingTypeOther::Provider();
-        }
+template <typename ActivityTraceLoggingType, ActivityOptions options = ActivityOptions::None, UINT64 keyword = 0, UINT8 level = WINEVENT_LEVEL_VERBOSE, UINT64 privacyTag = 0, typename TlgReflectorTag = _TlgReflectorTag_Param0IsProviderType>
+class ActivityBase : public details::IFailureCallback
+{
+public:
+    typedef ActivityTraceLoggingType TraceLoggingType;
 
-        WI_NODISCARD bool NeedsStopped() const WI_NOEXCEPT
-        {
-            return BaseTy::IsStarted();
-        }
+    static UINT64 const Keyword = keyword;
+    static UINT8 const Level = level;
+    static UINT64 const PrivacyTag = privacyTag;
+    static bool const AggregatesDuration = (WI_EnumValue(options) & WI_EnumValue(ActivityOptions::AggregateDuration)) != 0;
 
-        void SetRelatedActivityId(const GUID* relatedId)
-        {
-            this->SetRelatedId(*relatedId);
-        }
+    ActivityBase(PCSTR contextName, bool shouldWatchErrors = false) WI_NOEXCEPT
+        : m_activityData(contextName),
+          m_pActivityData(&m_activityData),
+          m_callbackHolder(
+              this, m_activityData.GetCallContext(), shouldWatchErrors, &details::StoredCallContextInfo::PrepareForFailure)
+    {
+    }
 
-        bool SetStopResult(HRESULT hr, _Out_opt_ HRESULT* phr) WI_NOEXCEPT
+    ActivityBase(ActivityBase&& other, bool shouldWatchErrors) WI_NOEXCEPT
+        : m_activityData(wistd::move(other.m_activityData)),
+          m_sharedActivityData(wistd::move(other.m_sharedActivityData)),
+          m_callbackHolder(this, nullptr, shouldWatchErrors)
+    {
+        m_pActivityData = m_sharedActivityData ? m_sharedActivityData.get() : &m_activityData;
+        m_callbackHolder.SetCallContext(m_pActivityData->GetCallContext(), &details::StoredCallContextInfo::PrepareForFailure);
+        other.m_pActivityData = &other.m_activityData;
+        if (other.m_callbackHolder.IsWatching())
         {
-            // We must be expecting at least one Stop -- otherwise the caller is calling Stop() more times
-            // than it can (normally once, or +1 for each call to Split())
-            __FAIL_FAST_IMMEDIATE_ASSERT__(m_stopCountExpected >= 1);
-            if (SUCCEEDED(m_result))
-            {
-                m_result = hr;
-            }
-            if (phr != nullptr)
-            {
-                *phr = m_result;
-            }
-            return ((--m_stopCountExpected) == 0);
+            other.m_callbackHolder.StopWatching();
         }
+    }
 
-        HRESULT SetUnhandledException() WI_NOEXCEPT
-        {
-            HRESULT hr = m_failure.GetFailureInfo().hr;
-            SetStopResult(FAILED(hr) ? hr : HRESULT_FROM_WIN32(ERROR_UNHANDLED_EXCEPTION), &hr);
-            return hr;
-        }
+    ActivityBase(ActivityBase&& other) WI_NOEXCEPT : ActivityBase(wistd::move(other), other.m_callbackHolder.IsWatching())
+    {
+    }
 
-        void IncrementExpectedStopCount() WI_NOEXCEPT
+    ActivityBase(ActivityBase const& other) WI_NOEXCEPT
+        : m_activityData(),
+          m_pActivityData(&m_activityData),
+          m_callbackHolder(this, nullptr, false) // false = do not automatically watch for failures
+    {
+        operator=(other);
+    }
+
+    ActivityBase& operator=(ActivityBase&& other) WI_NOEXCEPT
+    {
+        m_activityData = wistd::move(other.m_activityData);
+        m_sharedActivityData = wistd::move(other.m_sharedActivityData);
+        m_pActivityData = m_sharedActivityData ? m_sharedActivityData.get() : &m_activityData;
+        m_callbackHolder.SetCallContext(m_pActivityData->GetCallContext(), &details::StoredCallContextInfo::PrepareForFailure);
+        m_callbackHolder.SetWatching(other.m_callbackHolder.IsWatching());
+        other.m_pActivityData = &other.m_activityData;
+        if (other.m_callbackHolder.IsWatching())
         {
-            m_stopCountExpected++;
+            other.m_callbackHolder.StopWatching();
         }
+        return *this;
+    }
 
-        WI_NODISCARD FailureInfo const* GetFailureInfo() const WI_NOEXCEPT
+    ActivityBase& operator=(ActivityBase const& other) WI_NOEXCEPT
+    {
+        if (m_callbackHolder.IsWatching())
         {
-            return (FAILED(m_result) && (m_result == m_failure.GetFailureInfo().hr)) ? &m_failure.GetFailureInfo() : nullptr;
+            m_callbackHolder.StopWatching();
         }
 
-        WI_NODISCARD inline HRESULT GetResult() const WI_NOEXCEPT
+        if (other.m_sharedActivityData)
         {
-            return m_result;
+            m_pActivityData = other.m_pActivityData;
+            m_sharedActivityData = other.m_sharedActivityData;
         }
-
-        details::StoredCallContextInfo* GetCallContext() WI_NOEXCEPT
+        else if (m_sharedActivityData.create(wistd::move(other.m_activityData)))
         {
-            return &m_callContext;
+            // Locking should not be required as the first copy should always take place on the owning
+            // thread...
+            m_pActivityData = m_sharedActivityData.get();
+            other.m_sharedActivityData = m_sharedActivityData;
+            other.m_pActivityData = m_pActivityData;
+            other.m_callbackHolder.SetCallContext(
+                m_pActivityData->GetCallContext(), &details::StoredCallContextInfo::PrepareForFailure);
         }
+        m_callbackHolder.SetCallContext(m_pActivityData->GetCallContext(), &details::StoredCallContextInfo::PrepareForFailure);
+        return *this;
+    }
 
-    private:
-        details::StoredCallContextInfo m_callContext;
-        HRESULT m_result;
-        StoredFailureInfo m_failure;
-        int m_stopCountExpected;
-        wil::srwlock m_lock;
-    };
+    // These calls all result in setting a message to associate with any failures that might occur while
+    // running the activity.  For example, you could associate a filename with a call context activity
+    // so that the file name is only reported if the activity fails with the failure.
 
-    mutable ActivityData<ActivityTraceLoggingType, TlgReflectorTag> m_activityData;
-    mutable ActivityData<ActivityTraceLoggingType, TlgReflectorTag>* m_pActivityData;
-    mutable details::shared_object<ActivityData<ActivityTraceLoggingType, TlgReflectorTag>> m_sharedActivityData;
-    mutable details::ThreadFailureCallbackHolder m_callbackHolder;
-};
+    void SetMessage(_In_ _Printf_format_string_ PCSTR formatString, ...)
+    {
+        va_list argList;
+        va_start(argList, formatString);
+        auto lock = LockExclusive();
+        GetCallContext()->SetMessage(formatString, argList);
+        va_end(argList);
+    }
 
-} // namespace wil
+    void SetMessage(_In_opt_ PCWSTR message)
+    {
+        auto lock = LockExclusive();
+        GetCallContext()->SetMessage(message);
+    }
 
-// Internal MACRO implementation of Activities.
-// Do NOT use these macros directly.
-/// @cond
-#define __WI_TraceLoggingWriteStart(activity, name, ...) \
-    __pragma(warning(push)) __pragma(warning(disable : 4127)) do \
-    { \
-        _tlgActivityDecl(activity); \
-        using _tlg_Activity_t = wistd::remove_reference_t<decltype(activity)>; \
-        static constexpr const UINT64 _tlgActivity_Keyword = _tlg_Activity_t::Keyword; \
-        static constexpr const UINT8 _tlgActivity_Level = _tlg_Activity_t::Level; \
-        static constexpr const UINT64 _tlgActivityPrivacyTag = _tlg_Activity_t::PrivacyTag; \
-        static_assert( \
-            _tlgActivity_Keyword == (_tlgActivity_Keyword _tlg_FOREACH(_tlgKeywordVal, ##__VA_ARGS__)), \
-            "Do not use TraceLoggingKeyword in TraceLoggingWriteStart. Keywords for START events are " \
-            "specified in the activity type, e.g. TraceLoggingActivity<Provider,Keyword,Level>."); \
-        static_assert( \
-            _tlgActivity_Level == (_tlgActivity_Level _tlg_FOREACH(_tlgLevelVal, ##__VA_ARGS__)), \
-            "Do not use TraceLoggingLevel in TraceLoggingWriteStart. The Level for START events is " \
-            "specified in the activity type, e.g. TraceLoggingActivity<Provider,Keyword,Level>."); \
-        _tlgActivityRef(activity).zInternalStart(); \
-        TraceLoggingWriteActivity( \
-            TraceLoggingType::Provider(), \
-            (name), \
-            _tlgActivityRef(activity).Id(), \
-            _tlgActivityRef(activity).zInternalRelatedId(), \
-            TraceLoggingOpcode(1 /* WINEVENT_OPCODE_START */), \
-            TraceLoggingKeyword(_tlgActivity_Keyword), \
-            TraceLoggingLevel(_tlgActivity_Level), \
-            TelemetryPrivacyDataTag(_tlgActivityPrivacyTag), \
-            TraceLoggingDescription("~^" _wiltlg_LSTRINGIZE(activity) L"^~"), \
-            ##__VA_ARGS__); \
-    } \
-    while (0) \
-    __pragma(warning(pop))
+    void SetMessageCopy(_In_opt_ PCWSTR message)
+    {
+        auto lock = LockExclusive();
+        GetCallContext()->SetMessageCopy(message);
+    }
 
-#define __WRITE_ACTIVITY_START(EventId, ...) \
-    __TRACELOGGING_TEST_HOOK_ACTIVITY_START(); \
-    __WI_TraceLoggingWriteStart(*this, #EventId, __ACTIVITY_START_PARAMS(), ##__VA_ARGS__); \
-    EnsureWatchingCurrentThread()
+    // This call stops watching for errors on the thread that the activity was originally
+    // created on.  Use it when moving the activity into a thread-agnostic class or moving
+    // an activity across threads.
 
-#define __WI_TraceLoggingWriteStop(activity, name, ...) \
-    __pragma(warning(push)) __pragma(warning(disable : 4127)) do \
-    { \
-        _tlgActivityDecl(activity); \
-        using _tlg_Activity_t = wistd::remove_reference_t<decltype(activity)>; \
-        static constexpr const UINT64 _tlgActivity_Keyword = _tlg_Activity_t::Keyword; \
-        static constexpr const UINT8 _tlgActivity_Level = _tlg_Activity_t::Level; \
-        static constexpr const UINT64 _tlgActivityPrivacyTag = _tlg_Activity_t::PrivacyTag; \
-        static_assert( \
-            _tlgActivity_Keyword == (_tlgActivity_Keyword _tlg_FOREACH(_tlgKeywordVal, ##__VA_ARGS__)), \
-            "Do not use TraceLoggingKeyword in TraceLoggingWriteStop. Keywords for STOP events are " \
-            "specified in the activity type, e.g. TraceLoggingActivity<Provider,Keyword,Level>."); \
-        static_assert( \
-            _tlgActivity_Level == (_tlgActivity_Level _tlg_FOREACH(_tlgLevelVal, ##__VA_ARGS__)), \
-            "Do not use TraceLoggingLevel in TraceLoggingWriteStop. The Level for STOP events is " \
-            "specified in the activity type, e.g. TraceLoggingActivity<Provider,Keyword,Level>."); \
-        _tlgActivityRef(activity).zInternalStop(); \
-        TraceLoggingWriteActivity( \
-            TraceLoggingType::Provider(), \
-            (name), \
-            _tlgActivityRef(activity).Id(), \
-            NULL, \
-            TraceLoggingOpcode(2 /* WINEVENT_OPCODE_STOP */), \
-            TraceLoggingKeyword(_tlgActivity_Keyword), \
-            TraceLoggingLevel(_tlgActivity_Level), \
-            TelemetryPrivacyDataTag(_tlgActivityPrivacyTag), \
-            TraceLoggingDescription("~^" _wiltlg_LSTRINGIZE(activity) L"^~"), \
-            ##__VA_ARGS__); \
-    } \
-    while (0) \
-    __pragma(warning(pop))
+    void IgnoreCurrentThread() WI_NOEXCEPT
+    {
+        if (m_callbackHolder.IsWatching())
+        {
+            m_callbackHolder.StopWatching();
+        }
+    }
 
-#define __WRITE_ACTIVITY_STOP(EventId, ...) \
-    wil::FailureInfo const* pFailure = GetFailureInfo(); \
-    if (pFailure != nullptr) \
-    { \
-        __TRACELOGGING_TEST_HOOK_ACTIVITY_STOP(pFailure, pFailure->hr); \
-        auto& failure = *pFailure; \
-        if (false, WI_IsAnyFlagSet(Keyword, (MICROSOFT_KEYWORD_TELEMETRY | MICROSOFT_KEYWORD_MEASURES | MICROSOFT_KEYWORD_CRITICAL_DATA))) \
-        { \
-            __WI_TraceLoggingWriteStop(*this, #EventId, __ACTIVITY_STOP_TELEMETRY_FAILURE_PARAMS(failure), ##__VA_ARGS__); \
-        } \
-        else \
-        { \
-            __WI_TraceLoggingWriteStop(*this, #EventId, __ACTIVITY_STOP_TRACELOGGING_FAILURE_PARAMS(failure), ##__VA_ARGS__); \
-        } \
-    } \
-    else \
-    { \
-        __TRACELOGGING_TEST_HOOK_ACTIVITY_STOP(nullptr, GetResult()); \
-        __WI_TraceLoggingWriteStop(*this, #EventId, __ACTIVITY_STOP_PARAMS(GetResult()), ##__VA_ARGS__); \
-    } \
-    IgnoreCurrentThread();
+    // Call this API to retrieve an RAII object to watch events on the current thread.  The returned
+    // object should only be used on the stack.
 
-// optional params are:  KeyWord, Level, PrivacyTags, Options
-#define __BEGIN_TRACELOGGING_ACTIVITY_CLASS(ActivityClassName, ...) \
-    class ActivityClassName final : public wil::ActivityBase<TraceLoggingType, ##__VA_ARGS__> \
-    { \
-    protected: \
-        void StopActivity() WI_NOEXCEPT override \
-        { \
-            __WRITE_ACTIVITY_STOP(ActivityClassName); \
-        } \
-        bool WasAlreadyReportedToTelemetry(long failureId) WI_NOEXCEPT override \
-        { \
-            return TraceLoggingType::WasAlreadyReportedToTelemetry(failureId); \
-        } \
-\
-    public: \
-        static bool IsEnabled() WI_NOEXCEPT \
-        { \
-            return TraceLoggingType::IsEnabled(); \
-        } \
-        ~ActivityClassName() WI_NOEXCEPT \
-        { \
-            ActivityBase::Destroy(); \
-        } \
-        ActivityClassName(ActivityClassName const& other) WI_NOEXCEPT : ActivityBase(other) \
-        { \
-        } \
-        ActivityClassName(ActivityClassName&& other) WI_NOEXCEPT : ActivityBase(wistd::move(other)) \
-        { \
-        } \
-        ActivityClassName(ActivityClassName&& other, bool shouldWatchErrors) WI_NOEXCEPT \
-            : ActivityBase(wistd::move(other), shouldWatchErrors) \
-        { \
-        } \
-        ActivityClassName& operator=(ActivityClassName const& other) WI_NOEXCEPT \
-        { \
-            ActivityBase::operator=(other); \
-            return *this; \
-        } \
-        ActivityClassName& operator=(ActivityClassName&& other) WI_NOEXCEPT \
-        { \
-            auto localActivity(wistd::move(*this)); \
-            ActivityBase::operator=(wistd::move(other)); \
-            return *this; \
-        } \
-        WI_NODISCARD explicit operator bool() const WI_NOEXCEPT \
-        { \
-            return IsRunning(); \
-        } \
-        void StopWithResult(HRESULT hr) \
-        { \
-            ActivityBase::Stop(hr); \
-        } \
-        template <typename... TArgs> \
-        void StopWithResult(HRESULT hr, TArgs&&... args) \
-        { \
-            SetStopResult(hr); \
-            Stop(wistd::forward<TArgs>(args)...); \
-        } \
-        void Stop(HRESULT hr = S_OK) WI_NOEXCEPT \
-        { \
-            ActivityBase::Stop(hr); \
-        } \
-        void StartActivity() WI_NOEXCEPT \
-        { \
-            __WRITE_ACTIVITY_START(ActivityClassName); \
-        } \
-        void StartRelatedActivity() WI_NOEXCEPT \
-        { \
-            wil::details::SetRelatedActivityId(*this); \
-            StartActivity(); \
-        } \
-        void StartActivityWithCorrelationVector(PCSTR correlationVector) WI_NOEXCEPT \
-        { \
-            __WRITE_ACTIVITY_START(ActivityClassName, TraceLoggingString(correlationVector, "__TlgCV__")); \
-        } \
-        WI_NODISCARD ActivityClassName Split() WI_NOEXCEPT \
-        { \
-            __FAIL_FAST_IMMEDIATE_ASSERT__(IsRunning()); \
-            IncrementExpectedStopCount(); \
-            return ActivityClassName(*this); \
-        } \
-        WI_NODISCARD ActivityClassName TransferToCurrentThread() WI_NOEXCEPT \
-        { \
-            return ActivityClassName(wistd::move(*this), IsRunning()); \
-        } \
-        WI_NODISCARD ActivityClassName TransferToMember() WI_NOEXCEPT \
-        { \
-            return ActivityClassName(wistd::move(*this), false); \
+    WI_NODISCARD ActivityThreadWatcher ContinueOnCurrentThread() WI_NOEXCEPT
+    {
+        if (IsRunning())
+        {
+            return ActivityThreadWatcher(this, *m_pActivityData->GetCallContext());
         }
+        return ActivityThreadWatcher();
+    }
 
-#define __IMPLEMENT_ACTIVITY_CLASS(ActivityClassName) \
-private: \
-    template <typename... TArgs> \
-    ActivityClassName(wil::details::tag_start, TArgs&&... args) WI_NOEXCEPT : ActivityBase(#ActivityClassName) \
-    { \
-        StartActivity(wistd::forward<TArgs>(args)...); \
-        __TRACELOGGING_DEFINE_PROVIDER_STORAGE_LINK("this", ActivityClassName); \
-    } \
-    template <typename... TArgs> \
-    ActivityClassName(wil::details::tag_start_cv, _In_opt_ PCSTR correlationVector, TArgs&&... args) WI_NOEXCEPT \
-        : ActivityBase(#ActivityClassName) \
-    { \
-        StartActivityWithCorrelationVector(correlationVector, wistd::forward<TArgs>(args)...); \
-        __TRACELOGGING_DEFINE_PROVIDER_STORAGE_LINK("this", ActivityClassName); \
-    } \
-\
-public: \
-    ActivityClassName() WI_NOEXCEPT : ActivityBase(#ActivityClassName, false) \
-    { \
-    } \
-    template <typename... TArgs> \
-    WI_NODISCARD static ActivityClassName Start(TArgs&&... args) \
-    { \
-        return ActivityClassName(wil::details::tag_start(), wistd::forward<TArgs>(args)...); \
-    } \
-    template <typename... TArgs> \
-    WI_NODISCARD static ActivityClassName StartWithCorrelationVector(_In_ PCSTR correlationVector, TArgs&&... args) \
-    { \
-        return ActivityClassName(wil::details::tag_start_cv(), correlationVector, wistd::forward<TArgs>(args)...); \
-    }
+    // This is the 'default' Stop routine that accepts an HRESULT and completes the activity...
 
-#define __IMPLEMENT_CALLCONTEXT_CLASS(ActivityClassName) \
-protected: \
-    ActivityClassName(_In_opt_ void**, PCSTR contextName, _In_ _Printf_format_string_ PCSTR formatString, _In_opt_ va_list argList) : \
-        ActivityBase(contextName) \
-    { \
-        GetCallContext()->SetMessage(formatString, argList); \
-        StartActivity(); \
-    } \
-    ActivityClassName(_In_opt_ void**, PCSTR contextName) : ActivityBase(contextName) \
-    { \
-        StartActivity(); \
-    } \
-\
-public: \
-    ActivityClassName(PCSTR contextName) : ActivityBase(contextName, false) \
-    { \
-    } \
-    ActivityClassName(PCSTR contextName, _Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT : ActivityClassName(contextName) \
-    { \
-        va_list argList; \
-        va_start(argList, formatString); \
-        GetCallContext()->SetMessage(formatString, argList); \
-    } \
-    WI_NODISCARD static ActivityClassName Start(PCSTR contextName) WI_NOEXCEPT \
-    { \
-        return ActivityClassName(static_cast<void**>(__nullptr), contextName); \
-    } \
-    WI_NODISCARD static ActivityClassName Start(PCSTR contextName, _Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
-    { \
-        va_list argList; \
-        va_start(argList, formatString); \
-        return ActivityClassName(static_cast<void**>(__nullptr), contextName, formatString, argList); \
+    void Stop(HRESULT hr = S_OK) WI_NOEXCEPT
+    {
+        bool stopActivity;
+        HRESULT hrLocal;
+        {
+            auto lock = LockExclusive();
+            stopActivity = m_pActivityData->SetStopResult(hr, &hrLocal);
+        }
+        if (stopActivity)
+        {
+            ReportStopActivity(hrLocal);
+        }
+        else
+        {
+            __WI_TraceLoggingWriteTagged(
+                *this,
+                "ActivityIntermediateStop",
+                TraceLoggingKeyword(Keyword),
+                TelemetryPrivacyDataTag(PDT_ProductAndServicePerformance),
+                __ACTIVITY_STOP_PARAMS(hr));
+        }
+        IgnoreCurrentThread();
     }
 
-#define __END_TRACELOGGING_ACTIVITY_CLASS() \
-    } \
-    ;
-/// @endcond
+    // IFailureCallback
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT(EventId, ...) \
-    void EventId() \
-    { \
-        __WI_TraceLoggingWriteTagged(*this, #EventId, _GENERIC_PARTB_FIELDS_ENABLED, ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT(EventId, ...) \
-    void EventId() \
-    { \
-        __WI_TraceLoggingWriteTagged(*this, #EventId, ##__VA_ARGS__); \
-    }
+    bool NotifyFailure(FailureInfo const& failure) WI_NOEXCEPT override
+    {
+        // We always report errors to the ETW stream, but we hold-back the telemetry keyword if we've already reported this error
+        // to this particular telemetry provider.
+
+        __TRACELOGGING_TEST_HOOK_ACTIVITY_ERROR(failure);
+
+        if (WI_IsFlagClear(failure.flags, FailureFlags::RequestSuppressTelemetry))
+        {
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-value"
+#endif
+#pragma warning(push)
+#pragma warning(disable : 6319)
+            if (false, WI_IsFlagSet(options, ActivityOptions::TelemetryOnFailure) && !WasAlreadyReportedToTelemetry(failure.failureId))
+            {
+                __WI_TraceLoggingWriteTagged(
+                    *this,
+                    "ActivityError",
+                    TraceLoggingKeyword(Keyword | MICROSOFT_KEYWORD_TELEMETRY),
+                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
+                    __ACTIVITY_ERROR_TELEMETRY_FAILURE_PARAMS(failure));
+            }
+            else if (false, WI_IsFlagSet(options, ActivityOptions::TraceLoggingOnFailure))
+            {
+                __WI_TraceLoggingWriteTagged(
+                    *this,
+                    "ActivityError",
+                    TraceLoggingKeyword(0),
+                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
+                    __ACTIVITY_ERROR_TRACELOGGING_FAILURE_PARAMS(failure));
+            }
+            else
+            {
+                __WI_TraceLoggingWriteTagged(
+                    *this,
+                    "ActivityError",
+                    TraceLoggingKeyword(Keyword),
+                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
+                    __ACTIVITY_ERROR_TRACELOGGING_FAILURE_PARAMS(failure));
+            }
+#pragma warning(pop)
+#ifdef __clang__
+#pragma clang diagnostic pop
 #endif
+        }
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_CV(EventId, ...) \
-    void EventId(PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, #EventId, _GENERIC_PARTB_FIELDS_ENABLED, TraceLoggingString(correlationVector, "__TlgCV__"), ##__VA_ARGS__); \
+        auto lock = LockExclusive();
+        m_pActivityData->NotifyFailure(failure);
+        return true;
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_CV(EventId, ...) \
-    void EventId(PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged(*this, #EventId, TraceLoggingString(correlationVector, "__TlgCV__"), ##__VA_ARGS__); \
+
+    // This is the base TraceLoggingActivity<> contract...  we implement it so that this class
+    // can be used by all of the activity macros and we re-route the request as needed.
+    //
+    // The contract required by the TraceLogging Activity macros is:
+    // - activity.Keyword    // compile-time constant
+    // - activity.Level      // compile-time constant
+    // - activity.PrivacyTag // compile-time constant
+    // - activity.Provider()
+    // - activity.Id()
+    // - activity.zInternalRelatedId()
+    // - activity.zInternalStart()
+    // - activity.zInternalStop()
+    // In addition, for TlgReflector to work correctly, it must be possible for
+    // TlgReflector to statically map from typeof(activity) to hProvider.
+
+    WI_NODISCARD GUID const* zInternalRelatedId() const WI_NOEXCEPT
+    {
+        return m_pActivityData->zInternalRelatedId();
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, ...) \
-    template <typename T1> \
-    void EventId(T1&& varName1) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
+    void zInternalStart() WI_NOEXCEPT
+    {
+        auto lock = LockExclusive();
+        m_pActivityData->zInternalStart();
+        CaptureStartTime(wistd::integral_constant<bool, AggregatesDuration>());
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, ...) \
-    template <typename T1> \
-    void EventId(T1&& varName1) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, #EventId, TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), ##__VA_ARGS__); \
+
+    void zInternalStop() WI_NOEXCEPT
+    {
+        auto lock = LockExclusive();
+        m_pActivityData->zInternalStop();
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, ...) \
-    template <typename T1> \
-    void EventId(T1&& varName1, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+    static TraceLoggingHProvider Provider() WI_NOEXCEPT
+    {
+        return ActivityTraceLoggingType::Provider();
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, ...) \
-    template <typename T1> \
-    void EventId(T1&& varName1, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+
+    WI_NODISCARD GUID const* Id() const WI_NOEXCEPT
+    {
+        return m_pActivityData->Id();
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, ...) \
-    template <typename T1, typename T2> \
-    void EventId(T1&& varName1, T2&& varName2) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
+    WI_NODISCARD GUID const* providerGuid() const WI_NOEXCEPT
+    {
+        return m_pActivityData->providerGuid();
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, ...) \
-    template <typename T1, typename T2> \
-    void EventId(T1&& varName1, T2&& varName2) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            ##__VA_ARGS__); \
+
+    template <class OtherTy>
+    void SetRelatedActivity(OtherTy const& relatedActivity) WI_NOEXCEPT
+    {
+        auto lock = LockExclusive();
+        m_pActivityData->SetRelatedActivityId(relatedActivity.Id());
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2, ...) \
-    template <typename T1, typename T2> \
-    void EventId(T1&& varName1, T2&& varName2, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2, ...) \
-    template <typename T1, typename T2> \
-    void EventId(T1&& varName1, T2&& varName2, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+    void SetRelatedActivityId(_In_ const GUID& relatedActivityId) WI_NOEXCEPT
+    {
+        auto lock = LockExclusive();
+        m_pActivityData->SetRelatedActivityId(&relatedActivityId);
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
-    template <typename T1, typename T2, typename T3> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
+    void SetRelatedActivityId(_In_ const GUID* relatedActivityId) WI_NOEXCEPT
+    {
+        auto lock = LockExclusive();
+        m_pActivityData->SetRelatedActivityId(relatedActivityId);
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
-    template <typename T1, typename T2, typename T3> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            ##__VA_ARGS__); \
+
+    WI_NODISCARD inline bool IsRunning() const WI_NOEXCEPT
+    {
+        return m_pActivityData->NeedsStopped();
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
-    template <typename T1, typename T2, typename T3> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+protected:
+    virtual void StopActivity() WI_NOEXCEPT = 0;
+    virtual bool WasAlreadyReportedToTelemetry(long failureId) WI_NOEXCEPT = 0;
+
+    void EnsureWatchingCurrentThread()
+    {
+        if (!m_callbackHolder.IsWatching())
+        {
+            m_callbackHolder.StartWatching();
+        }
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
-    template <typename T1, typename T2, typename T3> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+
+    void SetStopResult(HRESULT hr, _Out_opt_ HRESULT* phr = nullptr) WI_NOEXCEPT
+    {
+        auto lock = LockExclusive();
+        m_pActivityData->SetStopResult(hr, phr);
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM4( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
-    template <typename T1, typename T2, typename T3, typename T4> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
+    void IncrementExpectedStopCount() WI_NOEXCEPT
+    {
+        auto lock = LockExclusive();
+        m_pActivityData->IncrementExpectedStopCount();
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM4( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
-    template <typename T1, typename T2, typename T3, typename T4> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            ##__VA_ARGS__); \
+
+    // Records the duration of the activity into the histogram of the given activity class when the activity was
+    // declared with ActivityOptions::AggregateDuration; otherwise does nothing.
+    template <typename TActivity>
+    void RecordActivityDuration(PCSTR activityName) WI_NOEXCEPT
+    {
+        RecordActivityDuration<TActivity>(activityName, wistd::integral_constant<bool, AggregatesDuration>());
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM4_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
-    template <typename T1, typename T2, typename T3, typename T4> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+    // Locking should not be required on these accessors as we only use this at reporting (which will only happen from
+    // the final stop)
+
+    FailureInfo const* GetFailureInfo() WI_NOEXCEPT
+    {
+        return m_pActivityData->GetFailureInfo();
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM4_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
-    template <typename T1, typename T2, typename T3, typename T4> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+
+    WI_NODISCARD inline HRESULT GetResult() const WI_NOEXCEPT
+    {
+        return m_pActivityData->GetResult();
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM5( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
+    WI_NODISCARD details::StoredCallContextInfo* GetCallContext() const WI_NOEXCEPT
+    {
+        return m_pActivityData->GetCallContext();
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM5( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            ##__VA_ARGS__); \
+
+    // Think of this routine as the destructor -- since we need to call virtual derived methods, we can't use it as
+    // a destructor without a pure virtual method call, so we have the derived class call it in its destructor...
+
+    void Destroy() WI_NOEXCEPT
+    {
+        bool fStop = true;
+        if (m_sharedActivityData)
+        {
+            // The lock unifies the 'unique()' check and the 'reset()' of any non-unique activity so that we
+            // can positively identify the final release of the internal data
+
+            auto lock = LockExclusive();
+            if (!m_sharedActivityData.unique())
+            {
+                fStop = false;
+                m_sharedActivityData.reset();
+            }
+        }
+
+        if (fStop && m_pActivityData->NeedsStopped())
+        {
+            ReportStopActivity(m_pActivityData->SetUnhandledException());
+        }
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM5_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+private:
+    void CaptureStartTime(wistd::false_type) WI_NOEXCEPT
+    {
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM5_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
-    }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM6( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM6( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            ##__VA_ARGS__); \
+    void CaptureStartTime(wistd::true_type) WI_NOEXCEPT
+    {
+        LARGE_INTEGER now;
+        ::QueryPerformanceCounter(&now);
+        m_pActivityData->SetStartTicks(now.QuadPart);
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM6_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM6_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+    template <typename TActivity>
+    void RecordActivityDuration(PCSTR, wistd::false_type) WI_NOEXCEPT
+    {
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM7( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM7( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            ##__VA_ARGS__); \
+    template <typename TActivity>
+    void RecordActivityDuration(PCSTR activityName, wistd::true_type) WI_NOEXCEPT
+    {
+        auto const startTicks = m_pActivityData->GetStartTicks();
+        if (startTicks != 0)
+        {
+            LARGE_INTEGER now;
+            ::QueryPerformanceCounter(&now);
+            DurationHistogram<TActivity>(activityName).Record(now.QuadPart - startTicks);
+        }
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM7_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM7_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, PCSTR correlationVector) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+    // One histogram per activity class, registered with the provider on first use
+    template <typename TActivity>
+    static details::activity_duration_histogram& DurationHistogram(PCSTR activityName) WI_NOEXCEPT
+    {
+        static details::activity_duration_histogram s_histogram(
+            activityName,
+            &details::WriteActivityDurationSummary<keyword, level, privacyTag>,
+            &ActivityTraceLoggingType::RegisterPeriodicEventSource);
+        return s_histogram;
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM8( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
+    void ReportStopActivity(HRESULT hr) WI_NOEXCEPT
+    {
+        if (FAILED(hr) &&
+            WI_AreAllFlagsClear(Keyword, (MICROSOFT_KEYWORD_TELEMETRY | MICROSOFT_KEYWORD_MEASURES | MICROSOFT_KEYWORD_CRITICAL_DATA)) &&
+            WI_IsFlagSet(options, ActivityOptions::TelemetryOnFailure))
+        {
+            wil::FailureInfo const* pFailure = GetFailureInfo();
+            if (pFailure != nullptr)
+            {
+                __TRACELOGGING_TEST_HOOK_CALLCONTEXT_ERROR(pFailure, pFailure->hr);
+                auto& failure = *pFailure;
+                __WI_TraceLoggingWriteTagged(
+                    *this,
+                    "ActivityFailure",
+                    TraceLoggingKeyword(Keyword | MICROSOFT_KEYWORD_TELEMETRY),
+                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
+                    __ACTIVITY_FAILURE_TELEMETRY_FAILURE_PARAMS(failure));
+            }
+            else
+            {
+                __TRACELOGGING_TEST_HOOK_CALLCONTEXT_ERROR(nullptr, hr);
+                m_pActivityData->GetCallContext()->FormatPendingMessage();
+                __WI_TraceLoggingWriteTagged(
+                    *this,
+                    "ActivityFailure",
+                    TraceLoggingKeyword(Keyword | MICROSOFT_KEYWORD_TELEMETRY),
+                    TraceLoggingLevel(WINEVENT_LEVEL_ERROR),
+                    __ACTIVITY_FAILURE_TELEMETRY_PARAMS(
+                        hr, m_pActivityData->GetCallContext()->contextName, m_pActivityData->GetCallContext()->contextMessage));
+            }
+        }
+
+        StopActivity();
     }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM8( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
-    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8) \
-    { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            ##__VA_ARGS__); \
+
+    rwlock_release_exclusive_scope_exit LockExclusive() WI_NOEXCEPT
+    {
+        // We only need to lock when we're sharing....
+        return (m_sharedActivityData ? m_sharedActivityData->LockExclusive() : rwlock_release_exclusive_scope_exit());
     }
-#endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM8_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
-    void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, PCSTR correlationVector) \
+    template <typename ActivityTraceLoggingTypeOther, typename TlgReflectorTagOther = _TlgReflectorTag_Param0IsProviderType>
+    class ActivityData : public _TlgActivityBase<ActivityData<ActivityTraceLoggingTypeOther, TlgReflectorTagOther>, keyword, level>
+    {
+        using BaseTy = _TlgActivityBase<ActivityData<ActivityTraceLoggingTypeOther, TlgReflectorTagOther>, keyword, level>;
+        friend BaseTy;
+        void OnStarted()
+        {
+        }
+        void OnStopped()
+        {
+        }
+
+        // SFINAE dispatching on presence of ActivityTraceLoggingTypeOther::CreateActivityId(_Out_ GUID& childActivityId, _In_opt_ const GUID* relatedActivityId)
+        template <typename ProviderType>
+        auto CreateActivityIdByProviderType(int, _Out_ GUID& childActivityId)
+            -> decltype(ProviderType::CreateActivityId(childActivityId, this->GetRelatedId()), (void)0)
+        {
+            ProviderType::CreateActivityId(childActivityId, this->GetRelatedId());
+        }
+
+        template <typename ProviderType>
+        auto CreateActivityIdByProviderType(long, _Out_ GUID& childActivityId) -> void
+        {
+            if (false, WI_IsFlagSet(options, ActivityOptions::FastActivityId))
+            {
+                details::CreateFastActivityId(childActivityId);
+            }
+            else
+            {
+                EventActivityIdControl(EVENT_ACTIVITY_CTRL_CREATE_ID, &childActivityId);
+            }
+        }
+
+        void CreateActivityId(_Out_ GUID& childActivityId)
+        {
+            CreateActivityIdByProviderType<ActivityTraceLoggingTypeOther>(0, childActivityId);
+        }
+
+    public:
+        ActivityData(_In_opt_ PCSTR contextName = nullptr) WI_NOEXCEPT : BaseTy(),
+                                                                         m_callContext(contextName),
+                                                                         m_result(S_OK),
+                                                                         m_stopCountExpected(1)
+        {
+        }
+
+        ActivityData(ActivityData&& other) WI_NOEXCEPT : BaseTy(wistd::move(other)),
+                                                         m_callContext(wistd::move(other.m_callContext)),
+                                                         m_result(other.m_result),
+                                                         m_failure(wistd::move(other.m_failure)),
+                                                         m_stopCountExpected(other.m_stopCountExpected),
+                                                         m_startTicks(other.m_startTicks)
+        {
+        }
+
+        ActivityData& operator=(ActivityData&& other) WI_NOEXCEPT
+        {
+            BaseTy::operator=(wistd::move(other));
+            m_callContext = wistd::move(other.m_callContext);
+            m_result = other.m_result;
+            m_failure = wistd::move(other.m_failure);
+            m_stopCountExpected = other.m_stopCountExpected;
+            m_startTicks = other.m_startTicks;
+            return *this;
+        }
+
+        ActivityData(ActivityData const& other) = delete;
+        ActivityData& operator=(ActivityData const& other) = delete;
+
+        // returns true if the event was reported to telemetry
+        void NotifyFailure(FailureInfo const& failure) WI_NOEXCEPT
+        {
+            if ((failure.hr != m_failure.GetFailureInfo().hr) && // don't replace with the same error (likely propagation up the stack)
+                ((failure.hr != m_result) ||
+                 SUCCEEDED(m_result))) // don't replace if we've already got the current explicitly supplied failure code
+            {
+                m_failure.SetFailureInfo(failure);
+            }
+        }
+
+        rwlock_release_exclusive_scope_exit LockExclusive() WI_NOEXCEPT
+        {
+            return m_lock.lock_exclusive();
+        }
+
+        static TraceLoggingHProvider Provider()
+        {
+            return ActivityTraceLoggingTypeOther::Provider();
+        }
+
+        WI_NODISCARD bool NeedsStopped() const WI_NOEXCEPT
+        {
+            return BaseTy::IsStarted();
+        }
+
+        void SetRelatedActivityId(const GUID* relatedId)
+        {
+            this->SetRelatedId(*relatedId);
+        }
+
+        bool SetStopResult(HRESULT hr, _Out_opt_ HRESULT* phr) WI_NOEXCEPT
+        {
+            // We must be expecting at least one Stop -- otherwise the caller is calling Stop() more times
+            // than it can (normally once, or +1 for each call to Split())
+            __FAIL_FAST_IMMEDIATE_ASSERT__(m_stopCountExpected >= 1);
+            if (SUCCEEDED(m_result))
+            {
+                m_result = hr;
+            }
+            if (phr != nullptr)
+            {
+                *phr = m_result;
+            }
+            return ((--m_stopCountExpected) == 0);
+        }
+
+        HRESULT SetUnhandledException() WI_NOEXCEPT
+        {
+            HRESULT hr = m_failure.GetFailureInfo().hr;
+            SetStopResult(FAILED(hr) ? hr : HRESULT_FROM_WIN32(ERROR_UNHANDLED_EXCEPTION), &hr);
+            return hr;
+        }
+
+        void IncrementExpectedStopCount() WI_NOEXCEPT
+        {
+            m_stopCountExpected++;
+        }
+
+        WI_NODISCARD FailureInfo const* GetFailureInfo() const WI_NOEXCEPT
+        {
+            return (FAILED(m_result) && (m_result == m_failure.GetFailureInfo().hr)) ? &m_failure.GetFailureInfo() : nullptr;
+        }
+
+        WI_NODISCARD inline HRESULT GetResult() const WI_NOEXCEPT
+        {
+            return m_result;
+        }
+
+        details::StoredCallContextInfo* GetCallContext() WI_NOEXCEPT
+        {
+            return &m_callContext;
+        }
+
+        void SetStartTicks(LONGLONG startTicks) WI_NOEXCEPT
+        {
+            m_startTicks = startTicks;
+        }
+
+        WI_NODISCARD LONGLONG GetStartTicks() const WI_NOEXCEPT
+        {
+            return m_startTicks;
+        }
+
+    private:
+        details::StoredCallContextInfo m_callContext;
+        HRESULT m_result;
+        StoredFailureInfo m_failure;
+        int m_stopCountExpected;
+        LONGLONG m_startTicks{};
+        wil::srwlock m_lock;
+    };
+
+    mutable ActivityData<ActivityTraceLoggingType, TlgReflectorTag> m_activityData;
+    mutable ActivityData<ActivityTraceLoggingType, TlgReflectorTag>* m_pActivityData;
+    mutable details::shared_object<ActivityData<ActivityTraceLoggingType, TlgReflectorTag>> m_sharedActivityData;
+    mutable details::ThreadFailureCallbackHolder m_callbackHolder;
+};
+
+} // namespace wil
+
+#ifdef WIL_TRACELOGGING_MEMORY_SINK
+/// @cond
+inline ULONG __stdcall wil_details_MemorySinkEventWriteTransfer(
+    REGHANDLE,
+    PCEVENT_DESCRIPTOR eventDescriptor,
+    LPCGUID activityId,
+    LPCGUID,
+    ULONG dataCount,
+    PEVENT_DATA_DESCRIPTOR data) WI_NOEXCEPT
+{
+    wil::trace_memory_sink::instance().Record(eventDescriptor, activityId, dataCount, data);
+    return ERROR_SUCCESS;
+}
+/// @endcond
+#endif
+
+// Internal MACRO implementation of Activities.
+// Do NOT use these macros directly.
+/// @cond
+#define __WI_TraceLoggingWriteStart(activity, name, ...) \
+    __pragma(warning(push)) __pragma(warning(disable : 4127)) do \
     { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
+        _tlgActivityDecl(activity); \
+        using _tlg_Activity_t = wistd::remove_reference_t<decltype(activity)>; \
+        static constexpr const UINT64 _tlgActivity_Keyword = _tlg_Activity_t::Keyword; \
+        static constexpr const UINT8 _tlgActivity_Level = _tlg_Activity_t::Level; \
+        static constexpr const UINT64 _tlgActivityPrivacyTag = _tlg_Activity_t::PrivacyTag; \
+        static_assert( \
+            _tlgActivity_Keyword == (_tlgActivity_Keyword _tlg_FOREACH(_tlgKeywordVal, ##__VA_ARGS__)), \
+            "Do not use TraceLoggingKeyword in TraceLoggingWriteStart. Keywords for START events are " \
+            "specified in the activity type, e.g. TraceLoggingActivity<Provider,Keyword,Level>."); \
+        static_assert( \
+            _tlgActivity_Level == (_tlgActivity_Level _tlg_FOREACH(_tlgLevelVal, ##__VA_ARGS__)), \
+            "Do not use TraceLoggingLevel in TraceLoggingWriteStart. The Level for START events is " \
+            "specified in the activity type, e.g. TraceLoggingActivity<Provider,Keyword,Level>."); \
+        _tlgActivityRef(activity).zInternalStart(); \
+        TraceLoggingWriteActivity( \
+            TraceLoggingType::Provider(), \
+            (name), \
+            _tlgActivityRef(activity).Id(), \
+            _tlgActivityRef(activity).zInternalRelatedId(), \
+            TraceLoggingOpcode(1 /* WINEVENT_OPCODE_START */), \
+            TraceLoggingKeyword(_tlgActivity_Keyword), \
+            TraceLoggingLevel(_tlgActivity_Level), \
+            TelemetryPrivacyDataTag(_tlgActivityPrivacyTag), \
+            TraceLoggingDescription("~^" _wiltlg_LSTRINGIZE(activity) L"^~"), \
             ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM8_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
-    void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, PCSTR correlationVector) \
+    } \
+    while (0) \
+    __pragma(warning(pop))
+
+#define __WRITE_ACTIVITY_START(EventId, ...) \
+    __TRACELOGGING_TEST_HOOK_ACTIVITY_START(); \
+    if (false, AggregatesDuration) \
     { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
-    }
-#endif
+        zInternalStart(); \
+    } \
+    else \
+    { \
+        __WI_TraceLoggingWriteStart(*this, #EventId, __ACTIVITY_START_PARAMS(), ##__VA_ARGS__); \
+    } \
+    EnsureWatchingCurrentThread()
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM9( \
-    EventId, \
-    VarType1, \
-    varName1, \
-    VarType2, \
-    varName2, \
-    VarType3, \
-    varName3, \
-    VarType4, \
-    varName4, \
-    VarType5, \
-    varName5, \
-    VarType6, \
-    varName6, \
-    VarType7, \
-    varName7, \
-    VarType8, \
-    varName8, \
-    VarType9, \
-    varName9, \
-    ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9> \
-    void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9) \
+#define __WI_TraceLoggingWriteStop(activity, name, ...) \
+    __pragma(warning(push)) __pragma(warning(disable : 4127)) do \
     { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
+        _tlgActivityDecl(activity); \
+        using _tlg_Activity_t = wistd::remove_reference_t<decltype(activity)>; \
+        static constexpr const UINT64 _tlgActivity_Keyword = _tlg_Activity_t::Keyword; \
+        static constexpr const UINT8 _tlgActivity_Level = _tlg_Activity_t::Level; \
+        static constexpr const UINT64 _tlgActivityPrivacyTag = _tlg_Activity_t::PrivacyTag; \
+        static_assert( \
+            _tlgActivity_Keyword == (_tlgActivity_Keyword _tlg_FOREACH(_tlgKeywordVal, ##__VA_ARGS__)), \
+            "Do not use TraceLoggingKeyword in TraceLoggingWriteStop. Keywords for STOP events are " \
+            "specified in the activity type, e.g. TraceLoggingActivity<Provider,Keyword,Level>."); \
+        static_assert( \
+            _tlgActivity_Level == (_tlgActivity_Level _tlg_FOREACH(_tlgLevelVal, ##__VA_ARGS__)), \
+            "Do not use TraceLoggingLevel in TraceLoggingWriteStop. The Level for STOP events is " \
+            "specified in the activity type, e.g. TraceLoggingActivity<Provider,Keyword,Level>."); \
+        _tlgActivityRef(activity).zInternalStop(); \
+        TraceLoggingWriteActivity( \
+            TraceLoggingType::Provider(), \
+            (name), \
+            _tlgActivityRef(activity).Id(), \
+            NULL, \
+            TraceLoggingOpcode(2 /* WINEVENT_OPCODE_STOP */), \
+            TraceLoggingKeyword(_tlgActivity_Keyword), \
+            TraceLoggingLevel(_tlgActivity_Level), \
+            TelemetryPrivacyDataTag(_tlgActivityPrivacyTag), \
+            TraceLoggingDescription("~^" _wiltlg_LSTRINGIZE(activity) L"^~"), \
             ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM9( \
-    EventId, \
-    VarType1, \
-    varName1, \
-    VarType2, \
-    varName2, \
-    VarType3, \
-    varName3, \
-    VarType4, \
-    varName4, \
-    VarType5, \
-    varName5, \
-    VarType6, \
-    varName6, \
-    VarType7, \
-    varName7, \
-    VarType8, \
-    varName8, \
-    VarType9, \
-    varName9, \
-    ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9> \
-    void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9) \
+    } \
+    while (0) \
+    __pragma(warning(pop))
+
+#define __WRITE_ACTIVITY_STOP(EventId, ...) \
+    RecordActivityDuration<wistd::remove_reference_t<decltype(*this)>>(#EventId); \
+    wil::FailureInfo const* pFailure = GetFailureInfo(); \
+    if (pFailure != nullptr) \
     { \
-        __WI_TraceLoggingWriteTagged( \
-            *this, \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
-            ##__VA_ARGS__); \
-    }
-#endif
+        __TRACELOGGING_TEST_HOOK_ACTIVITY_STOP(pFailure, pFailure->hr); \
+        auto& failure = *pFailure; \
+        if (false, WI_IsAnyFlagSet(Keyword, (MICROSOFT_KEYWORD_TELEMETRY | MICROSOFT_KEYWORD_MEASURES | MICROSOFT_KEYWORD_CRITICAL_DATA))) \
+        { \
+            __WI_TraceLoggingWriteStop(*this, #EventId, __ACTIVITY_STOP_TELEMETRY_FAILURE_PARAMS(failure), ##__VA_ARGS__); \
+        } \
+        else \
+        { \
+            __WI_TraceLoggingWriteStop(*this, #EventId, __ACTIVITY_STOP_TRACELOGGING_FAILURE_PARAMS(failure), ##__VA_ARGS__); \
+        } \
+    } \
+    else \
+    { \
+        __TRACELOGGING_TEST_HOOK_ACTIVITY_STOP(nullptr, GetResult()); \
+        if (AggregatesDuration && SUCCEEDED(GetResult())) \
+        { \
+            zInternalStop(); \
+        } \
+        else \
+        { \
+            __WI_TraceLoggingWriteStop(*this, #EventId, __ACTIVITY_STOP_PARAMS(GetResult()), ##__VA_ARGS__); \
+        } \
+    } \
+    IgnoreCurrentThread();
 
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_UINT32(EventId, varName, ...) \
-    DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, UINT32, varName, ##__VA_ARGS__)
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_BOOL(EventId, varName, ...) \
-    DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, bool, varName, ##__VA_ARGS__)
-#define DEFINE_TAGGED_TRACELOGGING_EVENT_STRING(EventId, varName, ...) \
-    DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, PCWSTR, varName, ##__VA_ARGS__)
+// optional params are:  KeyWord, Level, PrivacyTags, Options
+#define __BEGIN_TRACELOGGING_ACTIVITY_CLASS(ActivityClassName, ...) \
+    class ActivityClassName final : public wil::ActivityBase<TraceLoggingType, ##__VA_ARGS__> \
+    { \
+    protected: \
+        void StopActivity() WI_NOEXCEPT override \
+        { \
+            __WRITE_ACTIVITY_STOP(ActivityClassName); \
+        } \
+        bool WasAlreadyReportedToTelemetry(long failureId) WI_NOEXCEPT override \
+        { \
+            return TraceLoggingType::WasAlreadyReportedToTelemetry(failureId); \
+        } \
+\
+    public: \
+        static bool IsEnabled() WI_NOEXCEPT \
+        { \
+            return TraceLoggingType::IsEnabled(); \
+        } \
+        ~ActivityClassName() WI_NOEXCEPT \
+        { \
+            ActivityBase::Destroy(); \
+        } \
+        ActivityClassName(ActivityClassName const& other) WI_NOEXCEPT : ActivityBase(other) \
+        { \
+        } \
+        ActivityClassName(ActivityClassName&& other) WI_NOEXCEPT : ActivityBase(wistd::move(other)) \
+        { \
+        } \
+        ActivityClassName(ActivityClassName&& other, bool shouldWatchErrors) WI_NOEXCEPT \
+            : ActivityBase(wistd::move(other), shouldWatchErrors) \
+        { \
+        } \
+        ActivityClassName& operator=(ActivityClassName const& other) WI_NOEXCEPT \
+        { \
+            ActivityBase::operator=(other); \
+            return *this; \
+        } \
+        ActivityClassName& operator=(ActivityClassName&& other) WI_NOEXCEPT \
+        { \
+            auto localActivity(wistd::move(*this)); \
+            ActivityBase::operator=(wistd::move(other)); \
+            return *this; \
+        } \
+        WI_NODISCARD explicit operator bool() const WI_NOEXCEPT \
+        { \
+            return IsRunning(); \
+        } \
+        void StopWithResult(HRESULT hr) \
+        { \
+            ActivityBase::Stop(hr); \
+        } \
+        template <typename... TArgs> \
+        void StopWithResult(HRESULT hr, TArgs&&... args) \
+        { \
+            SetStopResult(hr); \
+            Stop(wistd::forward<TArgs>(args)...); \
+        } \
+        void Stop(HRESULT hr = S_OK) WI_NOEXCEPT \
+        { \
+            ActivityBase::Stop(hr); \
+        } \
+        void StartActivity() WI_NOEXCEPT \
+        { \
+            __WRITE_ACTIVITY_START(ActivityClassName); \
+        } \
+        void StartRelatedActivity() WI_NOEXCEPT \
+        { \
+            wil::details::SetRelatedActivityId(*this); \
+            StartActivity(); \
+        } \
+        void StartActivityWithCorrelationVector(PCSTR correlationVector) WI_NOEXCEPT \
+        { \
+            __WRITE_ACTIVITY_START(ActivityClassName, TraceLoggingString(correlationVector, "__TlgCV__")); \
+        } \
+        WI_NODISCARD ActivityClassName Split() WI_NOEXCEPT \
+        { \
+            __FAIL_FAST_IMMEDIATE_ASSERT__(IsRunning()); \
+            IncrementExpectedStopCount(); \
+            return ActivityClassName(*this); \
+        } \
+        WI_NODISCARD ActivityClassName TransferToCurrentThread() WI_NOEXCEPT \
+        { \
+            return ActivityClassName(wistd::move(*this), IsRunning()); \
+        } \
+        WI_NODISCARD ActivityClassName TransferToMember() WI_NOEXCEPT \
+        { \
+            return ActivityClassName(wistd::move(*this), false); \
+        }
 
-// Internal MACRO implementation of TraceLogging classes.
-// Do NOT use these macros directly.
-/// @cond
-#define __IMPLEMENT_TRACELOGGING_CLASS_BASE(TraceLoggingClassName, TraceLoggingProviderOwnerClassName) \
-public: \
-    typedef TraceLoggingProviderOwnerClassName TraceLoggingType; \
-    static bool IsEnabled( \
-        UCHAR eventLevel = 0 /* WINEVENT_LEVEL_XXX, e.g. WINEVENT_LEVEL_VERBOSE */, \
-        ULONGLONG eventKeywords = 0 /* MICROSOFT_KEYWORD_XXX */) WI_NOEXCEPT \
+#define __IMPLEMENT_ACTIVITY_CLASS(ActivityClassName) \
+private: \
+    template <typename... TArgs> \
+    ActivityClassName(wil::details::tag_start, TArgs&&... args) WI_NOEXCEPT : ActivityBase(#ActivityClassName) \
     { \
-        return Instance()->IsEnabled_(eventLevel, eventKeywords); \
+        StartActivity(wistd::forward<TArgs>(args)...); \
+        __TRACELOGGING_DEFINE_PROVIDER_STORAGE_LINK("this", ActivityClassName); \
     } \
-    static TraceLoggingHProvider Provider() WI_NOEXCEPT \
+    template <typename... TArgs> \
+    ActivityClassName(wil::details::tag_start_cv, _In_opt_ PCSTR correlationVector, TArgs&&... args) WI_NOEXCEPT \
+        : ActivityBase(#ActivityClassName) \
     { \
-        return static_cast<TraceLoggingProvider*>(Instance())->Provider_(); \
+        StartActivityWithCorrelationVector(correlationVector, wistd::forward<TArgs>(args)...); \
+        __TRACELOGGING_DEFINE_PROVIDER_STORAGE_LINK("this", ActivityClassName); \
     } \
-    static void SetTelemetryEnabled(bool) WI_NOEXCEPT \
+\
+public: \
+    ActivityClassName() WI_NOEXCEPT : ActivityBase(#ActivityClassName, false) \
     { \
     } \
-    static void SetErrorReportingType(wil::ErrorReportingType type) WI_NOEXCEPT \
+    template <typename... TArgs> \
+    WI_NODISCARD static ActivityClassName Start(TArgs&&... args) \
     { \
-        return Instance()->SetErrorReportingType_(type); \
+        return ActivityClassName(wil::details::tag_start(), wistd::forward<TArgs>(args)...); \
     } \
-    static void __stdcall FallbackTelemetryCallback(bool alreadyReported, wil::FailureInfo const& failure) WI_NOEXCEPT \
+    template <typename... TArgs> \
+    WI_NODISCARD static ActivityClassName StartWithCorrelationVector(_In_ PCSTR correlationVector, TArgs&&... args) \
     { \
-        return Instance()->OnErrorReported(alreadyReported, failure); \
-    } \
-    WI_NODISCARD static wil::ActivityThreadWatcher WatchCurrentThread(PCSTR contextName) WI_NOEXCEPT \
+        return ActivityClassName(wil::details::tag_start_cv(), correlationVector, wistd::forward<TArgs>(args)...); \
+    }
+
+#define __IMPLEMENT_CALLCONTEXT_CLASS(ActivityClassName) \
+protected: \
+    ActivityClassName(_In_opt_ void**, PCSTR contextName, _In_ _Printf_format_string_ PCSTR formatString, _In_opt_ va_list argList) : \
+        ActivityBase(contextName) \
     { \
-        return wil::ActivityThreadWatcher(Instance(), contextName); \
+        GetCallContext()->SetMessage(formatString, argList); \
+        StartActivity(); \
     } \
-    WI_NODISCARD static wil::ActivityThreadWatcher WatchCurrentThread( \
-        PCSTR contextName, _Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
+    ActivityClassName(_In_opt_ void**, PCSTR contextName) : ActivityBase(contextName) \
     { \
-        va_list argList; \
-        va_start(argList, formatString); \
-        return wil::ActivityThreadWatcher(Instance(), contextName, formatString, argList); \
+        StartActivity(); \
     } \
-    __BEGIN_TRACELOGGING_ACTIVITY_CLASS(CallContext, wil::ActivityOptions::TelemetryOnFailure) \
-    __IMPLEMENT_CALLCONTEXT_CLASS(CallContext); \
-    __END_TRACELOGGING_ACTIVITY_CLASS(); \
-    static CallContext Start(PCSTR contextName) WI_NOEXCEPT \
+\
+public: \
+    ActivityClassName(PCSTR contextName) : ActivityBase(contextName, false) \
     { \
-        return CallContext(contextName, __nullptr, __nullptr); \
     } \
-    static CallContext Start(PCSTR contextName, _Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
+    ActivityClassName(PCSTR contextName, _Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT : ActivityClassName(contextName) \
     { \
         va_list argList; \
         va_start(argList, formatString); \
-        return CallContext(contextName, formatString, argList); \
+        GetCallContext()->SetMessage(formatString, argList); \
     } \
-    static void TraceLoggingInfo(_Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
+    WI_NODISCARD static ActivityClassName Start(PCSTR contextName) WI_NOEXCEPT \
     { \
-        va_list argList; \
-        va_start(argList, formatString); \
-        return Instance()->ReportTraceLoggingMessage(formatString, argList); \
+        return ActivityClassName(static_cast<void**>(__nullptr), contextName); \
     } \
-    static void TraceLoggingError(_Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
+    WI_NODISCARD static ActivityClassName Start(PCSTR contextName, _Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
     { \
         va_list argList; \
         va_start(argList, formatString); \
-        return Instance()->ReportTraceLoggingError(formatString, argList); \
-    } \
-\
-private: \
-    TraceLoggingHProvider Provider_() const WI_NOEXCEPT = delete; \
-    TraceLoggingClassName() WI_NOEXCEPT{}; \
-\
-protected: \
-    static TraceLoggingClassName* Instance() WI_NOEXCEPT \
-    { \
-        static wil::details::static_lazy<TraceLoggingClassName> wrapper; \
-        return wrapper.get([]() { \
-            wrapper.cleanup(); \
-        }); \
-    } \
-    friend class wil::details::static_lazy<TraceLoggingClassName>;
-
-#define __IMPLEMENT_TRACELOGGING_CLASS_WITH_GROUP(TraceLoggingClassName, ProviderName, ProviderId, TraceLoggingOption) \
-    __IMPLEMENT_TRACELOGGING_CLASS_BASE(TraceLoggingClassName, TraceLoggingClassName) \
-private: \
-    struct StaticHandle \
-    { \
-        TraceLoggingHProvider handle; \
-        StaticHandle() WI_NOEXCEPT \
-        { \
-            TRACELOGGING_DEFINE_PROVIDER_STORAGE(__hInner, ProviderName, ProviderId, TraceLoggingOption); \
-            _tlg_DefineProvider_annotation(TraceLoggingClassName, _Tlg##TraceLoggingClassName##Prov, 0, ProviderName); \
-            handle = &__hInner; \
-        } \
-    } m_staticHandle; \
-\
-protected: \
-    void Create() WI_NOEXCEPT \
-    { \
-        Register(m_staticHandle.handle); \
-    } \
-\
-public:
-
-#define __IMPLEMENT_TRACELOGGING_CLASS(TraceLoggingClassName, ProviderName, ProviderId) \
-    __IMPLEMENT_TRACELOGGING_CLASS_WITH_GROUP(TraceLoggingClassName, ProviderName, ProviderId, TraceLoggingOptionMicrosoftTelemetry())
-
-#define __IMPLEMENT_TRACELOGGING_CLASS_WITH_GROUP_CB(TraceLoggingClassName, ProviderName, ProviderId, TraceLoggingOption) \
-    __IMPLEMENT_TRACELOGGING_CLASS_BASE(TraceLoggingClassName, TraceLoggingClassName) \
-private: \
-    struct StaticHandle \
-    { \
-        TraceLoggingHProvider handle; \
-        StaticHandle() WI_NOEXCEPT \
-        { \
-            TRACELOGGING_DEFINE_PROVIDER_STORAGE(__hInner, ProviderName, ProviderId, TraceLoggingOption); \
-            _tlg_DefineProvider_annotation(TraceLoggingClassName, _Tlg##TraceLoggingClassName##Prov, 0, ProviderName); \
-            handle = &__hInner; \
-        } \
-    } m_staticHandle; \
-    static VOID NTAPI Callback( \
-        _In_ const GUID* SourceId, \
-        ULONG ControlCode, \
-        UCHAR Level, \
-        ULONGLONG MatchAnyKeyword, \
-        ULONGLONG MatchAllKeyword, \
-        _In_opt_ EVENT_FILTER_DESCRIPTOR* FilterData, \
-        void* CallbackContext); \
-\
-protected: \
-    void Create() WI_NOEXCEPT \
-    { \
-        Register(m_staticHandle.handle, &TraceLoggingClassName::Callback); \
-    } \
-\
-public:
+        return ActivityClassName(static_cast<void**>(__nullptr), contextName, formatString, argList); \
+    }
 
-#define __IMPLEMENT_TRACELOGGING_CLASS_WITHOUT_TELEMETRY(TraceLoggingClassName, ProviderName, ProviderId) \
-    __IMPLEMENT_TRACELOGGING_CLASS_BASE(TraceLoggingClassName, TraceLoggingClassName) \
-private: \
-    struct StaticHandle \
-    { \
-        TraceLoggingHProvider handle; \
-        StaticHandle() WI_NOEXCEPT \
-        { \
-            TRACELOGGING_DEFINE_PROVIDER_STORAGE(__hInner, ProviderName, ProviderId); \
-            _tlg_DefineProvider_annotation(TraceLoggingClassName, _Tlg##TraceLoggingClassName##Prov, 0, ProviderName); \
-            handle = &__hInner; \
-        } \
-    } m_staticHandle; \
-\
-protected: \
-    void Create() WI_NOEXCEPT \
-    { \
-        Register(m_staticHandle.handle); \
+#define __END_TRACELOGGING_ACTIVITY_CLASS() \
     } \
-\
-public:
+    ;
 /// @endcond
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT(EventId, ...) \
-    static void EventId() \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT(EventId, ...) \
+    void EventId() \
     { \
-        TraceLoggingWrite(TraceLoggingType::Provider(), #EventId, _GENERIC_PARTB_FIELDS_ENABLED, ##__VA_ARGS__); \
+        __WI_TraceLoggingWriteTagged(*this, #EventId, _GENERIC_PARTB_FIELDS_ENABLED, ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT(EventId, ...) \
-    static void EventId() \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT(EventId, ...) \
+    void EventId() \
     { \
-        TraceLoggingWrite(TraceLoggingType::Provider(), #EventId, ##__VA_ARGS__); \
+        __WI_TraceLoggingWriteTagged(*this, #EventId, ##__VA_ARGS__); \
     }
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_CV(EventId, ...) \
-    static void EventId(PCSTR correlationVector) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_CV(EventId, ...) \
+    void EventId(PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), #EventId, _GENERIC_PARTB_FIELDS_ENABLED, TraceLoggingString(correlationVector, "__TlgCV__"), ##__VA_ARGS__); \
+        __WI_TraceLoggingWriteTagged( \
+            *this, #EventId, _GENERIC_PARTB_FIELDS_ENABLED, TraceLoggingString(correlationVector, "__TlgCV__"), ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_CV(EventId, ...) \
-    static void EventId(PCSTR correlationVector) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_CV(EventId, ...) \
+    void EventId(PCSTR correlationVector) \
     { \
-        TraceLoggingWrite(TraceLoggingType::Provider(), #EventId, TraceLoggingString(correlationVector, "__TlgCV__"), ##__VA_ARGS__); \
+        __WI_TraceLoggingWriteTagged(*this, #EventId, TraceLoggingString(correlationVector, "__TlgCV__"), ##__VA_ARGS__); \
     }
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, ...) \
     template <typename T1> \
-    static void EventId(T1&& varName1) \
+    void EventId(T1&& varName1) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             _GENERIC_PARTB_FIELDS_ENABLED, \
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, ...) \
     template <typename T1> \
-    static void EventId(T1&& varName1) \
+    void EventId(T1&& varName1) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            ##__VA_ARGS__); \
+        __WI_TraceLoggingWriteTagged( \
+            *this, #EventId, TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), ##__VA_ARGS__); \
     }
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, ...) \
     template <typename T1> \
-    static void EventId(T1&& varName1, PCSTR correlationVector) \
+    void EventId(T1&& varName1, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             _GENERIC_PARTB_FIELDS_ENABLED, \
@@ -2438,12 +2916,12 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, ...) \
     template <typename T1> \
-    static void EventId(T1&& varName1, PCSTR correlationVector) \
+    void EventId(T1&& varName1, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingString(correlationVector, "__TlgCV__"), \
@@ -2452,12 +2930,12 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, ...) \
     template <typename T1, typename T2> \
-    static void EventId(T1&& varName1, T2&& varName2) \
+    void EventId(T1&& varName1, T2&& varName2) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2465,12 +2943,12 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, ...) \
     template <typename T1, typename T2> \
-    static void EventId(T1&& varName1, T2&& varName2) \
+    void EventId(T1&& varName1, T2&& varName2) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2479,12 +2957,12 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2, ...) \
     template <typename T1, typename T2> \
-    static void EventId(T1&& varName1, T2&& varName2, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2493,12 +2971,12 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2, ...) \
     template <typename T1, typename T2> \
-    static void EventId(T1&& varName1, T2&& varName2, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2508,12 +2986,12 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
     template <typename T1, typename T2, typename T3> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2522,12 +3000,12 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
     template <typename T1, typename T2, typename T3> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2537,12 +3015,12 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
     template <typename T1, typename T2, typename T3> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2552,12 +3030,12 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
     template <typename T1, typename T2, typename T3> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2568,12 +3046,13 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM4(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM4( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
     template <typename T1, typename T2, typename T3, typename T4> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2583,12 +3062,13 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM4(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM4( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
     template <typename T1, typename T2, typename T3, typename T4> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2599,12 +3079,13 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM4_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM4_CV( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
     template <typename T1, typename T2, typename T3, typename T4> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2615,12 +3096,13 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM4_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM4_CV( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
     template <typename T1, typename T2, typename T3, typename T4> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2632,13 +3114,13 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM5( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM5( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2649,13 +3131,13 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM5( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM5( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2667,13 +3149,13 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM5_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2685,13 +3167,13 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM5_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2704,13 +3186,13 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM6( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM6( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2722,13 +3204,13 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM6( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM6( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2741,13 +3223,13 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM6_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2760,13 +3242,13 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM6_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2780,13 +3262,13 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM7( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM7( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2799,13 +3281,13 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM7( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM7( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2819,14 +3301,13 @@ public:
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM7_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
-    static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2840,14 +3321,98 @@ public:
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM7_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
-    static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, PCSTR correlationVector) \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, PCSTR correlationVector) \
+    { \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
+            #EventId, \
+            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
+            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
+            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
+            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
+            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
+            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
+            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
+            TraceLoggingString(correlationVector, "__TlgCV__"), \
+            ##__VA_ARGS__); \
+    }
+#endif
+
+#ifdef _GENERIC_PARTB_FIELDS_ENABLED
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM8( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8) \
+    { \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
+            #EventId, \
+            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
+            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
+            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
+            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
+            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
+            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
+            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
+            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
+            _GENERIC_PARTB_FIELDS_ENABLED, \
+            ##__VA_ARGS__); \
+    }
+#else
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM8( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
+    void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8) \
+    { \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
+            #EventId, \
+            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
+            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
+            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
+            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
+            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
+            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
+            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
+            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
+            ##__VA_ARGS__); \
+    }
+#endif
+
+#ifdef _GENERIC_PARTB_FIELDS_ENABLED
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM8_CV( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
+    void EventId( \
+        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, PCSTR correlationVector) \
+    { \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
+            #EventId, \
+            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
+            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
+            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
+            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
+            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
+            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
+            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
+            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
+            _GENERIC_PARTB_FIELDS_ENABLED, \
+            TraceLoggingString(correlationVector, "__TlgCV__"), \
+            ##__VA_ARGS__); \
+    }
+#else
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM8_CV( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
+    void EventId( \
+        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2856,19 +3421,40 @@ public:
             TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
             TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
             TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
+            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
             TraceLoggingString(correlationVector, "__TlgCV__"), \
             ##__VA_ARGS__); \
     }
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM8( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM9( \
+    EventId, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    VarType8, \
+    varName8, \
+    VarType9, \
+    varName9, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9> \
+    void EventId( \
+        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
             #EventId, \
             TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
             TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
@@ -2878,78 +3464,881 @@ public:
             TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
             TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
             TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
+            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
             _GENERIC_PARTB_FIELDS_ENABLED, \
             ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM8( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
-    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8) \
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM9( \
+    EventId, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    VarType8, \
+    varName8, \
+    VarType9, \
+    varName9, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9> \
+    void EventId( \
+        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9) \
+    { \
+        __WI_TraceLoggingWriteTagged( \
+            *this, \
+            #EventId, \
+            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
+            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
+            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
+            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
+            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
+            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
+            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
+            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
+            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
+            ##__VA_ARGS__); \
+    }
+#endif
+
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_UINT32(EventId, varName, ...) \
+    DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, UINT32, varName, ##__VA_ARGS__)
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_BOOL(EventId, varName, ...) \
+    DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, bool, varName, ##__VA_ARGS__)
+#define DEFINE_TAGGED_TRACELOGGING_EVENT_STRING(EventId, varName, ...) \
+    DEFINE_TAGGED_TRACELOGGING_EVENT_PARAM1(EventId, PCWSTR, varName, ##__VA_ARGS__)
+
+// Internal MACRO implementation of TraceLogging classes.
+// Do NOT use these macros directly.
+/// @cond
+#define __IMPLEMENT_TRACELOGGING_CLASS_BASE(TraceLoggingClassName, TraceLoggingProviderOwnerClassName) \
+public: \
+    typedef TraceLoggingProviderOwnerClassName TraceLoggingType; \
+    static bool IsEnabled( \
+        UCHAR eventLevel = 0 /* WINEVENT_LEVEL_XXX, e.g. WINEVENT_LEVEL_VERBOSE */, \
+        ULONGLONG eventKeywords = 0 /* MICROSOFT_KEYWORD_XXX */) WI_NOEXCEPT \
+    { \
+        return Instance()->IsEnabled_(eventLevel, eventKeywords); \
+    } \
+    template <UCHAR eventLevel, ULONGLONG eventKeywords> \
+    static bool IsEventEnabled() WI_NOEXCEPT \
+    { \
+        using enablement = wil::details::event_enablement<TraceLoggingType>; \
+        auto const slot = &enablement::template slot<eventLevel, eventKeywords>::index; \
+        auto const index = ::ReadAcquire(slot); \
+        auto const enabled = (index > 0) ? enablement::cache.IsSlotEnabled(index) \
+                                         : wil::details::IsEventEnabledSlow<TraceLoggingType>( \
+                                               slot, eventLevel, eventKeywords, Provider()); \
+        return enabled || __TRACELOGGING_TEST_HOOK_SET_ENABLED; \
+    } \
+    static TraceLoggingHProvider Provider() WI_NOEXCEPT \
+    { \
+        return static_cast<TraceLoggingProvider*>(Instance())->Provider_(); \
+    } \
+    static void SetTelemetryEnabled(bool) WI_NOEXCEPT \
+    { \
+    } \
+    static void SetErrorReportingType(wil::ErrorReportingType type) WI_NOEXCEPT \
+    { \
+        return Instance()->SetErrorReportingType_(type); \
+    } \
+    static void __stdcall FallbackTelemetryCallback(bool alreadyReported, wil::FailureInfo const& failure) WI_NOEXCEPT \
+    { \
+        return Instance()->OnErrorReported(alreadyReported, failure); \
+    } \
+    static void __stdcall RegisterPeriodicEventSource(_In_ wil::details::periodic_event_source* source) WI_NOEXCEPT \
+    { \
+        Instance()->RegisterPeriodicEventSource_(source); \
+    } \
+    static void FlushPeriodicEvents() WI_NOEXCEPT \
+    { \
+        Instance()->FlushPeriodicEvents_(); \
+    } \
+    WI_NODISCARD static wil::ActivityThreadWatcher WatchCurrentThread(PCSTR contextName) WI_NOEXCEPT \
+    { \
+        return wil::ActivityThreadWatcher(Instance(), contextName); \
+    } \
+    WI_NODISCARD static wil::ActivityThreadWatcher WatchCurrentThread( \
+        PCSTR contextName, _Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
+    { \
+        va_list argList; \
+        va_start(argList, formatString); \
+        return wil::ActivityThreadWatcher(Instance(), contextName, formatString, argList); \
+    } \
+    __BEGIN_TRACELOGGING_ACTIVITY_CLASS(CallContext, wil::ActivityOptions::TelemetryOnFailure) \
+    __IMPLEMENT_CALLCONTEXT_CLASS(CallContext); \
+    __END_TRACELOGGING_ACTIVITY_CLASS(); \
+    static CallContext Start(PCSTR contextName) WI_NOEXCEPT \
+    { \
+        return CallContext(contextName, __nullptr, __nullptr); \
+    } \
+    static CallContext Start(PCSTR contextName, _Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
+    { \
+        va_list argList; \
+        va_start(argList, formatString); \
+        return CallContext(contextName, formatString, argList); \
+    } \
+    static void TraceLoggingInfo(_Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
+    { \
+        va_list argList; \
+        va_start(argList, formatString); \
+        return Instance()->ReportTraceLoggingMessage(formatString, argList); \
+    } \
+    static void TraceLoggingError(_Printf_format_string_ PCSTR formatString, ...) WI_NOEXCEPT \
+    { \
+        va_list argList; \
+        va_start(argList, formatString); \
+        return Instance()->ReportTraceLoggingError(formatString, argList); \
+    } \
+\
+private: \
+    TraceLoggingHProvider Provider_() const WI_NOEXCEPT = delete; \
+    TraceLoggingClassName() WI_NOEXCEPT{}; \
+\
+protected: \
+    static TraceLoggingClassName* Instance() WI_NOEXCEPT \
+    { \
+        static wil::details::static_lazy<TraceLoggingClassName> wrapper; \
+        return wrapper.get([]() { \
+            wrapper.cleanup(); \
+        }); \
+    } \
+    friend class wil::details::static_lazy<TraceLoggingClassName>;
+
+#define __IMPLEMENT_TRACELOGGING_CLASS_WITH_GROUP(TraceLoggingClassName, ProviderName, ProviderId, TraceLoggingOption) \
+    __IMPLEMENT_TRACELOGGING_CLASS_BASE(TraceLoggingClassName, TraceLoggingClassName) \
+private: \
+    struct StaticHandle \
+    { \
+        TraceLoggingHProvider handle; \
+        StaticHandle() WI_NOEXCEPT \
+        { \
+            TRACELOGGING_DEFINE_PROVIDER_STORAGE(__hInner, ProviderName, ProviderId, TraceLoggingOption); \
+            _tlg_DefineProvider_annotation(TraceLoggingClassName, _Tlg##TraceLoggingClassName##Prov, 0, ProviderName); \
+            handle = &__hInner; \
+        } \
+    } m_staticHandle; \
+\
+protected: \
+    void Create() WI_NOEXCEPT \
+    { \
+        Register(m_staticHandle.handle, nullptr, &wil::details::event_enablement<TraceLoggingClassName>::cache); \
+    } \
+\
+public:
+
+#define __IMPLEMENT_TRACELOGGING_CLASS(TraceLoggingClassName, ProviderName, ProviderId) \
+    __IMPLEMENT_TRACELOGGING_CLASS_WITH_GROUP(TraceLoggingClassName, ProviderName, ProviderId, TraceLoggingOptionMicrosoftTelemetry())
+
+#define __IMPLEMENT_TRACELOGGING_CLASS_WITH_GROUP_CB(TraceLoggingClassName, ProviderName, ProviderId, TraceLoggingOption) \
+    __IMPLEMENT_TRACELOGGING_CLASS_BASE(TraceLoggingClassName, TraceLoggingClassName) \
+private: \
+    struct StaticHandle \
+    { \
+        TraceLoggingHProvider handle; \
+        StaticHandle() WI_NOEXCEPT \
+        { \
+            TRACELOGGING_DEFINE_PROVIDER_STORAGE(__hInner, ProviderName, ProviderId, TraceLoggingOption); \
+            _tlg_DefineProvider_annotation(TraceLoggingClassName, _Tlg##TraceLoggingClassName##Prov, 0, ProviderName); \
+            handle = &__hInner; \
+        } \
+    } m_staticHandle; \
+    static VOID NTAPI Callback( \
+        _In_ const GUID* SourceId, \
+        ULONG ControlCode, \
+        UCHAR Level, \
+        ULONGLONG MatchAnyKeyword, \
+        ULONGLONG MatchAllKeyword, \
+        _In_opt_ EVENT_FILTER_DESCRIPTOR* FilterData, \
+        void* CallbackContext); \
+\
+protected: \
+    void Create() WI_NOEXCEPT \
+    { \
+        Register( \
+            m_staticHandle.handle, \
+            &TraceLoggingClassName::Callback, \
+            &wil::details::event_enablement<TraceLoggingClassName>::cache); \
+    } \
+\
+public:
+
+#define __IMPLEMENT_TRACELOGGING_CLASS_WITHOUT_TELEMETRY(TraceLoggingClassName, ProviderName, ProviderId) \
+    __IMPLEMENT_TRACELOGGING_CLASS_BASE(TraceLoggingClassName, TraceLoggingClassName) \
+private: \
+    struct StaticHandle \
+    { \
+        TraceLoggingHProvider handle; \
+        StaticHandle() WI_NOEXCEPT \
+        { \
+            TRACELOGGING_DEFINE_PROVIDER_STORAGE(__hInner, ProviderName, ProviderId); \
+            _tlg_DefineProvider_annotation(TraceLoggingClassName, _Tlg##TraceLoggingClassName##Prov, 0, ProviderName); \
+            handle = &__hInner; \
+        } \
+    } m_staticHandle; \
+\
+protected: \
+    void Create() WI_NOEXCEPT \
+    { \
+        Register(m_staticHandle.handle, nullptr, &wil::details::event_enablement<TraceLoggingClassName>::cache); \
+    } \
+\
+public:
+/// @endcond
+
+// DEFINE_TRACELOGGING_EVENT_PARAM* methods are thin templates that convert each argument to its declared field type
+// and call a single non-template writer generated for the event.  Only the writer contains the TraceLoggingWrite
+// expansion, so call sites passing different argument types (int vs. DWORD, lvalue vs. rvalue, ...) share one copy
+// of the event's metadata and write code rather than instantiating it per distinct argument signature.
+//
+// The template tests the provider's enablement cache (see IsEventEnabled) inline for the level and keywords passed to
+// __WI_DEFINE_TRACELOGGING_EVENT_PARAM*, so a disabled event costs a load and a branch rather than a call into the
+// writer.  The telemetry, measures and critical data macros pass the keyword they add to the event.  The generic
+// DEFINE_TRACELOGGING_EVENT_PARAM* macros pass 0, 0 (any level and keyword of an enabled provider), as the level and
+// keywords in their optional arguments are only known to TraceLoggingWrite, which makes the precise check.
+/// @cond
+#define __WI_TRACELOGGING_EXPAND(...) __VA_ARGS__
+#ifdef _GENERIC_PARTB_FIELDS_ENABLED
+#define __WI_TRACELOGGING_PARTB_FIELDS , _GENERIC_PARTB_FIELDS_ENABLED
+#else
+#define __WI_TRACELOGGING_PARTB_FIELDS
+#endif
+#define __WI_TRACELOGGING_FIELD(varName) TraceLoggingValue(varName, _wiltlg_STRINGIZE(varName))
+#define __WI_TRACELOGGING_EVENT_BODY(EventId, level, keywords, writerParameters, writerArguments, fields, ...) \
+    { \
+        if (TraceLoggingType::IsEventEnabled<level, keywords>()) \
+        { \
+            _wiltlg_Write_##EventId writerArguments; \
+        } \
+    } \
+    static __declspec(noinline) void _wiltlg_Write_##EventId writerParameters \
     { \
         TraceLoggingWrite( \
             TraceLoggingType::Provider(), \
             #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
+            __WI_TRACELOGGING_EXPAND fields __WI_TRACELOGGING_PARTB_FIELDS, \
             ##__VA_ARGS__); \
     }
+/// @endcond
+
+#ifdef _GENERIC_PARTB_FIELDS_ENABLED
+#define DEFINE_TRACELOGGING_EVENT(EventId, ...) \
+    static void EventId() \
+    { \
+        TraceLoggingWrite(TraceLoggingType::Provider(), #EventId, _GENERIC_PARTB_FIELDS_ENABLED, ##__VA_ARGS__); \
+    }
+#else
+#define DEFINE_TRACELOGGING_EVENT(EventId, ...) \
+    static void EventId() \
+    { \
+        TraceLoggingWrite(TraceLoggingType::Provider(), #EventId, ##__VA_ARGS__); \
+    }
 #endif
 
 #ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
-    static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, PCSTR correlationVector) \
+#define DEFINE_TRACELOGGING_EVENT_CV(EventId, ...) \
+    static void EventId(PCSTR correlationVector) \
     { \
         TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+            TraceLoggingType::Provider(), #EventId, _GENERIC_PARTB_FIELDS_ENABLED, TraceLoggingString(correlationVector, "__TlgCV__"), ##__VA_ARGS__); \
     }
 #else
-#define DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8, ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
-    static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, PCSTR correlationVector) \
+#define DEFINE_TRACELOGGING_EVENT_CV(EventId, ...) \
+    static void EventId(PCSTR correlationVector) \
     { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
+        TraceLoggingWrite(TraceLoggingType::Provider(), #EventId, TraceLoggingString(correlationVector, "__TlgCV__"), ##__VA_ARGS__); \
     }
 #endif
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM9( \
+/// @cond
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, level, keywords, VarType1, varName1, ...) \
+    template <typename T1> \
+    static void EventId(T1&& varName1) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1))), \
+        (__WI_TRACELOGGING_FIELD(varName1)), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV(EventId, level, keywords, VarType1, varName1, ...) \
+    template <typename T1> \
+    static void EventId(T1&& varName1, PCSTR correlationVector) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, PCSTR correlationVector), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), correlationVector), \
+        (__WI_TRACELOGGING_FIELD(varName1)), \
+        TraceLoggingString(correlationVector, "__TlgCV__"), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM2(EventId, level, keywords, VarType1, varName1, VarType2, varName2, ...) \
+    template <typename T1, typename T2> \
+    static void EventId(T1&& varName1, T2&& varName2) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, VarType2 varName2), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), static_cast<VarType2>(wistd::forward<T2>(varName2))), \
+        (__WI_TRACELOGGING_FIELD(varName1), __WI_TRACELOGGING_FIELD(varName2)), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV(EventId, level, keywords, VarType1, varName1, VarType2, varName2, ...) \
+    template <typename T1, typename T2> \
+    static void EventId(T1&& varName1, T2&& varName2, PCSTR correlationVector) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, VarType2 varName2, PCSTR correlationVector), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         correlationVector), \
+        (__WI_TRACELOGGING_FIELD(varName1), __WI_TRACELOGGING_FIELD(varName2)), \
+        TraceLoggingString(correlationVector, "__TlgCV__"), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM3( \
+    EventId, level, keywords, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
+    template <typename T1, typename T2, typename T3> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, VarType2 varName2, VarType3 varName3), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3))), \
+        (__WI_TRACELOGGING_FIELD(varName1), __WI_TRACELOGGING_FIELD(varName2), __WI_TRACELOGGING_FIELD(varName3)), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+    EventId, level, keywords, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
+    template <typename T1, typename T2, typename T3> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, PCSTR correlationVector) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, VarType2 varName2, VarType3 varName3, PCSTR correlationVector), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         correlationVector), \
+        (__WI_TRACELOGGING_FIELD(varName1), __WI_TRACELOGGING_FIELD(varName2), __WI_TRACELOGGING_FIELD(varName3)), \
+        TraceLoggingString(correlationVector, "__TlgCV__"), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM4( \
+    EventId, level, keywords, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
+    template <typename T1, typename T2, typename T3, typename T4> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, VarType2 varName2, VarType3 varName3, VarType4 varName4), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4))), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4)), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+    EventId, level, keywords, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
+    template <typename T1, typename T2, typename T3, typename T4> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, PCSTR correlationVector) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, VarType2 varName2, VarType3 varName3, VarType4 varName4, PCSTR correlationVector), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         correlationVector), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4)), \
+        TraceLoggingString(correlationVector, "__TlgCV__"), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM5( \
+    EventId, \
+    level, \
+    keywords, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, VarType2 varName2, VarType3 varName3, VarType4 varName4, VarType5 varName5), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5))), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5)), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+    EventId, \
+    level, \
+    keywords, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, PCSTR correlationVector) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, \
+         VarType2 varName2, \
+         VarType3 varName3, \
+         VarType4 varName4, \
+         VarType5 varName5, \
+         PCSTR correlationVector), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         correlationVector), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5)), \
+        TraceLoggingString(correlationVector, "__TlgCV__"), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM6( \
+    EventId, \
+    level, \
+    keywords, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, VarType2 varName2, VarType3 varName3, VarType4 varName4, VarType5 varName5, VarType6 varName6), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         static_cast<VarType6>(wistd::forward<T6>(varName6))), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5), \
+         __WI_TRACELOGGING_FIELD(varName6)), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+    EventId, \
+    level, \
+    keywords, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6> \
+    static void EventId( \
+        T1&& varName1, \
+        T2&& varName2, \
+        T3&& varName3, \
+        T4&& varName4, \
+        T5&& varName5, \
+        T6&& varName6, \
+        PCSTR correlationVector) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, \
+         VarType2 varName2, \
+         VarType3 varName3, \
+         VarType4 varName4, \
+         VarType5 varName5, \
+         VarType6 varName6, \
+         PCSTR correlationVector), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         static_cast<VarType6>(wistd::forward<T6>(varName6)), \
+         correlationVector), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5), \
+         __WI_TRACELOGGING_FIELD(varName6)), \
+        TraceLoggingString(correlationVector, "__TlgCV__"), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM7( \
+    EventId, \
+    level, \
+    keywords, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, \
+         VarType2 varName2, \
+         VarType3 varName3, \
+         VarType4 varName4, \
+         VarType5 varName5, \
+         VarType6 varName6, \
+         VarType7 varName7), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         static_cast<VarType6>(wistd::forward<T6>(varName6)), \
+         static_cast<VarType7>(wistd::forward<T7>(varName7))), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5), \
+         __WI_TRACELOGGING_FIELD(varName6), \
+         __WI_TRACELOGGING_FIELD(varName7)), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    EventId, \
+    level, \
+    keywords, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7> \
+    static void EventId( \
+        T1&& varName1, \
+        T2&& varName2, \
+        T3&& varName3, \
+        T4&& varName4, \
+        T5&& varName5, \
+        T6&& varName6, \
+        T7&& varName7, \
+        PCSTR correlationVector) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, \
+         VarType2 varName2, \
+         VarType3 varName3, \
+         VarType4 varName4, \
+         VarType5 varName5, \
+         VarType6 varName6, \
+         VarType7 varName7, \
+         PCSTR correlationVector), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         static_cast<VarType6>(wistd::forward<T6>(varName6)), \
+         static_cast<VarType7>(wistd::forward<T7>(varName7)), \
+         correlationVector), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5), \
+         __WI_TRACELOGGING_FIELD(varName6), \
+         __WI_TRACELOGGING_FIELD(varName7)), \
+        TraceLoggingString(correlationVector, "__TlgCV__"), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM8( \
+    EventId, \
+    level, \
+    keywords, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    VarType8, \
+    varName8, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
+    static void EventId( \
+        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, \
+         VarType2 varName2, \
+         VarType3 varName3, \
+         VarType4 varName4, \
+         VarType5 varName5, \
+         VarType6 varName6, \
+         VarType7 varName7, \
+         VarType8 varName8), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         static_cast<VarType6>(wistd::forward<T6>(varName6)), \
+         static_cast<VarType7>(wistd::forward<T7>(varName7)), \
+         static_cast<VarType8>(wistd::forward<T8>(varName8))), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5), \
+         __WI_TRACELOGGING_FIELD(varName6), \
+         __WI_TRACELOGGING_FIELD(varName7), \
+         __WI_TRACELOGGING_FIELD(varName8)), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    EventId, \
+    level, \
+    keywords, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    VarType8, \
+    varName8, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8> \
+    static void EventId( \
+        T1&& varName1, \
+        T2&& varName2, \
+        T3&& varName3, \
+        T4&& varName4, \
+        T5&& varName5, \
+        T6&& varName6, \
+        T7&& varName7, \
+        T8&& varName8, \
+        PCSTR correlationVector) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, \
+         VarType2 varName2, \
+         VarType3 varName3, \
+         VarType4 varName4, \
+         VarType5 varName5, \
+         VarType6 varName6, \
+         VarType7 varName7, \
+         VarType8 varName8, \
+         PCSTR correlationVector), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         static_cast<VarType6>(wistd::forward<T6>(varName6)), \
+         static_cast<VarType7>(wistd::forward<T7>(varName7)), \
+         static_cast<VarType8>(wistd::forward<T8>(varName8)), \
+         correlationVector), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5), \
+         __WI_TRACELOGGING_FIELD(varName6), \
+         __WI_TRACELOGGING_FIELD(varName7), \
+         __WI_TRACELOGGING_FIELD(varName8)), \
+        TraceLoggingString(correlationVector, "__TlgCV__"), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM9( \
+    EventId, \
+    level, \
+    keywords, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    VarType8, \
+    varName8, \
+    VarType9, \
+    varName9, \
+    ...) \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9> \
+    static void EventId( \
+        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, \
+         VarType2 varName2, \
+         VarType3 varName3, \
+         VarType4 varName4, \
+         VarType5 varName5, \
+         VarType6 varName6, \
+         VarType7 varName7, \
+         VarType8 varName8, \
+         VarType9 varName9), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         static_cast<VarType6>(wistd::forward<T6>(varName6)), \
+         static_cast<VarType7>(wistd::forward<T7>(varName7)), \
+         static_cast<VarType8>(wistd::forward<T8>(varName8)), \
+         static_cast<VarType9>(wistd::forward<T9>(varName9))), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5), \
+         __WI_TRACELOGGING_FIELD(varName6), \
+         __WI_TRACELOGGING_FIELD(varName7), \
+         __WI_TRACELOGGING_FIELD(varName8), \
+         __WI_TRACELOGGING_FIELD(varName9)), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM9_CV( \
     EventId, \
+    level, \
+    keywords, \
     VarType1, \
     varName1, \
     VarType2, \
@@ -2971,26 +4360,56 @@ public:
     ...) \
     template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9> \
     static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9) \
-    { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TRACELOGGING_EVENT_PARAM9( \
+        T1&& varName1, \
+        T2&& varName2, \
+        T3&& varName3, \
+        T4&& varName4, \
+        T5&& varName5, \
+        T6&& varName6, \
+        T7&& varName7, \
+        T8&& varName8, \
+        T9&& varName9, \
+        PCSTR correlationVector) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, \
+         VarType2 varName2, \
+         VarType3 varName3, \
+         VarType4 varName4, \
+         VarType5 varName5, \
+         VarType6 varName6, \
+         VarType7 varName7, \
+         VarType8 varName8, \
+         VarType9 varName9, \
+         PCSTR correlationVector), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         static_cast<VarType6>(wistd::forward<T6>(varName6)), \
+         static_cast<VarType7>(wistd::forward<T7>(varName7)), \
+         static_cast<VarType8>(wistd::forward<T8>(varName8)), \
+         static_cast<VarType9>(wistd::forward<T9>(varName9)), \
+         correlationVector), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5), \
+         __WI_TRACELOGGING_FIELD(varName6), \
+         __WI_TRACELOGGING_FIELD(varName7), \
+         __WI_TRACELOGGING_FIELD(varName8), \
+         __WI_TRACELOGGING_FIELD(varName9)), \
+        TraceLoggingString(correlationVector, "__TlgCV__"), \
+        ##__VA_ARGS__)
+
+#define __WI_DEFINE_TRACELOGGING_EVENT_PARAM10( \
     EventId, \
+    level, \
+    keywords, \
     VarType1, \
     varName1, \
     VarType2, \
@@ -3009,29 +4428,337 @@ public:
     varName8, \
     VarType9, \
     varName9, \
+    VarType10, \
+    varName10, \
     ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9> \
+    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9, typename T10> \
     static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9) \
-    { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
-            ##__VA_ARGS__); \
-    }
-#endif
+        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9, T10&& varName10) \
+    __WI_TRACELOGGING_EVENT_BODY( \
+        EventId, \
+        level, \
+        keywords, \
+        (VarType1 varName1, \
+         VarType2 varName2, \
+         VarType3 varName3, \
+         VarType4 varName4, \
+         VarType5 varName5, \
+         VarType6 varName6, \
+         VarType7 varName7, \
+         VarType8 varName8, \
+         VarType9 varName9, \
+         VarType10 varName10), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4)), \
+         static_cast<VarType5>(wistd::forward<T5>(varName5)), \
+         static_cast<VarType6>(wistd::forward<T6>(varName6)), \
+         static_cast<VarType7>(wistd::forward<T7>(varName7)), \
+         static_cast<VarType8>(wistd::forward<T8>(varName8)), \
+         static_cast<VarType9>(wistd::forward<T9>(varName9)), \
+         static_cast<VarType10>(wistd::forward<T10>(varName10))), \
+        (__WI_TRACELOGGING_FIELD(varName1), \
+         __WI_TRACELOGGING_FIELD(varName2), \
+         __WI_TRACELOGGING_FIELD(varName3), \
+         __WI_TRACELOGGING_FIELD(varName4), \
+         __WI_TRACELOGGING_FIELD(varName5), \
+         __WI_TRACELOGGING_FIELD(varName6), \
+         __WI_TRACELOGGING_FIELD(varName7), \
+         __WI_TRACELOGGING_FIELD(varName8), \
+         __WI_TRACELOGGING_FIELD(varName9), \
+         __WI_TRACELOGGING_FIELD(varName10)), \
+        ##__VA_ARGS__)
+/// @endcond
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, 0, 0, VarType1, varName1, ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV(EventId, 0, 0, VarType1, varName1, ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2(EventId, 0, 0, VarType1, varName1, VarType2, varName2, ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV(EventId, 0, 0, VarType1, varName1, VarType2, varName2, ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM4( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM5( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM6( \
+    EventId, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+    EventId, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM7( \
+    EventId, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        VarType7, \
+        varName7, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    EventId, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        VarType7, \
+        varName7, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM8( \
+    EventId, \
+    VarType1, \
+    varName1, \
+    VarType2, \
+    varName2, \
+    VarType3, \
+    varName3, \
+    VarType4, \
+    varName4, \
+    VarType5, \
+    varName5, \
+    VarType6, \
+    varName6, \
+    VarType7, \
+    varName7, \
+    VarType8, \
+    varName8, \
+    ...) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        VarType7, \
+        varName7, \
+        VarType8, \
+        varName8, \
+        ##__VA_ARGS__)
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM9_CV( \
+#define DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
     EventId, \
     VarType1, \
     varName1, \
@@ -3049,31 +4776,30 @@ public:
     varName7, \
     VarType8, \
     varName8, \
-    VarType9, \
-    varName9, \
     ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9> \
-    static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9, PCSTR correlationVector) \
-    { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
-    }
-#else
-#define DEFINE_TRACELOGGING_EVENT_PARAM9_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        VarType7, \
+        varName7, \
+        VarType8, \
+        varName8, \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_EVENT_PARAM9( \
     EventId, \
     VarType1, \
     varName1, \
@@ -3094,29 +4820,31 @@ public:
     VarType9, \
     varName9, \
     ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9> \
-    static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9, PCSTR correlationVector) \
-    { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
-            TraceLoggingString(correlationVector, "__TlgCV__"), \
-            ##__VA_ARGS__); \
-    }
-#endif
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM9( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        VarType7, \
+        varName7, \
+        VarType8, \
+        varName8, \
+        VarType9, \
+        varName9, \
+        ##__VA_ARGS__)
 
-#ifdef _GENERIC_PARTB_FIELDS_ENABLED
-#define DEFINE_TRACELOGGING_EVENT_PARAM10( \
+#define DEFINE_TRACELOGGING_EVENT_PARAM9_CV( \
     EventId, \
     VarType1, \
     varName1, \
@@ -3136,30 +4864,31 @@ public:
     varName8, \
     VarType9, \
     varName9, \
-    VarType10, \
-    varName10, \
     ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9, typename T10> \
-    static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9, T10&& varName10) \
-    { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
-            TraceLoggingValue(static_cast<VarType10>(wistd::forward<T10>(varName10)), _wiltlg_STRINGIZE(varName10)), \
-            _GENERIC_PARTB_FIELDS_ENABLED, \
-            ##__VA_ARGS__); \
-    }
-#else
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM9_CV( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        VarType7, \
+        varName7, \
+        VarType8, \
+        varName8, \
+        VarType9, \
+        varName9, \
+        ##__VA_ARGS__)
+
 #define DEFINE_TRACELOGGING_EVENT_PARAM10( \
     EventId, \
     VarType1, \
@@ -3183,26 +4912,31 @@ public:
     VarType10, \
     varName10, \
     ...) \
-    template <typename T1, typename T2, typename T3, typename T4, typename T5, typename T6, typename T7, typename T8, typename T9, typename T10> \
-    static void EventId( \
-        T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4, T5&& varName5, T6&& varName6, T7&& varName7, T8&& varName8, T9&& varName9, T10&& varName10) \
-    { \
-        TraceLoggingWrite( \
-            TraceLoggingType::Provider(), \
-            #EventId, \
-            TraceLoggingValue(static_cast<VarType1>(wistd::forward<T1>(varName1)), _wiltlg_STRINGIZE(varName1)), \
-            TraceLoggingValue(static_cast<VarType2>(wistd::forward<T2>(varName2)), _wiltlg_STRINGIZE(varName2)), \
-            TraceLoggingValue(static_cast<VarType3>(wistd::forward<T3>(varName3)), _wiltlg_STRINGIZE(varName3)), \
-            TraceLoggingValue(static_cast<VarType4>(wistd::forward<T4>(varName4)), _wiltlg_STRINGIZE(varName4)), \
-            TraceLoggingValue(static_cast<VarType5>(wistd::forward<T5>(varName5)), _wiltlg_STRINGIZE(varName5)), \
-            TraceLoggingValue(static_cast<VarType6>(wistd::forward<T6>(varName6)), _wiltlg_STRINGIZE(varName6)), \
-            TraceLoggingValue(static_cast<VarType7>(wistd::forward<T7>(varName7)), _wiltlg_STRINGIZE(varName7)), \
-            TraceLoggingValue(static_cast<VarType8>(wistd::forward<T8>(varName8)), _wiltlg_STRINGIZE(varName8)), \
-            TraceLoggingValue(static_cast<VarType9>(wistd::forward<T9>(varName9)), _wiltlg_STRINGIZE(varName9)), \
-            TraceLoggingValue(static_cast<VarType10>(wistd::forward<T10>(varName10)), _wiltlg_STRINGIZE(varName10)), \
-            ##__VA_ARGS__); \
-    }
-#endif
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM10( \
+        EventId, \
+        0, \
+        0, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        VarType7, \
+        varName7, \
+        VarType8, \
+        varName8, \
+        VarType9, \
+        varName9, \
+        VarType10, \
+        varName10, \
+        ##__VA_ARGS__)
 
 #define DEFINE_TRACELOGGING_EVENT_UINT32(EventId, varName, ...) \
     DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, UINT32, varName, ##__VA_ARGS__)
@@ -3211,6 +4945,94 @@ public:
 #define DEFINE_TRACELOGGING_EVENT_STRING(EventId, varName, ...) \
     DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, PCWSTR, varName, ##__VA_ARGS__)
 
+// Batched events buffer the field values of each call and write them as a single event with an "events" array of
+// structs, once per WIL_BATCHED_EVENT_CAPACITY calls per processor or at least every
+// WIL_BATCHED_EVENT_FLUSH_INTERVAL_MS, and finally when the provider is destroyed.  This trades per-call timestamps
+// for far fewer ETW writes on chatty events.  Fields must be fixed-size values (integers, floating point, bool, GUID,
+// FILETIME) and any optional arguments must be constant (keyword, level, privacy tag, ...).
+/// @cond
+#define __WI_BATCHED_EVENT_METADATA(VarType, varName) \
+    TraceLoggingPackedMetadataEx( \
+        wil::details::batched_event_field<VarType>::inType, \
+        wil::details::batched_event_field<VarType>::outType, \
+        _wiltlg_STRINGIZE(varName))
+#define __WI_BATCHED_EVENT_BODY(EventId, entrySize, fieldCount, fieldMetadata, fieldValues, ...) \
+    { \
+        if (TraceLoggingType::IsEnabled()) \
+        { \
+            static wil::details::batched_event<entrySize> s_batch( \
+                [](TraceLoggingHProvider provider, UINT16 count, void const* entries) WI_NOEXCEPT { \
+                    TraceLoggingWrite( \
+                        provider, \
+                        #EventId, \
+                        TraceLoggingPackedStructArray(fieldCount, "events"), \
+                        __WI_TRACELOGGING_EXPAND fieldMetadata, \
+                        TraceLoggingPackedData(&count, sizeof(count)), \
+                        TraceLoggingPackedData(entries, static_cast<UINT16>(count * (entrySize))) \
+                            __WI_TRACELOGGING_PARTB_FIELDS, \
+                        ##__VA_ARGS__); \
+                }, \
+                &TraceLoggingType::RegisterPeriodicEventSource); \
+            s_batch.Add(TraceLoggingType::Provider(), __WI_TRACELOGGING_EXPAND fieldValues); \
+        } \
+    }
+/// @endcond
+
+#define DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM1(EventId, VarType1, varName1, ...) \
+    template <typename T1> \
+    static void EventId(T1&& varName1) \
+    __WI_BATCHED_EVENT_BODY( \
+        EventId, \
+        sizeof(VarType1), \
+        1, \
+        (__WI_BATCHED_EVENT_METADATA(VarType1, varName1)), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1))), \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, ...) \
+    template <typename T1, typename T2> \
+    static void EventId(T1&& varName1, T2&& varName2) \
+    __WI_BATCHED_EVENT_BODY( \
+        EventId, \
+        sizeof(VarType1) + sizeof(VarType2), \
+        2, \
+        (__WI_BATCHED_EVENT_METADATA(VarType1, varName1), __WI_BATCHED_EVENT_METADATA(VarType2, varName2)), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), static_cast<VarType2>(wistd::forward<T2>(varName2))), \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, ...) \
+    template <typename T1, typename T2, typename T3> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3) \
+    __WI_BATCHED_EVENT_BODY( \
+        EventId, \
+        sizeof(VarType1) + sizeof(VarType2) + sizeof(VarType3), \
+        3, \
+        (__WI_BATCHED_EVENT_METADATA(VarType1, varName1), \
+         __WI_BATCHED_EVENT_METADATA(VarType2, varName2), \
+         __WI_BATCHED_EVENT_METADATA(VarType3, varName3)), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3))), \
+        ##__VA_ARGS__)
+
+#define DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM4( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, ...) \
+    template <typename T1, typename T2, typename T3, typename T4> \
+    static void EventId(T1&& varName1, T2&& varName2, T3&& varName3, T4&& varName4) \
+    __WI_BATCHED_EVENT_BODY( \
+        EventId, \
+        sizeof(VarType1) + sizeof(VarType2) + sizeof(VarType3) + sizeof(VarType4), \
+        4, \
+        (__WI_BATCHED_EVENT_METADATA(VarType1, varName1), \
+         __WI_BATCHED_EVENT_METADATA(VarType2, varName2), \
+         __WI_BATCHED_EVENT_METADATA(VarType3, varName3), \
+         __WI_BATCHED_EVENT_METADATA(VarType4, varName4)), \
+        (static_cast<VarType1>(wistd::forward<T1>(varName1)), \
+         static_cast<VarType2>(wistd::forward<T2>(varName2)), \
+         static_cast<VarType3>(wistd::forward<T3>(varName3)), \
+         static_cast<VarType4>(wistd::forward<T4>(varName4))), \
+        ##__VA_ARGS__)
+
 // Declaring a pure TraceLogging class
 // To declare a tracelogging class, declare your class derived from wil::TraceLoggingProvider, populate the uuid
 // attribute of the class with the GUID of your provider, and then include the IMPLEMENT_TRACELOGGING_CLASS_WITH_MICROSOFT_TELEMETRY
@@ -3307,27 +5129,91 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 #define DEFINE_TELEMETRY_EVENT(EventId) DEFINE_TRACELOGGING_EVENT(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 
 #define DEFINE_TELEMETRY_EVENT_PARAM1(EventId, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM4(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM5( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM6( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM7( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3345,8 +5231,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM8( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3367,27 +5255,91 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 
 #define DEFINE_TELEMETRY_EVENT_CV(EventId) DEFINE_TRACELOGGING_EVENT_CV(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM1_CV(EventId, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM4_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM5_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM6_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM7_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3405,8 +5357,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY))
 #define DEFINE_TELEMETRY_EVENT_PARAM8_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3435,18 +5389,44 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     DEFINE_TRACELOGGING_EVENT(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), TelemetryPrivacyDataTag(PrivacyTag))
 
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM1(EventId, PrivacyTag, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1( \
-        EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM2(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2( \
-        EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM3(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM4( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3459,8 +5439,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM5( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3475,8 +5457,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM6( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3493,8 +5477,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM7( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3530,8 +5516,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName7, \
     VarType8, \
     varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3554,18 +5542,44 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_CV(EventId, PrivacyTag) \
     DEFINE_TRACELOGGING_EVENT_CV(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM1_CV(EventId, PrivacyTag, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
-        EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM2_CV(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM3_CV(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM4_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3578,8 +5592,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM5_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3594,8 +5610,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM6_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3612,8 +5630,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_TELEMETRY_EVENT_PARAM7_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3649,8 +5669,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName7, \
     VarType8, \
     varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3674,16 +5696,20 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     DEFINE_TRACELOGGING_EVENT_CV( \
         EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), TelemetryPrivacyDataTag(PrivacyTag), TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_TELEMETRY_EVENT_PARAM1_CV(EventId, PrivacyTag, EventTag, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         TraceLoggingKeyword(MICROSOFT_KEYWORD_TELEMETRY), \
         TelemetryPrivacyDataTag(PrivacyTag), \
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_TELEMETRY_EVENT_PARAM2_CV(EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3693,8 +5719,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_TELEMETRY_EVENT_PARAM3_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3706,8 +5734,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_TELEMETRY_EVENT_PARAM4_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3721,8 +5751,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_TELEMETRY_EVENT_PARAM5_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3738,8 +5770,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_TELEMETRY_EVENT_PARAM6_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3757,8 +5791,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_TELEMETRY_EVENT_PARAM7_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3796,8 +5832,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName7, \
     VarType8, \
     varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_TELEMETRY, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3832,27 +5870,181 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 
 #define DEFINE_MEASURES_EVENT(EventId) DEFINE_TRACELOGGING_EVENT(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
 #define DEFINE_MEASURES_EVENT_PARAM1(EventId, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
 #define DEFINE_MEASURES_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
 #define DEFINE_MEASURES_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
 #define DEFINE_MEASURES_EVENT_PARAM4(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
 #define DEFINE_MEASURES_EVENT_PARAM5( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-#define DEFINE_MEASURES_EVENT_PARAM6( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-#define DEFINE_MEASURES_EVENT_PARAM7( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+#define DEFINE_MEASURES_EVENT_PARAM6( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+#define DEFINE_MEASURES_EVENT_PARAM7( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        VarType7, \
+        varName7, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+#define DEFINE_MEASURES_EVENT_PARAM8( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        VarType7, \
+        varName7, \
+        VarType8, \
+        varName8, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+
+#define DEFINE_MEASURES_EVENT_CV(EventId) DEFINE_TRACELOGGING_EVENT_CV(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+#define DEFINE_MEASURES_EVENT_PARAM1_CV(EventId, VarType1, varName1) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+#define DEFINE_MEASURES_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+#define DEFINE_MEASURES_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+#define DEFINE_MEASURES_EVENT_PARAM4_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
+#define DEFINE_MEASURES_EVENT_PARAM5_CV( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3863,15 +6055,13 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         varName4, \
         VarType5, \
         varName5, \
-        VarType6, \
-        varName6, \
-        VarType7, \
-        varName7, \
         TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-#define DEFINE_MEASURES_EVENT_PARAM8( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8( \
+#define DEFINE_MEASURES_EVENT_PARAM6_CV( \
+    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3884,35 +6074,13 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         varName5, \
         VarType6, \
         varName6, \
-        VarType7, \
-        varName7, \
-        VarType8, \
-        varName8, \
         TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-
-#define DEFINE_MEASURES_EVENT_CV(EventId) DEFINE_TRACELOGGING_EVENT_CV(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-#define DEFINE_MEASURES_EVENT_PARAM1_CV(EventId, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-#define DEFINE_MEASURES_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-#define DEFINE_MEASURES_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-#define DEFINE_MEASURES_EVENT_PARAM4_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-#define DEFINE_MEASURES_EVENT_PARAM5_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
-#define DEFINE_MEASURES_EVENT_PARAM6_CV( \
-    EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
 #define DEFINE_MEASURES_EVENT_PARAM7_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3930,8 +6098,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES))
 #define DEFINE_MEASURES_EVENT_PARAM8_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3959,18 +6129,44 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 #define DEFINE_COMPLIANT_MEASURES_EVENT(EventId, PrivacyTag) \
     DEFINE_TRACELOGGING_EVENT(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM1(EventId, PrivacyTag, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1( \
-        EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM2(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2( \
-        EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM3(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM4( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3983,8 +6179,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM5( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -3999,8 +6197,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM6( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4017,8 +6217,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM7( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4054,8 +6256,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName7, \
     VarType8, \
     varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4095,8 +6299,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName8, \
     VarType9, \
     varName9) \
-    DEFINE_TRACELOGGING_EVENT_PARAM9( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM9( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4140,8 +6346,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName9, \
     VarType10, \
     varName10) \
-    DEFINE_TRACELOGGING_EVENT_PARAM10( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM10( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4168,18 +6376,44 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 #define DEFINE_COMPLIANT_MEASURES_EVENT_CV(EventId, PrivacyTag) \
     DEFINE_TRACELOGGING_EVENT_CV(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM1_CV(EventId, PrivacyTag, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
-        EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM2_CV(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM3_CV(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM4_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4192,8 +6426,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM5_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4208,8 +6444,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM6_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4226,8 +6464,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_MEASURES_EVENT_PARAM7_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4263,8 +6503,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName7, \
     VarType8, \
     varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4288,11 +6530,20 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     DEFINE_TRACELOGGING_EVENT_CV( \
         EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag), TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_MEASURES_EVENT_PARAM1_CV(EventId, PrivacyTag, EventTag, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
-        EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), TelemetryPrivacyDataTag(PrivacyTag), TraceLoggingEventTag(EventTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_MEASURES), \
+        TelemetryPrivacyDataTag(PrivacyTag), \
+        TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_MEASURES_EVENT_PARAM2_CV(EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4302,8 +6553,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_MEASURES_EVENT_PARAM3_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4315,8 +6568,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_MEASURES_EVENT_PARAM4_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4330,8 +6585,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_MEASURES_EVENT_PARAM5_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4347,8 +6604,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_MEASURES_EVENT_PARAM6_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4366,8 +6625,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_MEASURES_EVENT_PARAM7_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4405,8 +6666,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName7, \
     VarType8, \
     varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4448,8 +6711,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName8, \
     VarType9, \
     varName9) \
-    DEFINE_TRACELOGGING_EVENT_PARAM9_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM9_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_MEASURES, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4487,27 +6752,91 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 #define DEFINE_CRITICAL_DATA_EVENT(EventId) \
     DEFINE_TRACELOGGING_EVENT(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM1(EventId, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1(EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2(EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM3(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM4(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM5( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM6( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM7( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4525,8 +6854,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM8( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4548,28 +6879,91 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 #define DEFINE_CRITICAL_DATA_EVENT_CV(EventId) \
     DEFINE_TRACELOGGING_EVENT_CV(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM1_CV(EventId, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1_CV(EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM2_CV(EventId, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM3_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM4_CV(EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM5_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM6_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        VarType4, \
+        varName4, \
+        VarType5, \
+        varName5, \
+        VarType6, \
+        varName6, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM7_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4587,8 +6981,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA))
 #define DEFINE_CRITICAL_DATA_EVENT_PARAM8_CV( \
     EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7, VarType8, varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4616,18 +7012,44 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT(EventId, PrivacyTag) \
     DEFINE_TRACELOGGING_EVENT(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM1(EventId, PrivacyTag, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1( \
-        EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM2(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2( \
-        EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM3(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM4( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4640,8 +7062,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM5( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4656,8 +7080,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM6( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4674,8 +7100,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM7( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4711,8 +7139,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName7, \
     VarType8, \
     varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4752,8 +7182,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName8, \
     VarType9, \
     varName9) \
-    DEFINE_TRACELOGGING_EVENT_PARAM9( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM9( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4778,18 +7210,44 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_CV(EventId, PrivacyTag) \
     DEFINE_TRACELOGGING_EVENT_CV(EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM1_CV(EventId, PrivacyTag, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
-        EventId, VarType1, varName1, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM2_CV(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM3_CV(EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
-        EventId, VarType1, varName1, VarType2, varName2, VarType3, varName3, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), TelemetryPrivacyDataTag(PrivacyTag))
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+        EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
+        VarType1, \
+        varName1, \
+        VarType2, \
+        varName2, \
+        VarType3, \
+        varName3, \
+        TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), \
+        TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM4_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4802,8 +7260,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM5_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4818,8 +7278,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM6_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4836,8 +7298,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TelemetryPrivacyDataTag(PrivacyTag))
 #define DEFINE_COMPLIANT_CRITICAL_DATA_EVENT_PARAM7_CV( \
     EventId, PrivacyTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4873,8 +7337,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName7, \
     VarType8, \
     varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4898,16 +7364,20 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     DEFINE_TRACELOGGING_EVENT_CV( \
         EventId, TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), TelemetryPrivacyDataTag(PrivacyTag), TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_CRITICAL_DATA_EVENT_PARAM1_CV(EventId, PrivacyTag, EventTag, VarType1, varName1) \
-    DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM1_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         TraceLoggingKeyword(MICROSOFT_KEYWORD_CRITICAL_DATA), \
         TelemetryPrivacyDataTag(PrivacyTag), \
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_CRITICAL_DATA_EVENT_PARAM2_CV(EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2) \
-    DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM2_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4917,8 +7387,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_CRITICAL_DATA_EVENT_PARAM3_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3) \
-    DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM3_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4930,8 +7402,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_CRITICAL_DATA_EVENT_PARAM4_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4) \
-    DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM4_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4945,8 +7419,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_CRITICAL_DATA_EVENT_PARAM5_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5) \
-    DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM5_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4962,8 +7438,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_CRITICAL_DATA_EVENT_PARAM6_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6) \
-    DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM6_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -4981,8 +7459,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         TraceLoggingEventTag(EventTag))
 #define DEFINE_COMPLIANT_EVENTTAGGED_CRITICAL_DATA_EVENT_PARAM7_CV( \
     EventId, PrivacyTag, EventTag, VarType1, varName1, VarType2, varName2, VarType3, varName3, VarType4, varName4, VarType5, varName5, VarType6, varName6, VarType7, varName7) \
-    DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM7_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -5020,8 +7500,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName7, \
     VarType8, \
     varName8) \
-    DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM8_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -5063,8 +7545,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     varName8, \
     VarType9, \
     varName9) \
-    DEFINE_TRACELOGGING_EVENT_PARAM9_CV( \
+    __WI_DEFINE_TRACELOGGING_EVENT_PARAM9_CV( \
         EventId, \
+        WINEVENT_LEVEL_VERBOSE, \
+        MICROSOFT_KEYWORD_CRITICAL_DATA, \
         VarType1, \
         varName1, \
         VarType2, \
@@ -6123,6 +8607,7 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
     class ActivityClassName final : public _TlgActivityBase<ActivityClassName, keyword, level> \
     { \
         static const UINT64 PrivacyTag = 0; \
+        static const bool AggregatesDuration = false; \
         friend class _TlgActivityBase<ActivityClassName, keyword, level>; \
         void OnStarted() \
         { \
@@ -6152,6 +8637,10 @@ WIL_WARN_DEPRECATED_1612_PRAGMA("IMPLEMENT_TRACELOGGING_CLASS")
         void IgnoreCurrentThread() \
         { \
         } \
+        template <typename TActivity> \
+        void RecordActivityDuration(PCSTR) \
+        { \
+        } \
         wil::FailureInfo const* GetFailureInfo() \
         { \
             return (FAILED(m_result) && (m_cache.GetFailure() != nullptr) && (m_result == m_cache.GetFailure()->hr)) \
@@ -28,6 +28,9 @@
 
 #if WIL_USE_STL
 #include <iterator>
+#if (__WI_LIBCPP_STD_VER >= 20) && WI_HAS_INCLUDE(<span>, 1) // Assume present if C++20
+#include <span>
+#endif
 #endif
 
 namespace wil
@@ -187,9 +190,11 @@ inline void CreateDirectoryDeep(PCWSTR path)
 //! @param file The path to expand to a fully qualified form.
 //! @param path Receives the fully qualified path.
 //! @param filePart Optional. If non-null, receives a pointer, within `path`, to the start of the file-name component.
+//! @param sizeHint Optional. Remembers the buffer length between calls so long paths need one call; see @ref buffer_size_hint.
 //! @return `S_OK` on success, otherwise a failure `HRESULT`
 template <typename string_type, size_t stackBufferLength = 256>
-HRESULT GetFullPathNameW(PCWSTR file, string_type& path, _Outptr_opt_ PCWSTR* filePart = nullptr)
+HRESULT GetFullPathNameW(
+    PCWSTR file, string_type& path, _Outptr_opt_ PCWSTR* filePart = nullptr, _Inout_opt_ buffer_size_hint* sizeHint = nullptr)
 {
     wil::assign_null_to_opt_param(filePart);
     const auto hr = AdaptFixedSizeToAllocatedResult<string_type, stackBufferLength>(
@@ -204,7 +209,7 @@ HRESULT GetFullPathNameW(PCWSTR file, string_type& path, _Outptr_opt_ PCWSTR* fi
                 (*valueLengthNeededWithNull)++; // it fit, account for the null
             }
             return S_OK;
-        });
+        }, sizeHint);
     if (SUCCEEDED(hr) && filePart)
     {
         *filePart = wil::find_last_path_segment(details::string_maker<string_type>::get(path));
@@ -214,13 +219,15 @@ HRESULT GetFullPathNameW(PCWSTR file, string_type& path, _Outptr_opt_ PCWSTR* fi
 
 #ifdef WIL_ENABLE_EXCEPTIONS
 //! A strongly typed version of the Win32 API `GetFullPathNameW` that returns the fully qualified path, throwing on failure.
-//! The exception-based counterpart to @ref wil::GetFullPathNameW(PCWSTR,string_type&,PCWSTR*) "the non-throwing overload"; see
-//! that overload for details.
+//! The exception-based counterpart to
+//! @ref wil::GetFullPathNameW(PCWSTR,string_type&,PCWSTR*,buffer_size_hint*) "the non-throwing overload"; see that overload
+//! for details.
 template <typename string_type = wil::unique_cotaskmem_string, size_t stackBufferLength = 256>
-string_type GetFullPathNameW(PCWSTR file, _Outptr_opt_ PCWSTR* filePart = nullptr)
+string_type GetFullPathNameW(
+    PCWSTR file, _Outptr_opt_ PCWSTR* filePart = nullptr, _Inout_opt_ buffer_size_hint* sizeHint = nullptr)
 {
     string_type result{};
-    THROW_IF_FAILED((GetFullPathNameW<string_type, stackBufferLength>(file, result, filePart)));
+    THROW_IF_FAILED((GetFullPathNameW<string_type, stackBufferLength>(file, result, filePart, sizeHint)));
     return result;
 }
 #endif
@@ -1512,6 +1519,250 @@ inline wil::unique_hfile truncate_existing_file(
 }
 
 #endif // WIL_ENABLE_EXCEPTIONS
+
+//! Whether a @ref mapped_file_t maps its file for reading only or for reading and writing.
+enum class mapped_file_access
+{
+    read_only,
+    read_write,
+};
+
+//! Access pattern hints for a @ref mapped_file_t, passed to `CreateFileW` when the file is opened.
+enum class mapped_file_options
+{
+    none = 0x0,
+    //! The file will be read front to back, so the cache manager reads ahead aggressively (`FILE_FLAG_SEQUENTIAL_SCAN`).
+    sequential_scan = 0x1,
+    //! The file will be read in no particular order, so read-ahead is limited (`FILE_FLAG_RANDOM_ACCESS`).
+    random_access = 0x2,
+};
+DEFINE_ENUM_FLAG_OPERATORS(mapped_file_options);
+
+/** A file mapped into memory, either whole or through a movable window.
+Bytes are read (or written) in place through the view, with no copy into a separate buffer. Mapping the whole file needs
+address space for all of it; on 32-bit processes, open the file with a window size and use map_window() to slide the
+window along a large file. Windows are aligned to the allocation granularity internally, so any offset can be requested.
+~~~
+wil::mapped_file file(L"C:\\data\\index.bin");
+auto header = file.view<index_header>();
+THROW_HR_IF(E_UNEXPECTED, !header || (header->magic != index_magic));
+file.prefetch(header->tableOffset, header->tableSize); // start paging in the table while the header is parsed
+~~~
+A zero-length file opens successfully with an empty view. */
+template <typename err_policy = err_exception_policy>
+class mapped_file_t
+{
+public:
+    //! HRESULT or void error handling...
+    typedef typename err_policy::result result;
+
+    mapped_file_t() WI_NOEXCEPT = default;
+
+    //! Exception-based constructor to open and map the file.
+    explicit mapped_file_t(
+        PCWSTR path,
+        mapped_file_access access = mapped_file_access::read_only,
+        mapped_file_options options = mapped_file_options::none,
+        size_t windowSize = 0)
+    {
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the open method");
+        open(path, access, options, windowSize);
+    }
+
+    mapped_file_t(const mapped_file_t&) = delete;
+    mapped_file_t& operator=(const mapped_file_t&) = delete;
+
+    /** Opens the file and maps it.
+    @param path The file to open; it is opened with `FILE_SHARE_READ`.
+    @param access Whether to map the file read-only or read-write. A read-write mapping cannot grow the file.
+    @param options Access pattern hints.
+    @param windowSize The number of bytes to map from the start of the file, or 0 to map the whole file. */
+    result open(
+        PCWSTR path,
+        mapped_file_access access = mapped_file_access::read_only,
+        mapped_file_options options = mapped_file_options::none,
+        size_t windowSize = 0)
+    {
+        return err_policy::HResult(open_nothrow(path, access, options, windowSize));
+    }
+
+    //! Unmaps the current window and maps `length` bytes starting at `offset`, clamped to the end of the file.
+    result map_window(ULONG64 offset, size_t length)
+    {
+        return err_policy::HResult(map_window_nothrow(offset, length));
+    }
+
+    //! Unmaps the file and closes it.
+    void reset() WI_NOEXCEPT
+    {
+        m_view.reset();
+        m_mapping.reset();
+        m_file.reset();
+        m_data = nullptr;
+        m_size = 0;
+        m_offset = 0;
+        m_fileSize = 0;
+    }
+
+    //! The bytes of the current window; null when the window is empty.
+    WI_NODISCARD const BYTE* data() const WI_NOEXCEPT
+    {
+        return m_data;
+    }
+
+    //! The bytes of the current window, for a file opened with mapped_file_access::read_write.
+    WI_NODISCARD BYTE* writable_data() WI_NOEXCEPT
+    {
+        __FAIL_FAST_ASSERT__(m_access == mapped_file_access::read_write);
+        return m_data;
+    }
+
+    //! The number of bytes in the current window.
+    WI_NODISCARD size_t size() const WI_NOEXCEPT
+    {
+        return m_size;
+    }
+
+    //! The file offset of the first byte of the current window.
+    WI_NODISCARD ULONG64 offset() const WI_NOEXCEPT
+    {
+        return m_offset;
+    }
+
+    //! The size of the file when it was opened.
+    WI_NODISCARD ULONG64 file_size() const WI_NOEXCEPT
+    {
+        return m_fileSize;
+    }
+
+    /** Returns `count` objects of type T at `byteOffset` within the current window, or null if they do not fit inside the
+    window or would be misaligned. T must be trivially copyable, since the bytes are used in place. */
+    template <typename T>
+    WI_NODISCARD const T* view(size_t byteOffset = 0, size_t count = 1) const WI_NOEXCEPT
+    {
+        static_assert(wistd::is_trivially_copyable<T>::value, "mapped file views require trivially copyable types");
+        if ((byteOffset > m_size) || (count > ((m_size - byteOffset) / sizeof(T))) ||
+            ((reinterpret_cast<ULONG_PTR>(m_data + byteOffset) % alignof(T)) != 0))
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<const T*>(m_data + byteOffset);
+    }
+
+#if (WIL_USE_STL && (__cpp_lib_span >= 202002L)) || defined(WIL_DOXYGEN)
+    //! The bytes of the current window as a span.
+    WI_NODISCARD std::span<const std::byte> bytes() const WI_NOEXCEPT
+    {
+        return {reinterpret_cast<const std::byte*>(m_data), m_size};
+    }
+
+    //! The bytes of the current window as a writable span, for a file opened with mapped_file_access::read_write.
+    WI_NODISCARD std::span<std::byte> writable_bytes() WI_NOEXCEPT
+    {
+        return {reinterpret_cast<std::byte*>(writable_data()), m_size};
+    }
+
+    //! Returns `count` objects of type T at `byteOffset` as a span, which is empty if @ref view would return null.
+    template <typename T>
+    WI_NODISCARD std::span<const T> view_span(size_t byteOffset, size_t count) const WI_NOEXCEPT
+    {
+        auto first = view<T>(byteOffset, count);
+        return first ? std::span<const T>(first, count) : std::span<const T>();
+    }
+#endif
+
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8) || defined(WIL_DOXYGEN)
+    /** Asks the memory manager to read part of the current window into memory ahead of use, with large, concurrent I/O
+    instead of one page fault at a time. The range is clamped to the window. This is only a hint; it does not lock the
+    pages in memory. */
+    result prefetch(size_t byteOffset = 0, size_t length = static_cast<size_t>(-1)) const
+    {
+        if (byteOffset >= m_size)
+        {
+            return err_policy::HResult(S_OK);
+        }
+        WIN32_MEMORY_RANGE_ENTRY range{m_data + byteOffset, ((m_size - byteOffset) < length) ? (m_size - byteOffset) : length};
+        return err_policy::LastErrorIfFalse(!!::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0));
+    }
+#endif
+
+private:
+    HRESULT open_nothrow(PCWSTR path, mapped_file_access access, mapped_file_options options, size_t windowSize) WI_NOEXCEPT
+    {
+        reset();
+        m_access = access;
+        const bool writable = (access == mapped_file_access::read_write);
+        DWORD flags = FILE_ATTRIBUTE_NORMAL;
+        WI_SetFlagIf(flags, FILE_FLAG_SEQUENTIAL_SCAN, WI_IsFlagSet(options, mapped_file_options::sequential_scan));
+        WI_SetFlagIf(flags, FILE_FLAG_RANDOM_ACCESS, WI_IsFlagSet(options, mapped_file_options::random_access));
+
+        const DWORD desiredAccess = writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ;
+        m_file.reset(::CreateFileW(path, desiredAccess, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr));
+        RETURN_LAST_ERROR_IF(!m_file);
+        LARGE_INTEGER fileSize{};
+        RETURN_IF_WIN32_BOOL_FALSE(::GetFileSizeEx(m_file.get(), &fileSize));
+        m_fileSize = static_cast<ULONG64>(fileSize.QuadPart);
+
+        // CreateFileMapping rejects empty files; an empty file simply has an empty view.
+        if (m_fileSize != 0)
+        {
+            const DWORD protection = writable ? PAGE_READWRITE : PAGE_READONLY;
+            m_mapping.reset(::CreateFileMappingW(m_file.get(), nullptr, protection, 0, 0, nullptr));
+            RETURN_LAST_ERROR_IF(!m_mapping);
+        }
+
+        if (windowSize == 0)
+        {
+            RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE), m_fileSize > static_cast<size_t>(-1));
+            windowSize = static_cast<size_t>(m_fileSize);
+        }
+        return map_window_nothrow(0, windowSize);
+    }
+
+    HRESULT map_window_nothrow(ULONG64 offset, size_t length) WI_NOEXCEPT
+    {
+        __FAIL_FAST_ASSERT__(m_file);
+        m_view.reset();
+        m_data = nullptr;
+        m_size = 0;
+        m_offset = (offset < m_fileSize) ? offset : m_fileSize;
+        length = ((m_fileSize - m_offset) < length) ? static_cast<size_t>(m_fileSize - m_offset) : length;
+        if (length == 0)
+        {
+            return S_OK;
+        }
+
+        // Views must start on an allocation granularity boundary; map from there and skip the extra bytes.
+        SYSTEM_INFO systemInfo{};
+        ::GetSystemInfo(&systemInfo);
+        const ULONG64 viewOffset = m_offset - (m_offset % systemInfo.dwAllocationGranularity);
+        const auto skip = static_cast<size_t>(m_offset - viewOffset);
+        RETURN_HR_IF(HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE), length > (static_cast<size_t>(-1) - skip));
+
+        const DWORD desiredAccess = (m_access == mapped_file_access::read_write) ? FILE_MAP_WRITE : FILE_MAP_READ;
+        m_view.reset(::MapViewOfFile(
+            m_mapping.get(), desiredAccess, static_cast<DWORD>(viewOffset >> 32), static_cast<DWORD>(viewOffset), skip + length));
+        RETURN_LAST_ERROR_IF(!m_view);
+        m_data = static_cast<BYTE*>(m_view.get()) + skip;
+        m_size = length;
+        return S_OK;
+    }
+
+    unique_hfile m_file;
+    unique_handle m_mapping;
+    unique_mapview_ptr<void> m_view;
+    BYTE* m_data = nullptr;
+    size_t m_size = 0;
+    ULONG64 m_offset = 0;
+    ULONG64 m_fileSize = 0;
+    mapped_file_access m_access = mapped_file_access::read_only;
+};
+
+typedef mapped_file_t<err_returncode_policy> mapped_file_nothrow;
+typedef mapped_file_t<err_failfast_policy> mapped_file_failfast;
+#ifdef WIL_ENABLE_EXCEPTIONS
+typedef mapped_file_t<err_exception_policy> mapped_file;
+#endif
 #endif // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN7)
 } // namespace wil
 
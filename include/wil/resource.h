@@ -127,6 +127,294 @@ public:
 #endif // WIL_KERNEL_MODE
 };
 
+#if defined(WIL_ENABLE_HANDLE_LIFETIME_PROFILING) || defined(WIL_DOXYGEN)
+//! Handles acquired at one code address, as reported in @ref handle_lifetime_statistics.
+struct handle_lifetime_site_statistics
+{
+    //! The code address that gave the handles to a unique_any_t, or null for the overflow entry.
+    const void* site;
+    ULONGLONG acquired;
+    ULONGLONG live;
+};
+
+/** Lifetime counts for one resource type, as reported by @ref for_each_handle_lifetime.
+Only present when `WIL_ENABLE_HANDLE_LIFETIME_PROFILING` is defined. That macro adds a member to every unique_any_t, so it
+must be defined consistently for every translation unit of a binary, and code that treats an array of wrappers as an array
+of raw handles does not work with it. The mutex and semaphore handles that result.h shares between modules are the
+exception; they are not profiled and keep their size. Counts are kept per resource policy (handle type and
+close function); wrappers that share a policy, such as `wil::unique_handle` and `wil::unique_event`, are reported together. */
+struct handle_lifetime_statistics
+{
+    //! The compiler's signature for the resource policy, which names the handle type and its close function.
+    PCSTR typeName;
+    //! Handles given to wrappers, and handles closed or released by them.
+    ULONGLONG acquired;
+    ULONGLONG closed;
+    //! Handles currently owned by wrappers, and the most that were ever owned at once.
+    ULONGLONG live;
+    ULONGLONG highWaterMark;
+    //! The first `siteCount` entries are valid.
+    handle_lifetime_site_statistics sites[33];
+    size_t siteCount;
+};
+
+/// @cond
+namespace details
+{
+    struct handle_lifetime_site
+    {
+        void* site;
+        LONG64 acquired;
+        LONG64 live;
+    };
+
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+    struct DECLSPEC_CACHEALIGN handle_lifetime_shard
+    {
+        LONG64 acquired;
+        LONG64 closed;
+    };
+
+    // One record per resource policy, created on first use and never destroyed. The cumulative counts are sharded by
+    // processor. The live count needs a single order for its high-water mark to mean anything, so it is one counter.
+    struct handle_lifetime_record
+    {
+        handle_lifetime_shard shards[16];
+        DECLSPEC_CACHEALIGN LONG64 live;
+        LONG64 highWaterMark;
+        handle_lifetime_site sites[32];
+        handle_lifetime_site overflowSite;
+        PCSTR typeName;
+        handle_lifetime_record* next;
+    };
+#pragma warning(pop)
+
+    inline handle_lifetime_record*& handle_lifetime_records() WI_NOEXCEPT
+    {
+        static handle_lifetime_record* s_first = nullptr;
+        return s_first;
+    }
+
+    inline handle_lifetime_record* register_handle_lifetime_record(handle_lifetime_record& record, PCSTR typeName) WI_NOEXCEPT
+    {
+        record.typeName = typeName;
+        auto& first = handle_lifetime_records();
+        for (;;)
+        {
+            const auto head = static_cast<handle_lifetime_record*>(ReadPointerAcquire(reinterpret_cast<void* const*>(&first)));
+            record.next = head;
+            if (InterlockedCompareExchangePointer(reinterpret_cast<void**>(&first), &record, head) == head)
+            {
+                return &record;
+            }
+        }
+    }
+
+    template <typename policy>
+    PCSTR handle_lifetime_type_name() WI_NOEXCEPT
+    {
+#if defined(__clang__) || defined(__GNUC__)
+        return __PRETTY_FUNCTION__;
+#else
+        return __FUNCSIG__;
+#endif
+    }
+
+    template <typename policy>
+    handle_lifetime_record& get_handle_lifetime_record() WI_NOEXCEPT
+    {
+        static handle_lifetime_record s_record{};
+        static handle_lifetime_record* const s_registered =
+            register_handle_lifetime_record(s_record, handle_lifetime_type_name<policy>());
+        return *s_registered;
+    }
+
+    inline handle_lifetime_site& find_handle_lifetime_site(handle_lifetime_record& record, void* site) WI_NOEXCEPT
+    {
+        const size_t siteCount = ARRAYSIZE(record.sites);
+        size_t index = (reinterpret_cast<ULONG_PTR>(site) >> 4) % siteCount;
+        for (size_t probe = 0; probe < siteCount; ++probe, index = (index + 1) % siteCount)
+        {
+            auto& entry = record.sites[index];
+            void* const claimed = InterlockedCompareExchangePointer(&entry.site, site, nullptr);
+            if ((claimed == nullptr) || (claimed == site))
+            {
+                return entry;
+            }
+        }
+        return record.overflowSite;
+    }
+
+    // Kept out of line so that _ReturnAddress() identifies the code that the (inlined) unique_storage member was
+    // expanded into, which is the code that handed over the handle.
+    __declspec(noinline) inline handle_lifetime_site* handle_lifetime_acquired(handle_lifetime_record& record) WI_NOEXCEPT
+    {
+        auto& site = find_handle_lifetime_site(record, _ReturnAddress());
+        InterlockedIncrement64(&site.acquired);
+        InterlockedIncrement64(&site.live);
+        InterlockedIncrement64(&record.shards[::GetCurrentProcessorNumber() % ARRAYSIZE(record.shards)].acquired);
+        const LONG64 live = InterlockedIncrement64(&record.live);
+        for (LONG64 currentMax = ReadNoFence64(&record.highWaterMark); live > currentMax;)
+        {
+            const LONG64 previous = InterlockedCompareExchange64(&record.highWaterMark, live, currentMax);
+            if (previous == currentMax)
+            {
+                break;
+            }
+            currentMax = previous;
+        }
+        return &site;
+    }
+
+    // 'wasValid' is false when a handle counted by put()/addressof() was never filled in; the acquisition is then undone.
+    inline void handle_lifetime_closed(handle_lifetime_record& record, handle_lifetime_site* site, bool wasValid) WI_NOEXCEPT
+    {
+        auto& shard = record.shards[::GetCurrentProcessorNumber() % ARRAYSIZE(record.shards)];
+        InterlockedDecrement64(&site->live);
+        InterlockedDecrement64(&record.live);
+        if (wasValid)
+        {
+            InterlockedIncrement64(&shard.closed);
+        }
+        else
+        {
+            InterlockedDecrement64(&site->acquired);
+            InterlockedDecrement64(&shard.acquired);
+        }
+    }
+
+    inline void read_handle_lifetime_statistics(
+        const handle_lifetime_record& record, handle_lifetime_statistics& statistics) WI_NOEXCEPT
+    {
+        statistics = {};
+        statistics.typeName = record.typeName;
+        for (const auto& shard : record.shards)
+        {
+            statistics.acquired += static_cast<ULONGLONG>(ReadNoFence64(&shard.acquired));
+            statistics.closed += static_cast<ULONGLONG>(ReadNoFence64(&shard.closed));
+        }
+        statistics.live = static_cast<ULONGLONG>(ReadNoFence64(&record.live));
+        statistics.highWaterMark = static_cast<ULONGLONG>(ReadNoFence64(&record.highWaterMark));
+
+        auto addSite = [&](const handle_lifetime_site& site) {
+            const LONG64 acquired = ReadNoFence64(&site.acquired);
+            if (acquired != 0)
+            {
+                auto& entry = statistics.sites[statistics.siteCount++];
+                entry.site = ReadPointerNoFence(&site.site);
+                entry.acquired = static_cast<ULONGLONG>(acquired);
+                entry.live = static_cast<ULONGLONG>(ReadNoFence64(&site.live));
+            }
+        };
+        for (const auto& site : record.sites)
+        {
+            addSite(site);
+        }
+        addSite(record.overflowSite);
+    }
+
+    // Policies whose handles are shared between modules specialize this to false; see cross_module_handle_resource_policy.
+    template <typename policy>
+    struct handle_lifetime_profiled : wistd::true_type
+    {
+    };
+
+    // The base of unique_storage that remembers where its handle was acquired. It is empty for policies that opt out, so
+    // those wrappers keep the size of their handle.
+    template <typename policy, bool = handle_lifetime_profiled<policy>::value>
+    class handle_lifetime_tracker
+    {
+    protected:
+        __forceinline void profile_acquired(bool isValid) WI_NOEXCEPT
+        {
+            if (isValid)
+            {
+                m_profileSite = handle_lifetime_acquired(get_handle_lifetime_record<policy>());
+            }
+        }
+
+        __forceinline void profile_address_taken() WI_NOEXCEPT
+        {
+            if (m_profileSite == nullptr)
+            {
+                m_profileSite = handle_lifetime_acquired(get_handle_lifetime_record<policy>());
+            }
+        }
+
+        void profile_closed(bool wasValid) WI_NOEXCEPT
+        {
+            if (m_profileSite != nullptr)
+            {
+                handle_lifetime_closed(get_handle_lifetime_record<policy>(), wistd::exchange(m_profileSite, nullptr), wasValid);
+            }
+        }
+
+        void profile_transfer(handle_lifetime_tracker& other) WI_NOEXCEPT
+        {
+            m_profileSite = wistd::exchange(other.m_profileSite, nullptr);
+        }
+
+    private:
+        handle_lifetime_site* m_profileSite = nullptr;
+    };
+
+    template <typename policy>
+    class handle_lifetime_tracker<policy, false>
+    {
+    protected:
+        void profile_acquired(bool) WI_NOEXCEPT
+        {
+        }
+
+        void profile_address_taken() WI_NOEXCEPT
+        {
+        }
+
+        void profile_closed(bool) WI_NOEXCEPT
+        {
+        }
+
+        void profile_transfer(handle_lifetime_tracker&) WI_NOEXCEPT
+        {
+        }
+    };
+} // namespace details
+/// @endcond
+
+/** Calls 'callback' with a snapshot of every resource type whose wrappers have held a handle.
+Requires `WIL_ENABLE_HANDLE_LIFETIME_PROFILING`. With it defined, every unique_any_t counts the handles it is given and closes,
+along with the code address that gave it each handle; without it none of this code exists and the wrappers keep their
+usual size. Handles passed to put() or addressof() are counted from that call, so they appear live while the function
+filling them runs. Sites are only meaningful in builds that inline the wrappers' members.
+~~~~
+wil::for_each_handle_lifetime([](const wil::handle_lifetime_statistics& statistics) {
+    printf("%s: %llu live, %llu peak\n", statistics.typeName, statistics.live, statistics.highWaterMark);
+});
+~~~~ */
+template <typename TCallback>
+void for_each_handle_lifetime(TCallback&& callback)
+{
+    auto record = static_cast<details::handle_lifetime_record*>(
+        ReadPointerAcquire(reinterpret_cast<void* const*>(&details::handle_lifetime_records())));
+    for (; record != nullptr; record = record->next)
+    {
+        handle_lifetime_statistics statistics;
+        details::read_handle_lifetime_statistics(*record, statistics);
+        callback(statistics);
+    }
+}
+
+//! Returns a snapshot of the counts for one wrapper type, such as `wil::unique_handle`. See @ref for_each_handle_lifetime.
+template <typename unique_t>
+handle_lifetime_statistics get_handle_lifetime_statistics() WI_NOEXCEPT
+{
+    handle_lifetime_statistics statistics;
+    details::read_handle_lifetime_statistics(details::get_handle_lifetime_record<typename unique_t::policy>(), statistics);
+    return statistics;
+}
+#endif // WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+
 /// @cond
 namespace details
 {
@@ -200,6 +488,9 @@ namespace details
 
     template <typename Policy>
     class unique_storage
+#ifdef WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+        : private handle_lifetime_tracker<Policy>
+#endif
     {
     protected:
         typedef Policy policy;
@@ -214,11 +505,17 @@ namespace details
 
         explicit unique_storage(pointer_storage ptr) WI_NOEXCEPT : m_ptr(ptr)
         {
+#ifdef WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+            this->profile_acquired(policy::is_valid(m_ptr));
+#endif
         }
 
         unique_storage(unique_storage&& other) WI_NOEXCEPT : m_ptr(wistd::move(other.m_ptr))
         {
             other.m_ptr = policy::invalid_value();
+#ifdef WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+            this->profile_transfer(other);
+#endif
         }
 
         ~unique_storage() WI_NOEXCEPT
@@ -227,6 +524,9 @@ namespace details
             {
                 policy::close(m_ptr);
             }
+#ifdef WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+            this->profile_closed(policy::is_valid(m_ptr));
+#endif
         }
 
         WI_NODISCARD bool is_valid() const WI_NOEXCEPT
@@ -240,7 +540,13 @@ namespace details
             {
                 policy::close_reset(m_ptr);
             }
+#ifdef WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+            this->profile_closed(policy::is_valid(m_ptr));
+            m_ptr = ptr;
+            this->profile_acquired(policy::is_valid(m_ptr));
+#else
             m_ptr = ptr;
+#endif
         }
 
         void reset(wistd::nullptr_t) WI_NOEXCEPT
@@ -261,6 +567,9 @@ namespace details
             static_assert(
                 !wistd::is_same<typename policy::pointer_access, pointer_access_none>::value,
                 "release(): the raw handle value is not available for this resource class");
+#ifdef WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+            this->profile_closed(policy::is_valid(m_ptr));
+#endif
             auto ptr = m_ptr;
             m_ptr = policy::invalid_value();
             return ptr;
@@ -271,13 +580,23 @@ namespace details
             static_assert(
                 wistd::is_same<typename policy::pointer_access, pointer_access_all>::value,
                 "addressof(): the address of the raw handle is not available for this resource class");
+#ifdef WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+            this->profile_address_taken();
+#endif
             return &m_ptr;
         }
 
     protected:
         void replace(unique_storage&& other) WI_NOEXCEPT
         {
+#ifdef WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+            // The handle changes owners, not lifetime, so its acquisition moves along with it.
+            reset();
+            this->profile_transfer(other);
+            m_ptr = other.m_ptr;
+#else
             reset(other.m_ptr);
+#endif
             other.m_ptr = policy::invalid_value();
         }
 
@@ -1915,7 +2234,8 @@ namespace details
     struct string_maker;
 
     // Concatenate any number of strings together and store it in an automatically allocated string.  If a string is present
-    // in the input buffer, it is overwritten.
+    // in the input buffer, it is overwritten.  The lengths are summed once and each piece is then copied with a single
+    // bulk copy into the exactly sized allocation, so a piece's embedded nulls are copied rather than ending the piece.
     template <typename string_type>
     HRESULT str_build_nothrow_(string_type& result, _In_reads_(strCount) string_view_t const* strList, size_t strCount)
     {
@@ -1929,15 +2249,15 @@ namespace details
         RETURN_IF_FAILED(maker.make(nullptr, lengthRequiredWithoutNull));
 
         auto buffer = maker.buffer();
-        auto bufferEnd = buffer + lengthRequiredWithoutNull + 1;
         for (auto& string : make_range(strList, strCount))
         {
-            if (string.data)
+            if (string.length != 0)
             {
-                RETURN_IF_FAILED(StringCchCopyNExW(
-                    buffer, (bufferEnd - buffer), string.data, string.length, &buffer, nullptr, STRSAFE_IGNORE_NULLS));
+                memcpy(buffer, string.data, string.length * sizeof(*buffer));
+                buffer += string.length;
             }
         }
+        *buffer = L'\0';
 
         result = maker.release();
         return S_OK;
@@ -1949,17 +2269,35 @@ namespace details
         string_view_t localStrings[] = {strings...};
         return str_build_nothrow_<string_type>(result, localStrings, ARRAYSIZE(localStrings));
     }
+
+    // Appends in place when the string_maker can grow an existing string (for example std::wstring, whose capacity grows
+    // geometrically).
+    template <typename string_type, typename... Strings>
+    auto str_concat_nothrow_(string_type& result, priority_tag<1>, Strings... strings)
+        -> decltype(string_maker<string_type>::append(result, static_cast<string_view_t const*>(nullptr), size_t{}))
+    {
+        string_view_t localStrings[] = {strings...};
+        return string_maker<string_type>::append(result, localStrings, ARRAYSIZE(localStrings));
+    }
+
+    // Otherwise builds a new string holding the current content followed by the given strings.
+    template <typename string_type, typename... Strings>
+    HRESULT str_concat_nothrow_(string_type& result, priority_tag<0>, Strings... strings)
+    {
+        return str_build_nothrow(result, view_from_string(string_maker<string_type>::get(result)), strings...);
+    }
 } // namespace details
 /// @endcond
 
 // Concatenate any number of strings together and store it in an automatically allocated string.  If a string is present
-// in the input buffer, the remaining strings are appended to it.
+// in the input buffer, the remaining strings are appended to it.  Strings with an explicit length (std::wstring,
+// std::wstring_view, HSTRING, ...) are copied in full, including any embedded null characters; earlier versions stopped
+// copying a string at its first null.
 template <typename string_type, typename... strings>
 HRESULT str_concat_nothrow(string_type& buffer, const strings&... str)
 {
     static_assert(sizeof...(str) > 0, "attempting to concatenate no strings");
-    return details::str_build_nothrow(
-        buffer, details::view_from_string(details::string_maker<string_type>::get(buffer)), details::view_from_string(str)...);
+    return details::str_concat_nothrow_(buffer, details::priority_tag<1>{}, details::view_from_string(str)...);
 }
 #endif // !defined(__WIL_MIN_KERNEL) && !defined(WIL_KERNEL_MODE)
 
@@ -2189,98 +2527,420 @@ namespace details
     private:
         template <typename storage_t>
         friend class ::wil::weak_any;
+        typedef std::weak_ptr<unique_t> weak_storage;
 
         std::shared_ptr<unique_t> m_ptr;
     };
-} // namespace details
-/// @endcond
 
-// This class when paired with shared_storage and an optional type-specific specialization class implements
-// the same interface as STL's shared_ptr<> for resource handle types.  It is both copyable and movable, supporting
-// weak references and automatic closure of the handle upon release of the last shared_any.
+    // The single allocation behind compact_shared_storage: the unique_t and an intrusive reference count.  Blocks that
+    // support weak references also carry a weak count (weak_any references plus one while any strong reference
+    // remains); the resource is closed when the strong count reaches zero and the block freed with the weak count.
+    template <typename UniqueT, bool supportsWeak>
+    struct compact_shared_block
+    {
+        static constexpr bool supports_weak = false;
 
-template <typename storage_t>
-class shared_any_t : public storage_t
-{
-public:
-    typedef typename storage_t::policy policy;
-    typedef typename policy::pointer_storage pointer_storage;
-    typedef typename policy::pointer pointer;
-    typedef typename storage_t::unique_t unique_t;
+        template <typename... args_t>
+        explicit compact_shared_block(args_t&&... args) : resource(wistd::forward<args_t>(args)...)
+        {
+        }
 
-    // default and forwarding constructor: forwards default, all 'explicit' and multi-arg constructors to the base class
-    template <typename... args_t>
-    explicit shared_any_t(args_t&&... args) __WI_NOEXCEPT_((wistd::is_nothrow_constructible_v<storage_t, args_t...>)) :
-        storage_t(wistd::forward<args_t>(args)...)
-    {
-    }
+        void add_ref() WI_NOEXCEPT
+        {
+            ::InterlockedIncrementNoFence(&strongCount);
+        }
 
-    shared_any_t(wistd::nullptr_t) WI_NOEXCEPT
-    {
-        static_assert(
-            wistd::is_same<typename policy::pointer_invalid, wistd::nullptr_t>::value,
-            "nullptr constructor: valid only for handle types using nullptr as the invalid value");
-    }
+        void release() WI_NOEXCEPT
+        {
+            if (::InterlockedDecrement(&strongCount) == 0)
+            {
+                delete this;
+            }
+        }
 
-    shared_any_t(shared_any_t&& other) WI_NOEXCEPT : storage_t(wistd::move(other))
-    {
-    }
+        UniqueT resource;
+        long volatile strongCount = 1;
+    };
 
-    shared_any_t(const shared_any_t& other) WI_NOEXCEPT : storage_t(other)
+    template <typename UniqueT>
+    struct compact_shared_block<UniqueT, true>
     {
-    }
+        static constexpr bool supports_weak = true;
 
-    shared_any_t& operator=(shared_any_t&& other) WI_NOEXCEPT
-    {
-        if (this != wistd::addressof(other))
+        template <typename... args_t>
+        explicit compact_shared_block(args_t&&... args) : resource(wistd::forward<args_t>(args)...)
         {
-            storage_t::replace(wistd::move(static_cast<typename storage_t::base_storage&>(other)));
         }
-        return (*this);
-    }
 
-    shared_any_t& operator=(const shared_any_t& other) WI_NOEXCEPT
-    {
-        storage_t::operator=(other);
-        return (*this);
-    }
+        void add_ref() WI_NOEXCEPT
+        {
+            ::InterlockedIncrementNoFence(&strongCount);
+        }
 
-    shared_any_t(unique_t&& other) : storage_t(wistd::move(other))
-    {
-    }
+        void release() WI_NOEXCEPT
+        {
+            if (::InterlockedDecrement(&strongCount) == 0)
+            {
+                resource.reset();
+                release_weak();
+            }
+        }
 
-    shared_any_t& operator=(unique_t&& other)
-    {
-        storage_t::reset(wistd::move(other));
-        return (*this);
-    }
+        // Takes a strong reference unless the resource has already been closed
+        bool try_add_ref() WI_NOEXCEPT
+        {
+            long count = strongCount;
+            while (count != 0)
+            {
+                auto const previous = ::InterlockedCompareExchange(&strongCount, count + 1, count);
+                if (previous == count)
+                {
+                    return true;
+                }
+                count = previous;
+            }
+            return false;
+        }
 
-    shared_any_t& operator=(wistd::nullptr_t) WI_NOEXCEPT
-    {
-        static_assert(
-            wistd::is_same<typename policy::pointer_invalid, wistd::nullptr_t>::value,
-            "nullptr assignment: valid only for handle types using nullptr as the invalid value");
-        storage_t::reset();
-        return (*this);
-    }
+        WI_NODISCARD bool expired() const WI_NOEXCEPT
+        {
+            return strongCount == 0;
+        }
 
-    void swap(shared_any_t& other) WI_NOEXCEPT
-    {
-        shared_any_t self(wistd::move(*this));
-        operator=(wistd::move(other));
-        other = wistd::move(self);
-    }
+        void add_weak_ref() WI_NOEXCEPT
+        {
+            ::InterlockedIncrementNoFence(&weakCount);
+        }
 
-    WI_NODISCARD explicit operator bool() const WI_NOEXCEPT
+        void release_weak() WI_NOEXCEPT
+        {
+            if (::InterlockedDecrement(&weakCount) == 0)
+            {
+                delete this;
+            }
+        }
+
+        UniqueT resource;
+        long volatile strongCount = 1;
+        long volatile weakCount = 1;
+    };
+
+    // A strong reference handed from compact_weak_storage::lock() to the compact_shared_storage that adopts it
+    template <typename block_t>
+    struct compact_shared_ref
     {
-        return storage_t::is_valid();
-    }
+        block_t* block;
+    };
 
-    pointer_storage* put()
+    // The weak reference held by weak_any for a compact_shared_storage declared with weak reference support
+    template <typename block_t>
+    class compact_weak_storage
     {
-        static_assert(
-            wistd::is_same<typename policy::pointer_access, details::pointer_access_all>::value,
-            "operator & is not available for this handle");
+        static_assert(block_t::supports_weak, "weak_any requires a compact_shared_any declared with weak reference support");
+
+    public:
+        compact_weak_storage() = default;
+
+        compact_weak_storage(block_t* block) WI_NOEXCEPT : m_block(block)
+        {
+            if (m_block)
+            {
+                m_block->add_weak_ref();
+            }
+        }
+
+        compact_weak_storage(compact_weak_storage const& other) WI_NOEXCEPT : compact_weak_storage(other.m_block)
+        {
+        }
+
+        compact_weak_storage(compact_weak_storage&& other) WI_NOEXCEPT : m_block(other.m_block)
+        {
+            other.m_block = nullptr;
+        }
+
+        ~compact_weak_storage() WI_NOEXCEPT
+        {
+            reset();
+        }
+
+        compact_weak_storage& operator=(compact_weak_storage const& other) WI_NOEXCEPT
+        {
+            compact_weak_storage(other).swap(*this);
+            return *this;
+        }
+
+        compact_weak_storage& operator=(compact_weak_storage&& other) WI_NOEXCEPT
+        {
+            compact_weak_storage(wistd::move(other)).swap(*this);
+            return *this;
+        }
+
+        compact_weak_storage& operator=(block_t* block) WI_NOEXCEPT
+        {
+            compact_weak_storage(block).swap(*this);
+            return *this;
+        }
+
+        void reset() WI_NOEXCEPT
+        {
+            if (m_block)
+            {
+                wistd::exchange(m_block, nullptr)->release_weak();
+            }
+        }
+
+        void swap(compact_weak_storage& other) WI_NOEXCEPT
+        {
+            wistd::swap_wil(m_block, other.m_block);
+        }
+
+        WI_NODISCARD bool expired() const WI_NOEXCEPT
+        {
+            return !m_block || m_block->expired();
+        }
+
+        WI_NODISCARD compact_shared_ref<block_t> lock() const WI_NOEXCEPT
+        {
+            return {(m_block && m_block->try_add_ref()) ? m_block : nullptr};
+        }
+
+    private:
+        block_t* m_block = nullptr;
+    };
+
+    // Pointer storage for shared_any_t that, unlike shared_storage, keeps a single pointer to one allocation holding
+    // both the unique_t and its reference count (see compact_shared_block).  Weak references cost an extra count in
+    // the allocation and are only available when supportsWeak is true.
+    template <typename UniqueT, bool supportsWeak = false>
+    class compact_shared_storage
+    {
+    protected:
+        typedef UniqueT unique_t;
+        typedef typename unique_t::policy policy;
+        typedef typename policy::pointer_storage pointer_storage;
+        typedef typename policy::pointer pointer;
+        typedef compact_shared_storage<unique_t, supportsWeak> base_storage;
+        typedef compact_shared_block<unique_t, supportsWeak> block_t;
+
+    public:
+        compact_shared_storage() = default;
+
+        explicit compact_shared_storage(pointer_storage ptr)
+        {
+            reset(ptr);
+        }
+
+        compact_shared_storage(unique_t&& other)
+        {
+            if (other)
+            {
+                m_ptr = new block_t(wistd::move(other));
+            }
+        }
+
+        explicit compact_shared_storage(compact_shared_ref<block_t> adopted) WI_NOEXCEPT : m_ptr(adopted.block)
+        {
+        }
+
+        compact_shared_storage(compact_shared_storage const& other) WI_NOEXCEPT : m_ptr(other.m_ptr)
+        {
+            if (m_ptr)
+            {
+                m_ptr->add_ref();
+            }
+        }
+
+        compact_shared_storage(compact_shared_storage&& other) WI_NOEXCEPT : m_ptr(other.m_ptr)
+        {
+            other.m_ptr = nullptr;
+        }
+
+        ~compact_shared_storage() WI_NOEXCEPT
+        {
+            if (m_ptr)
+            {
+                m_ptr->release();
+            }
+        }
+
+        compact_shared_storage& operator=(compact_shared_storage const& other) WI_NOEXCEPT
+        {
+            if (other.m_ptr)
+            {
+                other.m_ptr->add_ref();
+            }
+            attach(other.m_ptr);
+            return *this;
+        }
+
+        WI_NODISCARD bool is_valid() const WI_NOEXCEPT
+        {
+            return (m_ptr && m_ptr->resource.is_valid());
+        }
+
+        void reset(pointer_storage ptr = policy::invalid_value())
+        {
+            if (policy::is_valid(ptr))
+            {
+                unique_t resource(ptr); // closes the handle should the allocation throw
+                attach(new block_t(wistd::move(resource)));
+            }
+            else
+            {
+                attach(nullptr);
+            }
+        }
+
+        void reset(unique_t&& other)
+        {
+            attach(new block_t(wistd::move(other)));
+        }
+
+        void reset(wistd::nullptr_t) WI_NOEXCEPT
+        {
+            static_assert(
+                wistd::is_same<typename policy::pointer_invalid, wistd::nullptr_t>::value,
+                "reset(nullptr): valid only for handle types using nullptr as the invalid value");
+            reset();
+        }
+
+        template <
+            typename allow_t = typename policy::pointer_access,
+            typename wistd::enable_if<!wistd::is_same<allow_t, details::pointer_access_none>::value, int>::type = 0>
+        WI_NODISCARD pointer get() const WI_NOEXCEPT
+        {
+            return (m_ptr ? m_ptr->resource.get() : policy::invalid_value());
+        }
+
+        template <
+            typename allow_t = typename policy::pointer_access,
+            typename wistd::enable_if<wistd::is_same<allow_t, details::pointer_access_all>::value, int>::type = 0>
+        pointer_storage* addressof()
+        {
+            if (!m_ptr)
+            {
+                m_ptr = new block_t();
+            }
+            return m_ptr->resource.addressof();
+        }
+
+        WI_NODISCARD long int use_count() const WI_NOEXCEPT
+        {
+            return m_ptr ? m_ptr->strongCount : 0;
+        }
+
+    protected:
+        void replace(compact_shared_storage&& other) WI_NOEXCEPT
+        {
+            attach(wistd::exchange(other.m_ptr, nullptr));
+        }
+
+    private:
+        template <typename storage_t>
+        friend class ::wil::weak_any;
+        typedef compact_weak_storage<block_t> weak_storage;
+
+        // Takes ownership of one reference on 'block' and releases the previously held block
+        void attach(block_t* block) WI_NOEXCEPT
+        {
+            auto const previous = wistd::exchange(m_ptr, block);
+            if (previous)
+            {
+                previous->release();
+            }
+        }
+
+        block_t* m_ptr = nullptr;
+    };
+} // namespace details
+/// @endcond
+
+// This class when paired with shared_storage and an optional type-specific specialization class implements
+// the same interface as STL's shared_ptr<> for resource handle types.  It is both copyable and movable, supporting
+// weak references and automatic closure of the handle upon release of the last shared_any.
+
+template <typename storage_t>
+class shared_any_t : public storage_t
+{
+public:
+    typedef typename storage_t::policy policy;
+    typedef typename policy::pointer_storage pointer_storage;
+    typedef typename policy::pointer pointer;
+    typedef typename storage_t::unique_t unique_t;
+
+    // default and forwarding constructor: forwards default, all 'explicit' and multi-arg constructors to the base class
+    template <typename... args_t>
+    explicit shared_any_t(args_t&&... args) __WI_NOEXCEPT_((wistd::is_nothrow_constructible_v<storage_t, args_t...>)) :
+        storage_t(wistd::forward<args_t>(args)...)
+    {
+    }
+
+    shared_any_t(wistd::nullptr_t) WI_NOEXCEPT
+    {
+        static_assert(
+            wistd::is_same<typename policy::pointer_invalid, wistd::nullptr_t>::value,
+            "nullptr constructor: valid only for handle types using nullptr as the invalid value");
+    }
+
+    shared_any_t(shared_any_t&& other) WI_NOEXCEPT : storage_t(wistd::move(other))
+    {
+    }
+
+    shared_any_t(const shared_any_t& other) WI_NOEXCEPT : storage_t(other)
+    {
+    }
+
+    shared_any_t& operator=(shared_any_t&& other) WI_NOEXCEPT
+    {
+        if (this != wistd::addressof(other))
+        {
+            storage_t::replace(wistd::move(static_cast<typename storage_t::base_storage&>(other)));
+        }
+        return (*this);
+    }
+
+    shared_any_t& operator=(const shared_any_t& other) WI_NOEXCEPT
+    {
+        storage_t::operator=(other);
+        return (*this);
+    }
+
+    shared_any_t(unique_t&& other) : storage_t(wistd::move(other))
+    {
+    }
+
+    shared_any_t& operator=(unique_t&& other)
+    {
+        storage_t::reset(wistd::move(other));
+        return (*this);
+    }
+
+    shared_any_t& operator=(wistd::nullptr_t) WI_NOEXCEPT
+    {
+        static_assert(
+            wistd::is_same<typename policy::pointer_invalid, wistd::nullptr_t>::value,
+            "nullptr assignment: valid only for handle types using nullptr as the invalid value");
+        storage_t::reset();
+        return (*this);
+    }
+
+    void swap(shared_any_t& other) WI_NOEXCEPT
+    {
+        shared_any_t self(wistd::move(*this));
+        operator=(wistd::move(other));
+        other = wistd::move(self);
+    }
+
+    WI_NODISCARD explicit operator bool() const WI_NOEXCEPT
+    {
+        return storage_t::is_valid();
+    }
+
+    pointer_storage* put()
+    {
+        static_assert(
+            wistd::is_same<typename policy::pointer_access, details::pointer_access_all>::value,
+            "operator & is not available for this handle");
         storage_t::reset();
         return storage_t::addressof();
     }
@@ -2425,7 +3085,7 @@ public:
     }
 
 private:
-    std::weak_ptr<typename shared_t::unique_t> m_weakPtr;
+    typename shared_t::weak_storage m_weakPtr;
 };
 
 template <typename shared_t>
@@ -2437,6 +3097,12 @@ void swap(weak_any<shared_t>& left, weak_any<shared_t>& right) WI_NOEXCEPT
 template <typename unique_t>
 using shared_any = shared_any_t<details::shared_storage<unique_t>>;
 
+// A shared_any whose object is a single pointer to one allocation holding the resource and an intrusive reference
+// count, instead of a std::shared_ptr (two pointers and a separate control block).  Pass supportsWeak = true to
+// enable weak_any for the type, at the cost of a second count in the allocation.
+template <typename unique_t, bool supportsWeak = false>
+using compact_shared_any = shared_any_t<details::compact_shared_storage<unique_t, supportsWeak>>;
+
 } // namespace wil
 #endif
 
@@ -2698,6 +3364,20 @@ namespace details
         }
     };
 
+    // CloseThreadpoolCleanupGroupMembers always waits for running callbacks, so there is no NoWait form.
+    template <PendingCallbackCancellationBehavior cancellationBehavior>
+    struct DestroyThreadPoolCleanupGroup
+    {
+        static_assert(cancellationBehavior != PendingCallbackCancellationBehavior::NoWait, "cleanup groups always wait");
+
+        static void Destroy(_In_ PTP_CLEANUP_GROUP cleanupGroup) WI_NOEXCEPT
+        {
+            ::CloseThreadpoolCleanupGroupMembers(
+                cleanupGroup, (cancellationBehavior == PendingCallbackCancellationBehavior::Cancel), nullptr);
+            ::CloseThreadpoolCleanupGroup(cleanupGroup);
+        }
+    };
+
     template <typename close_fn_t, close_fn_t close_fn>
     struct handle_invalid_resource_policy
         : resource_policy<HANDLE, close_fn_t, close_fn, details::pointer_access_all, HANDLE, INT_PTR, -1, HANDLE>
@@ -2727,12 +3407,27 @@ namespace details
     };
 
     typedef resource_policy<HANDLE, decltype(&details::CloseHandle), details::CloseHandle, details::pointer_access_all> handle_resource_policy;
-} // namespace details
-/// @endcond
 
-template <typename close_fn_t, close_fn_t close_fn>
-using unique_any_handle_invalid =
-    unique_any_t<details::unique_storage<details::handle_invalid_resource_policy<close_fn_t, close_fn>>>;
+    // result.h keeps mutex and semaphore wrappers in memory that every module in the process uses. They must stay the size
+    // of a HANDLE and must not point into one module's profiling records, so they are never profiled.
+#ifdef WIL_ENABLE_HANDLE_LIFETIME_PROFILING
+    struct cross_module_handle_resource_policy : handle_resource_policy
+    {
+    };
+
+    template <>
+    struct handle_lifetime_profiled<cross_module_handle_resource_policy> : wistd::false_type
+    {
+    };
+#else
+    typedef handle_resource_policy cross_module_handle_resource_policy;
+#endif
+} // namespace details
+/// @endcond
+
+template <typename close_fn_t, close_fn_t close_fn>
+using unique_any_handle_invalid =
+    unique_any_t<details::unique_storage<details::handle_invalid_resource_policy<close_fn_t, close_fn>>>;
 
 template <typename close_fn_t, close_fn_t close_fn>
 using unique_any_handle_null = unique_any_t<details::unique_storage<details::handle_null_resource_policy<close_fn_t, close_fn>>>;
@@ -2789,6 +3484,11 @@ typedef unique_any<PTP_TIMER, void (*)(PTP_TIMER), details::DestroyThreadPoolTim
 typedef unique_any<PTP_IO, void (*)(PTP_IO), details::DestroyThreadPoolIo<details::PendingCallbackCancellationBehavior::Cancel>::Destroy> unique_threadpool_io;
 typedef unique_any<PTP_IO, void (*)(PTP_IO), details::DestroyThreadPoolIo<details::PendingCallbackCancellationBehavior::Wait>::Destroy> unique_threadpool_io_nocancel;
 typedef unique_any<PTP_IO, void (*)(PTP_IO), details::DestroyThreadPoolIo<details::PendingCallbackCancellationBehavior::NoWait>::Destroy> unique_threadpool_io_nowait;
+typedef unique_any<PTP_POOL, decltype(&::CloseThreadpool), ::CloseThreadpool> unique_threadpool_pool;
+typedef unique_any<PTP_CLEANUP_GROUP, void (*)(PTP_CLEANUP_GROUP), details::DestroyThreadPoolCleanupGroup<details::PendingCallbackCancellationBehavior::Cancel>::Destroy>
+    unique_threadpool_cleanup_group;
+typedef unique_any<PTP_CLEANUP_GROUP, void (*)(PTP_CLEANUP_GROUP), details::DestroyThreadPoolCleanupGroup<details::PendingCallbackCancellationBehavior::Wait>::Destroy>
+    unique_threadpool_cleanup_group_nocancel;
 
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 typedef unique_any_handle_invalid<decltype(&::FindCloseChangeNotification), ::FindCloseChangeNotification> unique_hfind_change;
@@ -3367,6 +4067,228 @@ typedef unique_any_t<event_t<details::unique_storage<details::handle_resource_po
 typedef unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_exception_policy>> unique_event;
 #endif
 
+/** A lock-free pool of unnamed event handles, for code that creates and destroys events at a high rate.
+Events handed back to the pool are reset and kept on a free list (one for auto-reset and one for manual-reset events) up to
+`highWaterMark` in total; beyond that they are closed. Acquiring an idle event skips `CreateEventExW`, and returning one
+skips `CloseHandle`. Use it through @ref pooled_event_t. The pool must outlive every event acquired from it.
+
+A returned event must no longer be in use: nothing may wait on it, signal it, or keep a duplicate of its handle, since the
+next owner receives the same kernel object.
+@code
+wil::event_pool pool;
+wil::pooled_event_nothrow done;
+RETURN_IF_FAILED(done.create(pool, wil::EventOptions::ManualReset));
+@endcode
+*/
+class event_pool
+{
+public:
+    static constexpr size_t default_high_water_mark = 64;
+
+    explicit event_pool(size_t highWaterMark = default_high_water_mark) WI_NOEXCEPT
+        : m_entries(make_unique_nothrow<entry[]>(highWaterMark))
+    {
+        ::InitializeSListHead(&m_spare);
+        ::InitializeSListHead(&m_idle[0]);
+        ::InitializeSListHead(&m_idle[1]);
+
+        // Without entries the pool still works, it just never retains an event.
+        if (m_entries)
+        {
+            for (auto& item : make_range(m_entries.get(), highWaterMark))
+            {
+                ::InterlockedPushEntrySList(&m_spare, &item.link);
+            }
+        }
+    }
+
+    ~event_pool() WI_NOEXCEPT
+    {
+        for (auto& idle : m_idle)
+        {
+            while (auto link = ::InterlockedPopEntrySList(&idle))
+            {
+                ::CloseHandle(CONTAINING_RECORD(link, entry, link)->event);
+            }
+        }
+    }
+
+    event_pool(const event_pool&) = delete;
+    event_pool& operator=(const event_pool&) = delete;
+
+    //! Returns an idle event of the requested kind, or a new one; nullptr on failure (see `GetLastError()`).
+    HANDLE acquire(EventOptions options) WI_NOEXCEPT
+    {
+        const bool manualReset = WI_IsFlagSet(options, EventOptions::ManualReset);
+        if (auto link = ::InterlockedPopEntrySList(&m_idle[manualReset]))
+        {
+            const auto event = CONTAINING_RECORD(link, entry, link)->event;
+            ::InterlockedPushEntrySList(&m_spare, link);
+            if (WI_IsFlagSet(options, EventOptions::Signaled))
+            {
+                details::SetEvent(event);
+            }
+            return event;
+        }
+
+        const DWORD flags = (manualReset ? CREATE_EVENT_MANUAL_RESET : 0) |
+                            (WI_IsFlagSet(options, EventOptions::Signaled) ? CREATE_EVENT_INITIAL_SET : 0);
+        return ::CreateEventExW(nullptr, nullptr, flags, EVENT_ALL_ACCESS);
+    }
+
+    //! Resets an event from acquire() and keeps it for reuse, or closes it when the pool is at its high-water mark.
+    void release(HANDLE event, bool manualReset) WI_NOEXCEPT
+    {
+        if (auto link = ::InterlockedPopEntrySList(&m_spare))
+        {
+            details::ResetEvent(event);
+            CONTAINING_RECORD(link, entry, link)->event = event;
+            ::InterlockedPushEntrySList(&m_idle[manualReset], link);
+        }
+        else
+        {
+            ::CloseHandle(event);
+        }
+    }
+
+    //! The number of events currently held for reuse. The value may be stale by the time it is returned.
+    size_t idle_count() const WI_NOEXCEPT
+    {
+        return static_cast<size_t>(::QueryDepthSList(const_cast<PSLIST_HEADER>(&m_idle[0]))) +
+               ::QueryDepthSList(const_cast<PSLIST_HEADER>(&m_idle[1]));
+    }
+
+private:
+    struct DECLSPEC_ALIGN(MEMORY_ALLOCATION_ALIGNMENT) entry
+    {
+        SLIST_ENTRY link;
+        HANDLE event;
+    };
+
+    SLIST_HEADER m_spare;   // entries not holding an event
+    SLIST_HEADER m_idle[2]; // idle events, indexed by manual-reset
+    wistd::unique_ptr<entry[]> m_entries;
+};
+
+/** An event borrowed from an @ref event_pool, with the same members as `wil::unique_event`. Destroying or resetting it
+returns the event to the pool; release() instead hands ownership of the handle to the caller. Pooled events are unnamed. */
+template <typename err_policy>
+class pooled_event_t
+{
+public:
+    // HRESULT or void error handling...
+    typedef typename err_policy::result result;
+
+    pooled_event_t() WI_NOEXCEPT = default;
+
+    // Exception-based constructor to acquire an event from the pool
+    pooled_event_t(event_pool& pool, EventOptions options)
+    {
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
+        create(pool, options);
+    }
+
+    pooled_event_t(pooled_event_t&& other) WI_NOEXCEPT : m_pool(other.m_pool),
+                                                         m_event(wistd::exchange(other.m_event, nullptr)),
+                                                         m_manualReset(other.m_manualReset)
+    {
+    }
+
+    pooled_event_t& operator=(pooled_event_t&& other) WI_NOEXCEPT
+    {
+        if (this != wistd::addressof(other))
+        {
+            reset();
+            m_pool = other.m_pool;
+            m_event = wistd::exchange(other.m_event, nullptr);
+            m_manualReset = other.m_manualReset;
+        }
+        return *this;
+    }
+
+    ~pooled_event_t() WI_NOEXCEPT
+    {
+        reset();
+    }
+
+    // Returns HRESULT for pooled_event_nothrow, void with exceptions for pooled_event
+    result create(event_pool& pool, EventOptions options = EventOptions::None)
+    {
+        reset();
+        m_event = pool.acquire(options);
+        m_pool = &pool;
+        m_manualReset = WI_IsFlagSet(options, EventOptions::ManualReset);
+        return err_policy::LastErrorIfFalse(m_event != nullptr);
+    }
+
+    //! Returns the event to its pool.
+    void reset() WI_NOEXCEPT
+    {
+        if (m_event)
+        {
+            m_pool->release(wistd::exchange(m_event, nullptr), m_manualReset);
+        }
+    }
+
+    //! Detaches the event from the pool; the caller must close the returned handle.
+    WI_NODISCARD HANDLE release() WI_NOEXCEPT
+    {
+        return wistd::exchange(m_event, nullptr);
+    }
+
+    WI_NODISCARD HANDLE get() const WI_NOEXCEPT
+    {
+        return m_event;
+    }
+
+    explicit operator bool() const WI_NOEXCEPT
+    {
+        return m_event != nullptr;
+    }
+
+    void ResetEvent() const WI_NOEXCEPT
+    {
+        details::ResetEvent(m_event);
+    }
+
+    void SetEvent() const WI_NOEXCEPT
+    {
+        details::SetEvent(m_event);
+    }
+
+    WI_NODISCARD event_set_scope_exit SetEvent_scope_exit() const WI_NOEXCEPT
+    {
+        return wil::SetEvent_scope_exit(m_event);
+    }
+
+    WI_NODISCARD event_reset_scope_exit ResetEvent_scope_exit() const WI_NOEXCEPT
+    {
+        return wil::ResetEvent_scope_exit(m_event);
+    }
+
+    // Checks if a *manual reset* event is currently signaled.  The event must not be an auto-reset event.
+    WI_NODISCARD bool is_signaled() const WI_NOEXCEPT
+    {
+        return wil::event_is_signaled(m_event);
+    }
+
+    bool wait(DWORD dwMilliseconds = INFINITE, BOOL bAlertable = FALSE) const WI_NOEXCEPT
+    {
+        return wil::handle_wait(m_event, dwMilliseconds, bAlertable);
+    }
+
+private:
+    event_pool* m_pool = nullptr;
+    HANDLE m_event = nullptr;
+    bool m_manualReset = false;
+};
+
+typedef pooled_event_t<err_returncode_policy> pooled_event_nothrow;
+typedef pooled_event_t<err_failfast_policy> pooled_event_failfast;
+#ifdef WIL_ENABLE_EXCEPTIONS
+typedef pooled_event_t<err_exception_policy> pooled_event;
+#endif
+
 #ifndef WIL_NO_SLIM_EVENT
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && \
     ((_WIN32_WINNT >= _WIN32_WINNT_WIN8) || (__WIL_RESOURCE_ENABLE_QUIRKS && (_WIN32_WINNT >= _WIN32_WINNT_WIN7)))
@@ -3533,100 +4455,530 @@ using slim_event_manual_reset = slim_event_t<SlimEventType::ManualReset>;
 /** An alias for `wil::slim_event_auto_reset`. */
 using slim_event = slim_event_auto_reset;
 
-#endif // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
-#endif // WIL_NO_SLIM_EVENT
+/// @cond
+namespace details
+{
+    // Waits for '*address' to stop holding 'undesiredValue', spinning up to 'spinCount' times before calling WaitOnAddress.
+    // Like WaitOnAddress, this can return spuriously; callers recheck their condition.
+    inline bool slim_wait_on_address(
+        _In_ LONG* address, LONG undesiredValue, DWORD timeoutMilliseconds, DWORD spinCount) WI_NOEXCEPT
+    {
+        for (DWORD spin = 0; spin < spinCount; ++spin)
+        {
+            if (ReadNoFence(address) != undesiredValue)
+            {
+                return true;
+            }
+            YieldProcessor();
+        }
 
-typedef unique_any<HANDLE, decltype(&details::ReleaseMutex), details::ReleaseMutex, details::pointer_access_none> mutex_release_scope_exit;
+        BOOL waitResult = WaitOnAddress(address, &undesiredValue, sizeof(undesiredValue), timeoutMilliseconds);
+        __FAIL_FAST_ASSERT__(waitResult || ::GetLastError() == ERROR_TIMEOUT);
+        return !!waitResult;
+    }
 
-WI_NODISCARD inline mutex_release_scope_exit ReleaseMutex_scope_exit(_In_ HANDLE hMutex) WI_NOEXCEPT
+    // Tracks how much of a timeout remains across the several WaitOnAddress calls a single wait may need.
+    class slim_wait_deadline
+    {
+    public:
+        explicit slim_wait_deadline(DWORD timeoutMilliseconds) WI_NOEXCEPT : m_timeoutMilliseconds(timeoutMilliseconds)
+        {
+            if ((timeoutMilliseconds != 0) && (timeoutMilliseconds != INFINITE))
+            {
+                QueryUnbiasedInterruptTime(&m_startTime);
+            }
+        }
+
+        // Returns the milliseconds left to wait, 0 once the timeout has elapsed or INFINITE for an unbounded wait.
+        WI_NODISCARD DWORD remaining() const WI_NOEXCEPT
+        {
+            if ((m_timeoutMilliseconds == 0) || (m_timeoutMilliseconds == INFINITE))
+            {
+                return m_timeoutMilliseconds;
+            }
+
+            UINT64 currTime;
+            QueryUnbiasedInterruptTime(&currTime);
+            const UINT64 elapsedTimeMilliseconds = (currTime - m_startTime) / static_cast<UINT64>(10 * 1000);
+            return (elapsedTimeMilliseconds >= m_timeoutMilliseconds)
+                       ? 0
+                       : static_cast<DWORD>(m_timeoutMilliseconds - elapsedTimeMilliseconds);
+        }
+
+    private:
+        DWORD m_timeoutMilliseconds;
+        UINT64 m_startTime{};
+    };
+} // namespace details
+/// @endcond
+
+/** A counting semaphore that, like `wil::slim_event`, doesn't require a kernel object.
+Waiters block with `WaitOnAddress`, so an uncontended `wait()` or `ReleaseSemaphore()` is a single interlocked operation and never
+enters the kernel. The optional spin count makes waiters poll briefly before sleeping, which helps when the count is expected to
+be replenished within a few hundred cycles. Unlike `wil::unique_semaphore` there is no maximum count and the semaphore can't be
+named, shared across processes or moved.
+~~~~
+wil::slim_semaphore slots(4);
+for (auto& item : work)
 {
-    __FAIL_FAST_ASSERT__(hMutex != nullptr);
-    return mutex_release_scope_exit(hMutex);
+    slots.wait();
+    SubmitAsync(item, [&slots] { slots.ReleaseSemaphore(); });
 }
-
-// For efficiency, avoid using mutexes when an srwlock or condition variable will do.
-template <typename storage_t, typename err_policy = err_exception_policy>
-class mutex_t : public storage_t
+~~~~ */
+class slim_semaphore
 {
 public:
-    // forward all base class constructors...
-    template <typename... args_t>
-    explicit mutex_t(args_t&&... args) WI_NOEXCEPT : storage_t(wistd::forward<args_t>(args)...)
+    explicit slim_semaphore(LONG initialCount = 0, DWORD spinCount = 0) WI_NOEXCEPT :
+        m_count(initialCount), m_spinCount(spinCount)
     {
+        __FAIL_FAST_ASSERT__(initialCount >= 0);
     }
 
-    // HRESULT or void error handling...
-    typedef typename err_policy::result result;
+    // Cannot change memory location.
+    slim_semaphore(const slim_semaphore&) = delete;
+    slim_semaphore(slim_semaphore&&) = delete;
+    slim_semaphore& operator=(const slim_semaphore&) = delete;
+    slim_semaphore& operator=(slim_semaphore&&) = delete;
 
-    // Exception-based constructor to create a mutex (prefer unnamed (nullptr) for the name)
-    mutex_t(_In_opt_ PCWSTR name)
+    // Adds 'releaseCount' to the count and wakes enough waiters to consume it.
+    void ReleaseSemaphore(LONG releaseCount = 1, _Out_opt_ LONG* previousCount = nullptr) WI_NOEXCEPT
     {
-        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
-        create(name);
-    }
+        __FAIL_FAST_ASSERT__(releaseCount > 0);
+        const LONG previous = InterlockedExchangeAdd(&m_count, releaseCount);
+        assign_to_opt_param(previousCount, previous);
 
-    void ReleaseMutex() const WI_NOEXCEPT
-    {
-        details::ReleaseMutex(storage_t::get());
+        // FYI: 'WakeByAddress*' invokes a full memory barrier.
+        if (releaseCount == 1)
+        {
+            WakeByAddressSingle(&m_count);
+        }
+        else
+        {
+            WakeByAddressAll(&m_count);
+        }
     }
 
-    WI_NODISCARD mutex_release_scope_exit ReleaseMutex_scope_exit() const WI_NOEXCEPT
+    // Returns the current count; another thread may change it at any time.
+    WI_NODISCARD LONG count() const WI_NOEXCEPT
     {
-        return wil::ReleaseMutex_scope_exit(storage_t::get());
+        return ReadAcquire(&m_count);
     }
 
-    WI_NODISCARD mutex_release_scope_exit
-    acquire(_Out_opt_ DWORD* pStatus = nullptr, DWORD dwMilliseconds = INFINITE, BOOL bAlertable = FALSE) const WI_NOEXCEPT
+    // Decrements the count if it is positive, without waiting.
+    bool try_acquire() WI_NOEXCEPT
     {
-        auto handle = storage_t::get();
-        DWORD status = ::WaitForSingleObjectEx(handle, dwMilliseconds, bAlertable);
-        assign_to_opt_param(pStatus, status);
-        __FAIL_FAST_ASSERT__(
-            (status == WAIT_TIMEOUT) || (status == WAIT_OBJECT_0) || (status == WAIT_ABANDONED) ||
-            (bAlertable && (status == WAIT_IO_COMPLETION)));
-        return mutex_release_scope_exit(((status == WAIT_OBJECT_0) || (status == WAIT_ABANDONED)) ? handle : nullptr);
+        LONG count = ReadNoFence(&m_count);
+        while (count > 0)
+        {
+            const LONG previous = InterlockedCompareExchange(&m_count, count - 1, count);
+            if (previous == count)
+            {
+                return true;
+            }
+            count = previous;
+        }
+        return false;
     }
 
-    // Tries to create a named mutex -- returns false if unable to do so (gle may still be inspected with return=false)
-    bool try_create(
-        _In_opt_ PCWSTR name,
-        DWORD dwFlags = 0,
-        DWORD desiredAccess = MUTEX_ALL_ACCESS,
-        _In_opt_ PSECURITY_ATTRIBUTES mutexAttributes = nullptr,
-        _Out_opt_ bool* alreadyExists = nullptr)
+    // Waits for the count to become positive and decrements it. Returns false if the timeout elapses first.
+    bool wait(DWORD timeoutMilliseconds = INFINITE) WI_NOEXCEPT
     {
-        auto handle = ::CreateMutexExW(mutexAttributes, name, dwFlags, desiredAccess);
-        if (handle == nullptr)
+        details::slim_wait_deadline deadline(timeoutMilliseconds);
+        while (!try_acquire())
         {
-            assign_to_opt_param(alreadyExists, false);
-            return false;
+            const DWORD remaining = deadline.remaining();
+            if (remaining == 0)
+            {
+                return false;
+            }
+            details::slim_wait_on_address(&m_count, 0, remaining, m_spinCount);
         }
-        assign_to_opt_param(alreadyExists, (::GetLastError() == ERROR_ALREADY_EXISTS));
-        storage_t::reset(handle);
         return true;
     }
 
-    // Returns HRESULT for unique_mutex_nothrow, void with exceptions for shared_mutex and unique_mutex
-    result create(
-        _In_opt_ PCWSTR name = nullptr,
-        DWORD dwFlags = 0,
-        DWORD desiredAccess = MUTEX_ALL_ACCESS,
-        _In_opt_ PSECURITY_ATTRIBUTES mutexAttributes = nullptr,
-        _Out_opt_ bool* alreadyExists = nullptr)
+private:
+    LONG m_count;
+    DWORD m_spinCount;
+};
+
+/** A single-use countdown that releases every waiter once it reaches zero, in the spirit of `std::latch`.
+Use it for fork-join work where a `wil::slim_event_manual_reset` plus an interlocked counter would otherwise be needed. Waiting
+is done with `WaitOnAddress`, optionally after spinning `spinCount` times.
+~~~~
+wil::slim_latch done(static_cast<LONG>(items.size()));
+for (auto& item : items)
+{
+    QueueWork([&] { Process(item); done.count_down(); });
+}
+done.wait();
+~~~~ */
+class slim_latch
+{
+public:
+    explicit slim_latch(LONG expected, DWORD spinCount = 0) WI_NOEXCEPT : m_count(expected), m_spinCount(spinCount)
     {
-        return err_policy::LastErrorIfFalse(try_create(name, dwFlags, desiredAccess, mutexAttributes, alreadyExists));
+        __FAIL_FAST_ASSERT__(expected >= 0);
     }
 
-    // Tries to open a named mutex -- returns false if unable to do so (gle may still be inspected with return=false)
-    bool try_open(_In_ PCWSTR name, DWORD desiredAccess = SYNCHRONIZE | MUTEX_MODIFY_STATE, bool inheritHandle = false)
+    // Cannot change memory location.
+    slim_latch(const slim_latch&) = delete;
+    slim_latch(slim_latch&&) = delete;
+    slim_latch& operator=(const slim_latch&) = delete;
+    slim_latch& operator=(slim_latch&&) = delete;
+
+    // Subtracts 'update' from the count, releasing all waiters when it reaches zero. Counting below zero is a fail fast.
+    void count_down(LONG update = 1) WI_NOEXCEPT
     {
-        auto handle = ::OpenMutexW(desiredAccess, inheritHandle, name);
-        if (handle == nullptr)
+        __FAIL_FAST_ASSERT__(update >= 0);
+        const LONG remaining = InterlockedExchangeAdd(&m_count, -update) - update;
+        __FAIL_FAST_ASSERT__(remaining >= 0);
+        if (remaining == 0)
         {
-            return false;
+            WakeByAddressAll(&m_count);
         }
-        storage_t::reset(handle);
-        return true;
+    }
+
+    // Checks if the count has reached zero.
+    WI_NODISCARD bool try_wait() const WI_NOEXCEPT
+    {
+        return ReadAcquire(&m_count) == 0;
+    }
+
+    // Waits for the count to reach zero. Returns false if the timeout elapses first.
+    bool wait(DWORD timeoutMilliseconds = INFINITE) WI_NOEXCEPT
+    {
+        details::slim_wait_deadline deadline(timeoutMilliseconds);
+        for (LONG count = ReadAcquire(&m_count); count != 0; count = ReadAcquire(&m_count))
+        {
+            const DWORD remaining = deadline.remaining();
+            if (remaining == 0)
+            {
+                return false;
+            }
+            details::slim_wait_on_address(&m_count, count, remaining, m_spinCount);
+        }
+        return true;
+    }
+
+    // Equivalent to count_down(update) followed by wait().
+    void arrive_and_wait(LONG update = 1) WI_NOEXCEPT
+    {
+        count_down(update);
+        wait();
+    }
+
+private:
+    LONG m_count;
+    DWORD m_spinCount;
+};
+
+/** A reusable barrier for a fixed number of threads that proceed in phases, in the spirit of `std::barrier`.
+Each call to `arrive_and_wait()` blocks until `expected` threads have arrived. All of them are then released and the barrier
+resets for the next phase. Unlike `EnterSynchronizationBarrier` no kernel object or initialization call is needed.
+~~~~
+wil::slim_barrier phase(workerCount);
+// On each worker thread:
+for (int step = 0; step < stepCount; ++step)
+{
+    Compute(step);
+    phase.arrive_and_wait();
+}
+~~~~ */
+class slim_barrier
+{
+public:
+    explicit slim_barrier(LONG expected, DWORD spinCount = 0) WI_NOEXCEPT :
+        m_expected(expected), m_remaining(expected), m_spinCount(spinCount)
+    {
+        __FAIL_FAST_ASSERT__(expected > 0);
+    }
+
+    // Cannot change memory location.
+    slim_barrier(const slim_barrier&) = delete;
+    slim_barrier(slim_barrier&&) = delete;
+    slim_barrier& operator=(const slim_barrier&) = delete;
+    slim_barrier& operator=(slim_barrier&&) = delete;
+
+    // Blocks until every participant has arrived at the current phase. Returns true on exactly one of them (the last to
+    // arrive), matching the return value of `EnterSynchronizationBarrier`.
+    bool arrive_and_wait() WI_NOEXCEPT
+    {
+        // The phase must be read before arriving; once the last thread arrives it may advance at any moment.
+        const LONG phase = ReadAcquire(&m_phase);
+        if (InterlockedDecrement(&m_remaining) == 0)
+        {
+            // Reset for the next phase before releasing anyone who could arrive at it.
+            WriteNoFence(&m_remaining, m_expected);
+            InterlockedIncrement(&m_phase);
+            WakeByAddressAll(&m_phase);
+            return true;
+        }
+
+        while (ReadAcquire(&m_phase) == phase)
+        {
+            details::slim_wait_on_address(&m_phase, phase, INFINITE, m_spinCount);
+        }
+        return false;
+    }
+
+private:
+    const LONG m_expected;
+    LONG m_remaining;
+    LONG m_phase = 0;
+    DWORD m_spinCount;
+};
+
+#endif // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+#endif // WIL_NO_SLIM_EVENT
+
+#if defined(WIL_ENABLE_LOCK_CONTENTION_PROFILING) || defined(WIL_DOXYGEN)
+/** Contention seen by one instrumented lock, as reported by @ref for_each_lock_contention.
+Only present when `WIL_ENABLE_LOCK_CONTENTION_PROFILING` is defined. That macro changes the layout of `wil::srwlock` and
+`wil::critical_section`, so it must be defined consistently for every translation unit of a binary. */
+struct lock_contention_statistics
+{
+    //! The address of the `wil::srwlock` or `wil::critical_section`, or the mutex handle; null for the mutex overflow entry.
+    const void* lock;
+    //! "srwlock", "critical_section" or "mutex".
+    PCSTR lockType;
+    //! The number of acquisitions that had to wait.
+    ULONGLONG contentionCount;
+    //! Total and longest time spent waiting by those acquisitions.
+    ULONGLONG totalWaitMicroseconds;
+    ULONGLONG maxWaitMicroseconds;
+    //! The code address that most recently waited for the lock.
+    const void* lastContendedCallsite;
+    //! The thread that held the lock when it was most recently contended, or 0 if unknown. For `wil::srwlock` this is the most
+    //! recent exclusive owner, which may have already released the lock if the contention was with shared owners.
+    DWORD lastHolderThreadId;
+};
+
+/// @cond
+namespace details
+{
+    struct lock_contention_record
+    {
+        lock_contention_record* next = nullptr;
+        lock_contention_record* prev = nullptr;
+        void* lock = nullptr;
+        PCSTR lockType = nullptr;
+        LONG64 contentionCount = 0;
+        LONG64 totalWaitTicks = 0;
+        LONG64 maxWaitTicks = 0;
+        void* lastCallsite = nullptr;
+        LONG lastHolderThreadId = 0;
+        LONG exclusiveOwnerThreadId = 0; // for locks that don't track their own owner
+
+        void record_contention(LONG64 waitTicks, void* callsite, DWORD holderThreadId) WI_NOEXCEPT
+        {
+            InterlockedIncrement64(&contentionCount);
+            InterlockedExchangeAdd64(&totalWaitTicks, waitTicks);
+            for (LONG64 currentMax = ReadNoFence64(&maxWaitTicks); waitTicks > currentMax;)
+            {
+                const LONG64 previous = InterlockedCompareExchange64(&maxWaitTicks, waitTicks, currentMax);
+                if (previous == currentMax)
+                {
+                    break;
+                }
+                currentMax = previous;
+            }
+            InterlockedExchangePointer(&lastCallsite, callsite);
+            InterlockedExchange(&lastHolderThreadId, static_cast<LONG>(holderThreadId));
+        }
+    };
+
+    // Instrumented srwlocks and critical sections link their records into 'first' for their lifetime. Mutexes can be shared
+    // between wrappers and processes, so they are instead keyed by handle value into a fixed table that never shrinks and
+    // whose records are never freed. Closing a mutex doesn't reset its record, so a later mutex that reuses the same handle
+    // value adds to the earlier mutex's statistics.
+    struct lock_contention_registry
+    {
+        SRWLOCK lock = SRWLOCK_INIT;
+        lock_contention_record* first = nullptr;
+        lock_contention_record mutexRecords[64];
+        lock_contention_record mutexOverflow;
+    };
+
+    inline lock_contention_registry& get_lock_contention_registry() WI_NOEXCEPT
+    {
+        static lock_contention_registry s_registry;
+        return s_registry;
+    }
+
+    inline void register_lock_contention(lock_contention_record& record, void* lock, PCSTR lockType) WI_NOEXCEPT
+    {
+        record.lock = lock;
+        record.lockType = lockType;
+        auto& registry = get_lock_contention_registry();
+        ::AcquireSRWLockExclusive(&registry.lock);
+        record.next = registry.first;
+        if (registry.first)
+        {
+            registry.first->prev = &record;
+        }
+        registry.first = &record;
+        ::ReleaseSRWLockExclusive(&registry.lock);
+    }
+
+    inline void unregister_lock_contention(lock_contention_record& record) WI_NOEXCEPT
+    {
+        auto& registry = get_lock_contention_registry();
+        ::AcquireSRWLockExclusive(&registry.lock);
+        (record.prev ? record.prev->next : registry.first) = record.next;
+        if (record.next)
+        {
+            record.next->prev = record.prev;
+        }
+        ::ReleaseSRWLockExclusive(&registry.lock);
+    }
+
+    inline lock_contention_record& find_mutex_contention_record(HANDLE mutex) WI_NOEXCEPT
+    {
+        auto& registry = get_lock_contention_registry();
+        const size_t recordCount = ARRAYSIZE(registry.mutexRecords);
+        size_t index = (reinterpret_cast<ULONG_PTR>(mutex) >> 2) % recordCount;
+        for (size_t probe = 0; probe < recordCount; ++probe, index = (index + 1) % recordCount)
+        {
+            auto& record = registry.mutexRecords[index];
+            void* const claimed = InterlockedCompareExchangePointer(&record.lock, mutex, nullptr);
+            if (claimed == nullptr)
+            {
+                record.lockType = "mutex";
+                return record;
+            }
+            if (claimed == mutex)
+            {
+                return record;
+            }
+        }
+        registry.mutexOverflow.lockType = "mutex";
+        return registry.mutexOverflow;
+    }
+
+    // Waits for a lock whose uncontended attempt failed. Kept out of line so that _ReturnAddress() identifies the code that
+    // acquired the lock, and so the extra code stays off the uncontended path.
+    template <typename TAcquire>
+    __declspec(noinline) void acquire_contended_lock(
+        lock_contention_record& record, DWORD holderThreadId, TAcquire&& acquire) WI_NOEXCEPT
+    {
+        LARGE_INTEGER start;
+        ::QueryPerformanceCounter(&start);
+        acquire();
+        LARGE_INTEGER end;
+        ::QueryPerformanceCounter(&end);
+        record.record_contention(end.QuadPart - start.QuadPart, _ReturnAddress(), holderThreadId);
+    }
+
+    inline ULONGLONG lock_contention_ticks_to_microseconds(LONG64 ticks, LONG64 frequency) WI_NOEXCEPT
+    {
+        const auto wholeSeconds = static_cast<ULONGLONG>(ticks / frequency);
+        return (wholeSeconds * 1000000) + static_cast<ULONGLONG>(((ticks % frequency) * 1000000) / frequency);
+    }
+} // namespace details
+/// @endcond
+#endif // WIL_ENABLE_LOCK_CONTENTION_PROFILING
+
+typedef unique_any<HANDLE, decltype(&details::ReleaseMutex), details::ReleaseMutex, details::pointer_access_none> mutex_release_scope_exit;
+
+WI_NODISCARD inline mutex_release_scope_exit ReleaseMutex_scope_exit(_In_ HANDLE hMutex) WI_NOEXCEPT
+{
+    __FAIL_FAST_ASSERT__(hMutex != nullptr);
+    return mutex_release_scope_exit(hMutex);
+}
+
+// For efficiency, avoid using mutexes when an srwlock or condition variable will do.
+template <typename storage_t, typename err_policy = err_exception_policy>
+class mutex_t : public storage_t
+{
+public:
+    // forward all base class constructors...
+    template <typename... args_t>
+    explicit mutex_t(args_t&&... args) WI_NOEXCEPT : storage_t(wistd::forward<args_t>(args)...)
+    {
+    }
+
+    // HRESULT or void error handling...
+    typedef typename err_policy::result result;
+
+    // Exception-based constructor to create a mutex (prefer unnamed (nullptr) for the name)
+    mutex_t(_In_opt_ PCWSTR name)
+    {
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
+        create(name);
+    }
+
+    void ReleaseMutex() const WI_NOEXCEPT
+    {
+        details::ReleaseMutex(storage_t::get());
+    }
+
+    WI_NODISCARD mutex_release_scope_exit ReleaseMutex_scope_exit() const WI_NOEXCEPT
+    {
+        return wil::ReleaseMutex_scope_exit(storage_t::get());
+    }
+
+    WI_NODISCARD mutex_release_scope_exit
+    acquire(_Out_opt_ DWORD* pStatus = nullptr, DWORD dwMilliseconds = INFINITE, BOOL bAlertable = FALSE) const WI_NOEXCEPT
+    {
+        auto handle = storage_t::get();
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+        DWORD status = ::WaitForSingleObjectEx(handle, 0, bAlertable);
+        if ((status == WAIT_TIMEOUT) && (dwMilliseconds != 0))
+        {
+            details::acquire_contended_lock(details::find_mutex_contention_record(handle), 0, [&] {
+                status = ::WaitForSingleObjectEx(handle, dwMilliseconds, bAlertable);
+            });
+        }
+#else
+        DWORD status = ::WaitForSingleObjectEx(handle, dwMilliseconds, bAlertable);
+#endif
+        assign_to_opt_param(pStatus, status);
+        __FAIL_FAST_ASSERT__(
+            (status == WAIT_TIMEOUT) || (status == WAIT_OBJECT_0) || (status == WAIT_ABANDONED) ||
+            (bAlertable && (status == WAIT_IO_COMPLETION)));
+        return mutex_release_scope_exit(((status == WAIT_OBJECT_0) || (status == WAIT_ABANDONED)) ? handle : nullptr);
+    }
+
+    // Tries to create a named mutex -- returns false if unable to do so (gle may still be inspected with return=false)
+    bool try_create(
+        _In_opt_ PCWSTR name,
+        DWORD dwFlags = 0,
+        DWORD desiredAccess = MUTEX_ALL_ACCESS,
+        _In_opt_ PSECURITY_ATTRIBUTES mutexAttributes = nullptr,
+        _Out_opt_ bool* alreadyExists = nullptr)
+    {
+        auto handle = ::CreateMutexExW(mutexAttributes, name, dwFlags, desiredAccess);
+        if (handle == nullptr)
+        {
+            assign_to_opt_param(alreadyExists, false);
+            return false;
+        }
+        assign_to_opt_param(alreadyExists, (::GetLastError() == ERROR_ALREADY_EXISTS));
+        storage_t::reset(handle);
+        return true;
+    }
+
+    // Returns HRESULT for unique_mutex_nothrow, void with exceptions for shared_mutex and unique_mutex
+    result create(
+        _In_opt_ PCWSTR name = nullptr,
+        DWORD dwFlags = 0,
+        DWORD desiredAccess = MUTEX_ALL_ACCESS,
+        _In_opt_ PSECURITY_ATTRIBUTES mutexAttributes = nullptr,
+        _Out_opt_ bool* alreadyExists = nullptr)
+    {
+        return err_policy::LastErrorIfFalse(try_create(name, dwFlags, desiredAccess, mutexAttributes, alreadyExists));
+    }
+
+    // Tries to open a named mutex -- returns false if unable to do so (gle may still be inspected with return=false)
+    bool try_open(_In_ PCWSTR name, DWORD desiredAccess = SYNCHRONIZE | MUTEX_MODIFY_STATE, bool inheritHandle = false)
+    {
+        auto handle = ::OpenMutexW(desiredAccess, inheritHandle, name);
+        if (handle == nullptr)
+        {
+            return false;
+        }
+        storage_t::reset(handle);
+        return true;
     }
 
     // Returns HRESULT for unique_mutex_nothrow, void with exceptions for shared_mutex and unique_mutex
@@ -3637,6 +4989,13 @@ public:
 };
 
 typedef unique_any_t<mutex_t<details::unique_storage<details::handle_resource_policy>, err_returncode_policy>> unique_mutex_nothrow;
+/// @cond
+namespace details
+{
+    typedef unique_any_t<mutex_t<unique_storage<cross_module_handle_resource_policy>, err_returncode_policy>>
+        cross_module_mutex_nothrow;
+}
+/// @endcond
 typedef unique_any_t<mutex_t<details::unique_storage<details::handle_resource_policy>, err_failfast_policy>> unique_mutex_failfast;
 #ifdef WIL_ENABLE_EXCEPTIONS
 typedef unique_any_t<mutex_t<details::unique_storage<details::handle_resource_policy>, err_exception_policy>> unique_mutex;
@@ -3751,6 +5110,13 @@ public:
 };
 
 typedef unique_any_t<semaphore_t<details::unique_storage<details::handle_resource_policy>, err_returncode_policy>> unique_semaphore_nothrow;
+/// @cond
+namespace details
+{
+    typedef unique_any_t<semaphore_t<unique_storage<cross_module_handle_resource_policy>, err_returncode_policy>>
+        cross_module_semaphore_nothrow;
+}
+/// @endcond
 typedef unique_any_t<semaphore_t<details::unique_storage<details::handle_resource_policy>, err_failfast_policy>> unique_semaphore_failfast;
 #ifdef WIL_ENABLE_EXCEPTIONS
 typedef unique_any_t<semaphore_t<details::unique_storage<details::handle_resource_policy>, err_exception_policy>> unique_semaphore;
@@ -3789,21 +5155,64 @@ public:
     srwlock& operator=(const srwlock&) = delete;
     srwlock& operator=(srwlock&&) = delete;
 
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+    srwlock() WI_NOEXCEPT
+    {
+        details::register_lock_contention(m_contention, this, "srwlock");
+    }
+
+    ~srwlock() WI_NOEXCEPT
+    {
+        details::unregister_lock_contention(m_contention);
+    }
+
+    WI_NODISCARD rwlock_release_exclusive_scope_exit lock_exclusive() WI_NOEXCEPT
+    {
+        if (!::TryAcquireSRWLockExclusive(&m_lock))
+        {
+            details::acquire_contended_lock(m_contention, last_exclusive_owner(), [&] {
+                ::AcquireSRWLockExclusive(&m_lock);
+            });
+        }
+        WriteNoFence(&m_contention.exclusiveOwnerThreadId, static_cast<LONG>(::GetCurrentThreadId()));
+        return rwlock_release_exclusive_scope_exit(&m_lock);
+    }
+#else
     srwlock() = default;
 
     WI_NODISCARD rwlock_release_exclusive_scope_exit lock_exclusive() WI_NOEXCEPT
     {
         return wil::AcquireSRWLockExclusive(&m_lock);
     }
+#endif
 
     WI_NODISCARD rwlock_release_exclusive_scope_exit try_lock_exclusive() WI_NOEXCEPT
     {
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+        auto lock = wil::TryAcquireSRWLockExclusive(&m_lock);
+        if (lock)
+        {
+            WriteNoFence(&m_contention.exclusiveOwnerThreadId, static_cast<LONG>(::GetCurrentThreadId()));
+        }
+        return lock;
+#else
         return wil::TryAcquireSRWLockExclusive(&m_lock);
+#endif
     }
 
     WI_NODISCARD rwlock_release_shared_scope_exit lock_shared() WI_NOEXCEPT
     {
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+        if (!::TryAcquireSRWLockShared(&m_lock))
+        {
+            details::acquire_contended_lock(m_contention, last_exclusive_owner(), [&] {
+                ::AcquireSRWLockShared(&m_lock);
+            });
+        }
+        return rwlock_release_shared_scope_exit(&m_lock);
+#else
         return wil::AcquireSRWLockShared(&m_lock);
+#endif
     }
 
     WI_NODISCARD rwlock_release_shared_scope_exit try_lock_shared() WI_NOEXCEPT
@@ -3812,46 +5221,297 @@ public:
     }
 
 private:
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+    // SRWLOCK doesn't record its owner, so report the thread that most recently acquired it exclusively.
+    DWORD last_exclusive_owner() const WI_NOEXCEPT
+    {
+        return static_cast<DWORD>(ReadNoFence(&m_contention.exclusiveOwnerThreadId));
+    }
+
+    details::lock_contention_record m_contention;
+#endif
     SRWLOCK m_lock = SRWLOCK_INIT;
 };
 
-typedef unique_any<CRITICAL_SECTION*, decltype(&::LeaveCriticalSection), ::LeaveCriticalSection, details::pointer_access_noaddress> cs_leave_scope_exit;
+#if defined(WIL_ENABLE_LOCK_CONTENTION_PROFILING) || defined(WIL_DOXYGEN)
+/** Calls 'callback' with a snapshot of every instrumented lock that has been contended at least once.
+Requires `WIL_ENABLE_LOCK_CONTENTION_PROFILING`. With it defined, `wil::srwlock`, `wil::critical_section` and `mutex_t`
+acquisitions first try the uncontended path. Only when that fails do they time the wait and record it against the lock, along
+with the calling code address and the thread that held the lock. Without the macro none of this code exists. The registry lock is
+held during the callbacks, so they must not construct or destroy an instrumented `wil::srwlock` or `wil::critical_section`.
+Mutex statistics are keyed by handle value and are never discarded, so a mutex whose handle value was previously used by a
+closed mutex reports the combined statistics of both.
+~~~~
+wil::for_each_lock_contention([](const wil::lock_contention_statistics& statistics) {
+    wprintf(L"%hs %p: %llu waits, %llu us\n", statistics.lockType, statistics.lock, statistics.contentionCount,
+        statistics.totalWaitMicroseconds);
+});
+~~~~ */
+template <typename TCallback>
+void for_each_lock_contention(TCallback&& callback)
+{
+    LARGE_INTEGER frequency;
+    ::QueryPerformanceFrequency(&frequency);
+    auto visit = [&](const details::lock_contention_record& record) {
+        const LONG64 contentionCount = ReadAcquire64(&record.contentionCount);
+        if (contentionCount != 0)
+        {
+            lock_contention_statistics statistics{};
+            statistics.lock = ReadPointerNoFence(&record.lock);
+            statistics.lockType = record.lockType;
+            statistics.contentionCount = static_cast<ULONGLONG>(contentionCount);
+            statistics.totalWaitMicroseconds =
+                details::lock_contention_ticks_to_microseconds(ReadNoFence64(&record.totalWaitTicks), frequency.QuadPart);
+            statistics.maxWaitMicroseconds =
+                details::lock_contention_ticks_to_microseconds(ReadNoFence64(&record.maxWaitTicks), frequency.QuadPart);
+            statistics.lastContendedCallsite = ReadPointerNoFence(&record.lastCallsite);
+            statistics.lastHolderThreadId = static_cast<DWORD>(ReadNoFence(&record.lastHolderThreadId));
+            callback(statistics);
+        }
+    };
 
-WI_NODISCARD inline cs_leave_scope_exit EnterCriticalSection(_Inout_ CRITICAL_SECTION* pcs) WI_NOEXCEPT
-{
-    ::EnterCriticalSection(pcs);
-    return cs_leave_scope_exit(pcs);
+    auto& registry = details::get_lock_contention_registry();
+    auto lock = wil::AcquireSRWLockShared(&registry.lock);
+    for (auto record = registry.first; record != nullptr; record = record->next)
+    {
+        visit(*record);
+    }
+    for (const auto& record : registry.mutexRecords)
+    {
+        visit(record);
+    }
+    visit(registry.mutexOverflow);
 }
+#endif // WIL_ENABLE_LOCK_CONTENTION_PROFILING
 
-WI_NODISCARD inline cs_leave_scope_exit TryEnterCriticalSection(_Inout_ CRITICAL_SECTION* pcs) WI_NOEXCEPT
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+/// @cond
+namespace details
 {
-    return cs_leave_scope_exit(::TryEnterCriticalSection(pcs) ? pcs : nullptr);
-}
+    // Set in a reader shard while a writer waits for that shard to drain, so the last reader out knows to wake it.
+    constexpr LONG sharded_rwlock_writer_waiting = 0x40000000;
 
-// Critical sections are worse than srwlocks in performance and memory usage (their only unique attribute
-// being recursive acquisition). Prefer srwlocks over critical sections when you don't need recursive acquisition.
-class critical_section
-{
-public:
-    critical_section(const critical_section&) = delete;
-    critical_section(critical_section&&) = delete;
-    critical_section& operator=(const critical_section&) = delete;
-    critical_section& operator=(critical_section&&) = delete;
+    // State shared by all shard counts of a sharded_rwlock_t: writers serialize on 'lock' and publish 'active' to readers.
+    struct sharded_rwlock_writer
+    {
+        SRWLOCK lock = SRWLOCK_INIT;
+        LONG active = 0;
+    };
 
-    critical_section(ULONG spincount = 0) WI_NOEXCEPT
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+    struct DECLSPEC_CACHEALIGN sharded_rwlock_shard
     {
-        // Initialization will not fail without invalid params...
+        LONG readers = 0;
+    };
+#pragma warning(pop)
+
+    inline void ReleaseShardedRwlockShared(_Inout_ sharded_rwlock_shard* shard) WI_NOEXCEPT
+    {
+        if (InterlockedDecrement(&shard->readers) == sharded_rwlock_writer_waiting)
+        {
+            WakeByAddressSingle(&shard->readers);
+        }
+    }
+
+    inline void ReleaseShardedRwlockExclusive(_Inout_ sharded_rwlock_writer* writer) WI_NOEXCEPT
+    {
+        WriteRelease(&writer->active, 0);
+        WakeByAddressAll(&writer->active);
+        ::ReleaseSRWLockExclusive(&writer->lock);
+    }
+} // namespace details
+/// @endcond
+
+typedef unique_any<
+    details::sharded_rwlock_writer*,
+    decltype(&details::ReleaseShardedRwlockExclusive),
+    details::ReleaseShardedRwlockExclusive,
+    details::pointer_access_noaddress>
+    sharded_rwlock_release_exclusive_scope_exit;
+typedef unique_any<
+    details::sharded_rwlock_shard*,
+    decltype(&details::ReleaseShardedRwlockShared),
+    details::ReleaseShardedRwlockShared,
+    details::pointer_access_noaddress>
+    sharded_rwlock_release_shared_scope_exit;
+
+/** A reader/writer lock whose shared acquisitions scale with the number of processors.
+Every `wil::srwlock::lock_shared()` performs an interlocked operation on the same word, so read-mostly data shared by many threads
+stops scaling once that cache line saturates. This lock instead gives each processor (modulo `shardCount`) its own cache-aligned
+reader count. A shared acquire touches only the current processor's shard, and a writer announces itself and then waits for every
+shard to drain. Exclusive acquisition is therefore much more expensive than with `wil::srwlock`, and the lock occupies
+`shardCount` cache lines; use it only for data that is read far more often than it is written. Neither acquisition is recursive.
+The returned guards follow the `wil::srwlock` pattern and release the lock when they go out of scope.
+~~~~
+wil::sharded_rwlock m_configLock;
+
+int GetSetting() const
+{
+    auto lock = m_configLock.lock_shared();
+    return m_setting;
+}
+~~~~ */
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+template <size_t shardCount>
+class sharded_rwlock_t
+{
+public:
+    static_assert(shardCount > 0, "sharded_rwlock_t requires at least one shard");
+
+    sharded_rwlock_t(const sharded_rwlock_t&) = delete;
+    sharded_rwlock_t(sharded_rwlock_t&&) = delete;
+    sharded_rwlock_t& operator=(const sharded_rwlock_t&) = delete;
+    sharded_rwlock_t& operator=(sharded_rwlock_t&&) = delete;
+
+    sharded_rwlock_t() = default;
+
+    WI_NODISCARD sharded_rwlock_release_exclusive_scope_exit lock_exclusive() WI_NOEXCEPT
+    {
+        ::AcquireSRWLockExclusive(&m_writer.lock);
+
+        // The interlocked exchange orders the announcement before the shard reads below; readers increment their shard before
+        // checking 'active', so every reader either sees the writer and backs off or is seen by it.
+        InterlockedExchange(&m_writer.active, 1);
+        for (auto& shard : m_shards)
+        {
+            InterlockedOr(&shard.readers, details::sharded_rwlock_writer_waiting);
+            for (LONG readers = ReadAcquire(&shard.readers); readers != details::sharded_rwlock_writer_waiting;
+                 readers = ReadAcquire(&shard.readers))
+            {
+                WaitOnAddress(&shard.readers, &readers, sizeof(readers), INFINITE);
+            }
+            InterlockedAnd(&shard.readers, ~details::sharded_rwlock_writer_waiting);
+        }
+        return sharded_rwlock_release_exclusive_scope_exit(&m_writer);
+    }
+
+    WI_NODISCARD sharded_rwlock_release_exclusive_scope_exit try_lock_exclusive() WI_NOEXCEPT
+    {
+        if (!::TryAcquireSRWLockExclusive(&m_writer.lock))
+        {
+            return sharded_rwlock_release_exclusive_scope_exit(nullptr);
+        }
+
+        InterlockedExchange(&m_writer.active, 1);
+        sharded_rwlock_release_exclusive_scope_exit lock(&m_writer);
+        for (auto& shard : m_shards)
+        {
+            if (ReadAcquire(&shard.readers) != 0)
+            {
+                lock.reset();
+                break;
+            }
+        }
+        return lock;
+    }
+
+    WI_NODISCARD sharded_rwlock_release_shared_scope_exit lock_shared() WI_NOEXCEPT
+    {
+        for (;;)
+        {
+            sharded_rwlock_release_shared_scope_exit lock(try_enter_shard(current_shard()));
+            if (lock)
+            {
+                return lock;
+            }
+
+            LONG writerActive = 1;
+            while (ReadAcquire(&m_writer.active) == writerActive)
+            {
+                WaitOnAddress(&m_writer.active, &writerActive, sizeof(writerActive), INFINITE);
+            }
+        }
+    }
+
+    WI_NODISCARD sharded_rwlock_release_shared_scope_exit try_lock_shared() WI_NOEXCEPT
+    {
+        return sharded_rwlock_release_shared_scope_exit(try_enter_shard(current_shard()));
+    }
+
+private:
+    details::sharded_rwlock_shard& current_shard() WI_NOEXCEPT
+    {
+        PROCESSOR_NUMBER processor;
+        ::GetCurrentProcessorNumberEx(&processor);
+        return m_shards[((static_cast<size_t>(processor.Group) * MAXIMUM_PROC_PER_GROUP) + processor.Number) % shardCount];
+    }
+
+    // Registers a reader on 'shard', backing out if a writer holds or is acquiring the lock.
+    details::sharded_rwlock_shard* try_enter_shard(details::sharded_rwlock_shard& shard) WI_NOEXCEPT
+    {
+        InterlockedIncrement(&shard.readers);
+        if (ReadAcquire(&m_writer.active) != 0)
+        {
+            details::ReleaseShardedRwlockShared(&shard);
+            return nullptr;
+        }
+        return &shard;
+    }
+
+    details::sharded_rwlock_shard m_shards[shardCount];
+    details::sharded_rwlock_writer m_writer;
+};
+#pragma warning(pop)
+
+/** A `wil::sharded_rwlock_t` with one reader shard per processor in a 64-processor group. */
+using sharded_rwlock = sharded_rwlock_t<64>;
+#endif // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+
+typedef unique_any<CRITICAL_SECTION*, decltype(&::LeaveCriticalSection), ::LeaveCriticalSection, details::pointer_access_noaddress> cs_leave_scope_exit;
+
+WI_NODISCARD inline cs_leave_scope_exit EnterCriticalSection(_Inout_ CRITICAL_SECTION* pcs) WI_NOEXCEPT
+{
+    ::EnterCriticalSection(pcs);
+    return cs_leave_scope_exit(pcs);
+}
+
+WI_NODISCARD inline cs_leave_scope_exit TryEnterCriticalSection(_Inout_ CRITICAL_SECTION* pcs) WI_NOEXCEPT
+{
+    return cs_leave_scope_exit(::TryEnterCriticalSection(pcs) ? pcs : nullptr);
+}
+
+// Critical sections are worse than srwlocks in performance and memory usage (their only unique attribute
+// being recursive acquisition). Prefer srwlocks over critical sections when you don't need recursive acquisition.
+class critical_section
+{
+public:
+    critical_section(const critical_section&) = delete;
+    critical_section(critical_section&&) = delete;
+    critical_section& operator=(const critical_section&) = delete;
+    critical_section& operator=(critical_section&&) = delete;
+
+    critical_section(ULONG spincount = 0) WI_NOEXCEPT
+    {
+        // Initialization will not fail without invalid params...
         ::InitializeCriticalSectionEx(&m_cs, spincount, 0);
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+        details::register_lock_contention(m_contention, this, "critical_section");
+#endif
     }
 
     ~critical_section() WI_NOEXCEPT
     {
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+        details::unregister_lock_contention(m_contention);
+#endif
         ::DeleteCriticalSection(&m_cs);
     }
 
     WI_NODISCARD cs_leave_scope_exit lock() WI_NOEXCEPT
     {
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+        if (!::TryEnterCriticalSection(&m_cs))
+        {
+            details::acquire_contended_lock(m_contention, HandleToULong(m_cs.OwningThread), [&] {
+                ::EnterCriticalSection(&m_cs);
+            });
+        }
+        return cs_leave_scope_exit(&m_cs);
+#else
         return wil::EnterCriticalSection(&m_cs);
+#endif
     }
 
     WI_NODISCARD cs_leave_scope_exit try_lock() WI_NOEXCEPT
@@ -3861,6 +5521,9 @@ public:
 
 private:
     CRITICAL_SECTION m_cs;
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+    details::lock_contention_record m_contention;
+#endif
 };
 
 class condition_variable
@@ -4243,363 +5906,2123 @@ A specialization of wistd::unique_ptr<> that frees via UnmapViewOfFile(p).
 template <typename T = void>
 using unique_mapview_ptr = wistd::unique_ptr<details::ensure_trivially_destructible_t<T>, mapview_deleter>;
 
-#endif // __WIL_WINBASE_
-
-#if (defined(__WIL_WINBASE_) && defined(__NOTHROW_T_DEFINED) && !defined(__WIL_WINBASE_NOTHROW_T_DEFINED)) || defined(WIL_DOXYGEN)
-/// @cond
-#define __WIL_WINBASE_NOTHROW_T_DEFINED
-/// @endcond
-
-// unique_event_watcher, unique_event_watcher_nothrow, unique_event_watcher_failfast
-//
-// Clients must include <new> or <new.h> to enable use of this class as it uses new(std::nothrow).
-// This is to avoid the dependency on those headers that some clients can't tolerate.
-//
-// These classes makes it easy to execute a provided function when an event
-// is signaled. It will create the event handle for you, take ownership of one
-// or duplicate a handle provided. It supports the ability to signal the
-// event using SetEvent() and SetEvent_scope_exit();
-//
-// This can be used to support producer-consumer pattern
-// where a producer updates some state then signals the event when done.
-// The consumer will consume that state in the callback provided to unique_event_watcher.
-//
-// Note, multiple signals may coalesce into a single callback.
-//
-// Example use of throwing version:
-// auto globalStateWatcher = wil::make_event_watcher([]
-//     {
-//         currentState = GetGlobalState();
-//     });
-//
-// UpdateGlobalState(value);
-// globalStateWatcher.SetEvent(); // signal observers so they can update
-//
-// Example use of non-throwing version:
-// auto globalStateWatcher = wil::make_event_watcher_nothrow([]
-//     {
-//         currentState = GetGlobalState();
-//     });
-// RETURN_IF_NULL_ALLOC(globalStateWatcher);
-//
-// UpdateGlobalState(value);
-// globalStateWatcher.SetEvent(); // signal observers so they can update
-enum class event_watcher_options
+/** A monotonic (bump pointer) arena over a region reserved with VirtualAlloc. Memory is committed in `commitIncrement`
+steps as the arena grows, and individual allocations are never freed; `reset()` rewinds the arena for reuse and destroying
+it releases the whole region. This suits phases that make many small allocations with a common lifetime, such as parsing a
+document or handling one request. The arena is not thread-safe.
+@code
+wil::virtual_arena arena(1024 * 1024);
+auto node = wil::make_unique_arena<Node>(arena, 42);
+PWSTR name = wil::make_arena_string(arena, L"name");
+@endcode
+*/
+template <typename err_policy>
+class virtual_arena_t
 {
-    none = 0x0,
-    manual_reset = 0x1 << 0,
-    manual_start = 0x1 << 1,
-};
+public:
+    typedef typename err_policy::result result;
+    static constexpr size_t default_commit_increment = 64 * 1024;
 
-DEFINE_ENUM_FLAG_OPERATORS(event_watcher_options);
+    // The region starts on an allocation granularity boundary, which is 64KB on every Windows platform. Offsets within it
+    // are only aligned in absolute terms up to that boundary.
+    static constexpr size_t max_alignment = 64 * 1024;
 
-/// @cond
-namespace details
-{
-    struct event_watcher_state
-    {
-        wistd::function<void()> m_callback;
-        unique_event_nothrow m_event;
-        // The thread pool must be last to ensure that the other members are valid
-        // when it is destructed as it will reference them.
-        unique_threadpool_wait m_threadPoolWait;
-        event_watcher_options m_flags{event_watcher_options::none};
-    };
+    virtual_arena_t() WI_NOEXCEPT = default;
 
-    inline void delete_event_watcher_state(_In_opt_ event_watcher_state* watcherStorage)
+    explicit virtual_arena_t(size_t reserveBytes, size_t commitIncrement = default_commit_increment)
     {
-        delete watcherStorage;
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
+        create(reserveBytes, commitIncrement);
     }
 
-    typedef resource_policy<event_watcher_state*, decltype(&delete_event_watcher_state), delete_event_watcher_state, details::pointer_access_none> event_watcher_state_resource_policy;
-} // namespace details
-/// @endcond
-
-template <typename storage_t, typename err_policy = err_exception_policy>
-class event_watcher_t : public storage_t
-{
-public:
-    // forward all base class constructors...
-    template <typename... args_t>
-    explicit event_watcher_t(args_t&&... args) WI_NOEXCEPT : storage_t(wistd::forward<args_t>(args)...)
+    virtual_arena_t(virtual_arena_t&& other) WI_NOEXCEPT
+        : m_base(wistd::move(other.m_base)),
+          m_reserved(wistd::exchange(other.m_reserved, 0)),
+          m_committed(wistd::exchange(other.m_committed, 0)),
+          m_used(wistd::exchange(other.m_used, 0)),
+          m_commitIncrement(other.m_commitIncrement)
     {
     }
 
-    // HRESULT or void error handling...
-    typedef typename err_policy::result result;
-
-    // Exception-based constructors
-    template <typename from_err_policy>
-    event_watcher_t(
-        unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, from_err_policy>>&& eventHandle,
-        event_watcher_options optFlags,
-        wistd::function<void()>&& callback)
+    virtual_arena_t& operator=(virtual_arena_t&& other) WI_NOEXCEPT
     {
-        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
-        create(wistd::move(eventHandle), optFlags, wistd::move(callback));
+        if (this != wistd::addressof(other))
+        {
+            m_base = wistd::move(other.m_base);
+            m_reserved = wistd::exchange(other.m_reserved, 0);
+            m_committed = wistd::exchange(other.m_committed, 0);
+            m_used = wistd::exchange(other.m_used, 0);
+            m_commitIncrement = other.m_commitIncrement;
+        }
+        return *this;
     }
 
-    template <typename from_err_policy>
-    event_watcher_t(
-        unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, from_err_policy>>&& eventHandle,
-        wistd::function<void()>&& callback) :
-        event_watcher_t(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback))
+    //! Reserves `reserveBytes` of address space, replacing any region the arena already held.
+    result create(size_t reserveBytes, size_t commitIncrement = default_commit_increment)
     {
+        return err_policy::HResult(create_nothrow(reserveBytes, commitIncrement));
     }
 
-    event_watcher_t(_In_ HANDLE eventHandle, event_watcher_options optFlags, wistd::function<void()>&& callback)
+    /** Returns `size` bytes aligned to `alignment` (a power of two, at most max_alignment), committing more of the region
+    if needed. Returns nullptr when the reserved region is exhausted, the commit fails or the alignment is larger than
+    max_alignment; the arena remains usable for other requests. */
+    _Ret_opt_bytecap_(size) void* allocate(size_t size, size_t alignment = MEMORY_ALLOCATION_ALIGNMENT) WI_NOEXCEPT
     {
-        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
-        create(eventHandle, optFlags, wistd::move(callback));
-    }
+        WI_ASSERT((alignment != 0) && ((alignment & (alignment - 1)) == 0));
+        if (!m_base || (alignment > max_alignment) || (alignment > m_reserved))
+        {
+            return nullptr;
+        }
 
-    event_watcher_t(_In_ HANDLE eventHandle, wistd::function<void()>&& callback) :
-        event_watcher_t(eventHandle, event_watcher_options::none, wistd::move(callback))
-    {
+        const size_t start = (m_used + alignment - 1) & ~(alignment - 1);
+        if ((start > m_reserved) || (size > (m_reserved - start)))
+        {
+            return nullptr;
+        }
+
+        const size_t end = start + size;
+        if (end > m_committed)
+        {
+            size_t commitTo = m_reserved;
+            if ((m_reserved - end) > m_commitIncrement)
+            {
+                commitTo = ((end + m_commitIncrement - 1) / m_commitIncrement) * m_commitIncrement;
+            }
+            if (!::VirtualAlloc(m_base.get() + m_committed, commitTo - m_committed, MEM_COMMIT, PAGE_READWRITE))
+            {
+                return nullptr;
+            }
+            m_committed = commitTo;
+        }
+
+        m_used = end;
+        return m_base.get() + start;
     }
 
-    event_watcher_t(event_watcher_options optFlags, wistd::function<void()>&& callback)
+    //! Rewinds the arena. Memory stays committed for reuse; everything allocated so far must no longer be in use.
+    void reset() WI_NOEXCEPT
     {
-        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
-        create(optFlags, wistd::move(callback));
+        m_used = 0;
     }
 
-    event_watcher_t(wistd::function<void()>&& callback) : event_watcher_t(event_watcher_options::none, wistd::move(callback))
+    size_t used() const WI_NOEXCEPT
     {
+        return m_used;
     }
 
-    template <typename event_err_policy>
-    result create(
-        unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, event_err_policy>>&& eventHandle,
-        event_watcher_options optFlags,
-        wistd::function<void()>&& callback)
+    size_t committed() const WI_NOEXCEPT
     {
-        return err_policy::HResult(create_take_hevent_ownership(eventHandle.release(), optFlags, wistd::move(callback)));
+        return m_committed;
     }
 
-    template <typename event_err_policy>
-    result create(
-        unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, event_err_policy>>&& eventHandle,
-        wistd::function<void()>&& callback)
+    size_t reserved() const WI_NOEXCEPT
     {
-        return create(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback));
+        return m_reserved;
     }
 
-    // Creates the event that you will be watching.
-    result create(wistd::function<void()>&& callback)
+    explicit operator bool() const WI_NOEXCEPT
     {
-        return create(event_watcher_options::none, wistd::move(callback));
+        return static_cast<bool>(m_base);
     }
 
-    // Creates the event that you will be watching.
-    result create(event_watcher_options optFlags, wistd::function<void()>&& callback)
+private:
+    HRESULT create_nothrow(size_t reserveBytes, size_t commitIncrement) WI_NOEXCEPT
     {
-        unique_event_nothrow eventHandle;
-        HRESULT hr = eventHandle.create(EventOptions::ManualReset); // auto-reset is supported too.
-        if (FAILED(hr))
-        {
-            return err_policy::HResult(hr);
-        }
-        return err_policy::HResult(create_take_hevent_ownership(eventHandle.release(), optFlags, wistd::move(callback)));
+        RETURN_HR_IF(E_INVALIDARG, (reserveBytes == 0) || (commitIncrement == 0));
+        m_base.reset();
+        m_reserved = m_committed = m_used = 0;
+
+        m_base.reset(static_cast<BYTE*>(::VirtualAlloc(nullptr, reserveBytes, MEM_RESERVE, PAGE_NOACCESS)));
+        RETURN_LAST_ERROR_IF(!m_base);
+        m_reserved = reserveBytes;
+        m_commitIncrement = commitIncrement;
+        return S_OK;
     }
 
-    // Input is an event handler that is duplicated into this class.
-    result create(_In_ HANDLE eventHandle, wistd::function<void()>&& callback)
+    unique_virtualalloc_ptr<BYTE> m_base;
+    size_t m_reserved = 0;
+    size_t m_committed = 0;
+    size_t m_used = 0;
+    size_t m_commitIncrement = default_commit_increment;
+};
+
+typedef virtual_arena_t<err_returncode_policy> virtual_arena_nothrow;
+typedef virtual_arena_t<err_failfast_policy> virtual_arena_failfast;
+#ifdef WIL_ENABLE_EXCEPTIONS
+typedef virtual_arena_t<err_exception_policy> virtual_arena;
+#endif
+
+//! Destroys an object that lives in a @ref virtual_arena_t; the memory itself is reclaimed with the arena.
+struct arena_deleter
+{
+    template <typename T>
+    void operator()(_Pre_valid_ T* ptr) const
+    {
+        ptr->~T();
+    }
+};
+
+template <typename T>
+using unique_arena_ptr = wistd::unique_ptr<T, arena_deleter>;
+
+/** Provides `std::make_unique()` semantics for an object constructed in a @ref virtual_arena_t, returning null if the
+arena is exhausted. The pointer runs the destructor when it goes out of scope and must not outlive the arena (or its
+next `reset()`).
+@code
+wil::virtual_arena_nothrow arena;
+RETURN_IF_FAILED(arena.create(1024 * 1024));
+auto node = wil::make_unique_arena_nothrow<Node>(arena, 42);
+RETURN_IF_NULL_ALLOC(node);
+@endcode
+*/
+template <typename T, typename err_policy, typename... Args>
+inline typename wistd::enable_if<!wistd::is_array<T>::value, unique_arena_ptr<T>>::type make_unique_arena_nothrow(
+    virtual_arena_t<err_policy>& arena, Args&&... args)
+{
+    static_assert(alignof(T) <= virtual_arena_t<err_policy>::max_alignment, "the arena cannot align types beyond 64KB");
+    unique_arena_ptr<T> result;
+    if (auto memory = arena.allocate(sizeof(T), alignof(T)))
+    {
+        result.reset(new (memory) T(wistd::forward<Args>(args)...));
+    }
+    return result;
+}
+
+//! Like @ref make_unique_arena_nothrow, but fails fast if the arena is exhausted.
+template <typename T, typename err_policy, typename... Args>
+inline typename wistd::enable_if<!wistd::is_array<T>::value, unique_arena_ptr<T>>::type make_unique_arena_failfast(
+    virtual_arena_t<err_policy>& arena, Args&&... args)
+{
+    unique_arena_ptr<T> result(make_unique_arena_nothrow<T>(arena, wistd::forward<Args>(args)...));
+    FAIL_FAST_IF_NULL_ALLOC(result);
+    return result;
+}
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+//! Like @ref make_unique_arena_nothrow, but throws if the arena is exhausted.
+template <typename T, typename err_policy, typename... Args>
+inline typename wistd::enable_if<!wistd::is_array<T>::value, unique_arena_ptr<T>>::type make_unique_arena(
+    virtual_arena_t<err_policy>& arena, Args&&... args)
+{
+    unique_arena_ptr<T> result(make_unique_arena_nothrow<T>(arena, wistd::forward<Args>(args)...));
+    THROW_IF_NULL_ALLOC(result);
+    return result;
+}
+#endif // WIL_ENABLE_EXCEPTIONS
+
+/** Copies a string into a @ref virtual_arena_t, returning null if the arena is exhausted. The copy is owned by the arena
+and is never freed individually. Passing a null `source` allocates `length` zero-initialized characters. */
+template <typename err_policy>
+inline PWSTR make_arena_string_nothrow(
+    virtual_arena_t<err_policy>& arena,
+    _When_((source != nullptr) && length != static_cast<size_t>(-1), _In_reads_(length))
+        _When_((source != nullptr) && length == static_cast<size_t>(-1), _In_z_) PCWSTR source,
+    size_t length = static_cast<size_t>(-1)) WI_NOEXCEPT
+{
+    // guard against invalid parameters (null source with -1 length)
+    FAIL_FAST_IF(!source && (length == static_cast<size_t>(-1)));
+    if (length == static_cast<size_t>(-1))
+    {
+        length = wcslen(source);
+    }
+    if (length >= ((__WI_SIZE_MAX / sizeof(wchar_t)) - 1))
+    {
+        return nullptr;
+    }
+
+    const auto result = static_cast<PWSTR>(arena.allocate((length + 1) * sizeof(wchar_t), alignof(wchar_t)));
+    if (result != nullptr)
+    {
+        if (source != nullptr)
+        {
+            memcpy_s(result, (length + 1) * sizeof(wchar_t), source, length * sizeof(wchar_t));
+        }
+        else
+        {
+            ZeroMemory(result, length * sizeof(wchar_t));
+        }
+        result[length] = L'\0';
+    }
+    return result;
+}
+
+//! Like @ref make_arena_string_nothrow, but fails fast if the arena is exhausted.
+template <typename err_policy>
+inline PWSTR make_arena_string_failfast(
+    virtual_arena_t<err_policy>& arena,
+    _When_((source != nullptr) && length != static_cast<size_t>(-1), _In_reads_(length))
+        _When_((source != nullptr) && length == static_cast<size_t>(-1), _In_z_) PCWSTR source,
+    size_t length = static_cast<size_t>(-1)) WI_NOEXCEPT
+{
+    const auto result = make_arena_string_nothrow(arena, source, length);
+    FAIL_FAST_IF_NULL_ALLOC(result);
+    return result;
+}
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+//! Like @ref make_arena_string_nothrow, but throws if the arena is exhausted.
+template <typename err_policy>
+inline PWSTR make_arena_string(
+    virtual_arena_t<err_policy>& arena,
+    _When_((source != nullptr) && length != static_cast<size_t>(-1), _In_reads_(length))
+        _When_((source != nullptr) && length == static_cast<size_t>(-1), _In_z_) PCWSTR source,
+    size_t length = static_cast<size_t>(-1))
+{
+    const auto result = make_arena_string_nothrow(arena, source, length);
+    THROW_IF_NULL_ALLOC(result);
+    return result;
+}
+#endif // WIL_ENABLE_EXCEPTIONS
+
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN7)
+/** An item that can be queued on a @ref threadpool_batch_t. Derive from this class and implement run(). The item is
+not copied; it must stay valid until run() has been called (or until the batch is destroyed without running it). */
+class threadpool_batch_item
+{
+public:
+    virtual void run() WI_NOEXCEPT = 0;
+
+protected:
+    threadpool_batch_item() WI_NOEXCEPT = default;
+    ~threadpool_batch_item() = default;
+    threadpool_batch_item(const threadpool_batch_item&) = delete;
+    threadpool_batch_item& operator=(const threadpool_batch_item&) = delete;
+
+private:
+    template <typename>
+    friend class threadpool_batch_t;
+
+    // SLIST entries must be MEMORY_ALLOCATION_ALIGNMENT aligned and CONTAINING_RECORD needs a standard-layout type.
+    struct DECLSPEC_ALIGN(MEMORY_ALLOCATION_ALIGNMENT) entry_t
+    {
+        SLIST_ENTRY entry;
+        threadpool_batch_item* item;
+    };
+    entry_t m_entry{};
+};
+
+/** Runs many small work items with a single threadpool work object.
+Items are pushed onto a lock-free list (an SLIST) and submit() submits the one TP_WORK once per queued item, capped at the
+number of processors. Each callback keeps taking items until the list is empty, so a burst of items costs a handful of
+SubmitThreadpoolWork calls and callback dispatches rather than one of each per item. Items are not run in any particular
+order.
+~~~~
+struct hash_block : wil::threadpool_batch_item
+{
+    void run() WI_NOEXCEPT override { /* ... */ }
+};
+
+wil::threadpool_batch batch(nullptr);
+for (auto& block : blocks)
+{
+    batch.push(block);
+}
+batch.submit();
+batch.wait();
+~~~~
+The destructor waits for submitted callbacks to finish; items that were pushed but never taken are not run. */
+template <typename err_policy = err_exception_policy>
+class threadpool_batch_t
+{
+public:
+    // HRESULT or void error handling...
+    typedef typename err_policy::result result;
+
+    threadpool_batch_t() WI_NOEXCEPT
+    {
+        ::InitializeSListHead(&m_items);
+    }
+
+    // Exception-based constructor to create the batch on the given callback environment (nullptr for the default pool)
+    explicit threadpool_batch_t(_In_opt_ PTP_CALLBACK_ENVIRON environment)
+    {
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
+        ::InitializeSListHead(&m_items);
+        create(environment);
+    }
+
+    threadpool_batch_t(const threadpool_batch_t&) = delete;
+    threadpool_batch_t& operator=(const threadpool_batch_t&) = delete;
+
+    // Returns HRESULT for threadpool_batch_nothrow, void with exceptions for threadpool_batch
+    result create(_In_opt_ PTP_CALLBACK_ENVIRON environment = nullptr)
+    {
+        m_work.reset(::CreateThreadpoolWork(&threadpool_batch_t::work_callback, this, environment));
+        return err_policy::LastErrorIfFalse(!!m_work);
+    }
+
+    // Queues an item without starting any work; call submit() to have the threadpool run the queued items.
+    void push(threadpool_batch_item& item) WI_NOEXCEPT
+    {
+        item.m_entry.item = &item;
+        ::InterlockedPushEntrySList(&m_items, &item.m_entry.entry);
+        ::InterlockedIncrement(&m_unsubmitted);
+    }
+
+    // Submits one callback per item pushed since the last submit, up to maxCallbacks (0 means the processor count).
+    void submit(ULONG maxCallbacks = 0) WI_NOEXCEPT
+    {
+        __FAIL_FAST_ASSERT__(m_work);
+        const ULONG pending = static_cast<ULONG>(::InterlockedExchange(&m_unsubmitted, 0));
+        const ULONG limit = (maxCallbacks != 0) ? maxCallbacks : ::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+        for (ULONG i = 0; (i < pending) && (i < limit); ++i)
+        {
+            ::SubmitThreadpoolWork(m_work.get());
+        }
+    }
+
+    // Runs queued items on the calling thread until the list is empty, letting a waiting thread help instead of blocking.
+    void run_pending() WI_NOEXCEPT
+    {
+        for (auto entry = ::InterlockedPopEntrySList(&m_items); entry != nullptr; entry = ::InterlockedPopEntrySList(&m_items))
+        {
+            CONTAINING_RECORD(entry, threadpool_batch_item::entry_t, entry)->item->run();
+        }
+    }
+
+    // Waits for every submitted callback to finish. Items pushed after the last submit() may still be queued.
+    void wait() WI_NOEXCEPT
+    {
+        __FAIL_FAST_ASSERT__(m_work);
+        ::WaitForThreadpoolWorkCallbacks(m_work.get(), FALSE);
+    }
+
+private:
+    static void CALLBACK work_callback(PTP_CALLBACK_INSTANCE, void* context, PTP_WORK) WI_NOEXCEPT
+    {
+        static_cast<threadpool_batch_t*>(context)->run_pending();
+    }
+
+    SLIST_HEADER m_items;
+    LONG m_unsubmitted = 0;
+    unique_threadpool_work_nocancel m_work;
+};
+
+typedef threadpool_batch_t<err_returncode_policy> threadpool_batch_nothrow;
+typedef threadpool_batch_t<err_failfast_policy> threadpool_batch_failfast;
+#ifdef WIL_ENABLE_EXCEPTIONS
+typedef threadpool_batch_t<err_exception_policy> threadpool_batch;
+#endif
+
+/// @cond
+namespace details
+{
+    // parallel_for never uses more workers than this, which keeps its bookkeeping on the caller's stack.
+    constexpr ULONG parallel_for_max_workers = 64;
+
+    // Indices are handled as offsets from 'begin' in ULONG64. Converting to ULONG64 before subtracting keeps the count exact
+    // for any range of a signed or unsigned type of up to 64 bits, where 'end - begin' in TIndex could overflow.
+    template <typename TIndex>
+    ULONG64 parallel_for_count(TIndex begin, TIndex end) WI_NOEXCEPT
+    {
+        return static_cast<ULONG64>(end) - static_cast<ULONG64>(begin);
+    }
+
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure was padded due to alignment specifier
+    // The chunks initially assigned to one worker. Any worker may claim from any share, which is how idle workers steal.
+    struct DECLSPEC_CACHEALIGN parallel_for_share
+    {
+        LONG64 next;
+        LONG64 end;
+    };
+
+    template <typename TIndex, typename TFunc>
+    class parallel_for_state
+    {
+    public:
+        parallel_for_state(
+            TIndex begin, TIndex end, ULONG64 chunkSize, ULONG64 chunkCount, ULONG workerCount, TFunc& func) WI_NOEXCEPT
+            : m_begin(begin), m_end(end), m_chunkSize(chunkSize), m_workerCount(workerCount), m_func(func)
+        {
+            for (ULONG i = 0; i < workerCount; ++i)
+            {
+                m_shares[i].next = static_cast<LONG64>((chunkCount * i) / workerCount);
+                m_shares[i].end = static_cast<LONG64>((chunkCount * (i + 1)) / workerCount);
+                m_workers[i].m_state = this;
+                m_workers[i].m_index = i;
+            }
+        }
+
+        class worker final : public threadpool_batch_item
+        {
+        public:
+            void run() WI_NOEXCEPT override
+            {
+                m_state->run_worker(m_index);
+            }
+
+            parallel_for_state* m_state = nullptr;
+            ULONG m_index = 0;
+        };
+
+        worker& get_worker(ULONG index) WI_NOEXCEPT
+        {
+            return m_workers[index];
+        }
+
+    private:
+        // Drains this worker's own share first, then steals chunks from the other shares in turn.
+        void run_worker(ULONG index) WI_NOEXCEPT
+        {
+            for (ULONG offset = 0; offset < m_workerCount; ++offset)
+            {
+                auto& share = m_shares[(index + offset) % m_workerCount];
+                for (;;)
+                {
+                    const LONG64 chunk = ::InterlockedIncrement64(&share.next) - 1;
+                    if (chunk >= share.end)
+                    {
+                        break;
+                    }
+                    run_chunk(static_cast<ULONG64>(chunk));
+                }
+            }
+        }
+
+        void run_chunk(ULONG64 chunk) WI_NOEXCEPT
+        {
+            const ULONG64 count = parallel_for_count(m_begin, m_end);
+            const ULONG64 first = chunk * m_chunkSize;
+            const ULONG64 last = ((count - first) < m_chunkSize) ? count : (first + m_chunkSize);
+            for (ULONG64 i = first; i < last; ++i)
+            {
+                m_func(static_cast<TIndex>(static_cast<ULONG64>(m_begin) + i));
+            }
+        }
+
+        TIndex m_begin;
+        TIndex m_end;
+        ULONG64 m_chunkSize;
+        ULONG m_workerCount;
+        TFunc& m_func;
+        parallel_for_share m_shares[parallel_for_max_workers];
+        worker m_workers[parallel_for_max_workers];
+    };
+#pragma warning(pop)
+} // namespace details
+/// @endcond
+
+/** Calls `func(i)` for every i in [begin, end) using the threadpool and the calling thread.
+The range is split into chunks of `chunkSize` indices (0 picks about eight chunks per processor). Each worker owns a
+contiguous run of chunks and claims them with an interlocked increment; a worker that runs out steals chunks from the
+other workers, so uneven per-index costs still keep every processor busy. The calling thread works too, and the call
+returns once every index has been processed. `func` must be safe to call concurrently and must not throw. Fails only if
+the threadpool work object could not be created, in which case no index has been processed.
+~~~~
+std::vector<double> values(1000000);
+RETURN_IF_FAILED(wil::parallel_for_nothrow(size_t{0}, values.size(), [&](size_t i) {
+    values[i] = compute(i);
+}));
+~~~~ */
+template <typename TIndex, typename TFunc>
+HRESULT parallel_for_nothrow(
+    TIndex begin,
+    TIndex end,
+    TFunc&& func,
+    ULONG64 chunkSize = 0,
+    _In_opt_ PTP_CALLBACK_ENVIRON environment = nullptr) WI_NOEXCEPT
+{
+    static_assert(wistd::is_integral<TIndex>::value, "parallel_for requires an integral index type");
+    if (!(begin < end))
+    {
+        return S_OK;
+    }
+
+    const ULONG64 count = details::parallel_for_count(begin, end);
+    ULONG workerCount = ::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    workerCount = (workerCount < details::parallel_for_max_workers) ? workerCount : details::parallel_for_max_workers;
+    if (chunkSize == 0)
+    {
+        chunkSize = count / (static_cast<ULONG64>(workerCount) * 8);
+        chunkSize = (chunkSize != 0) ? chunkSize : 1;
+    }
+    const ULONG64 chunkCount = (count / chunkSize) + (((count % chunkSize) != 0) ? 1 : 0);
+    workerCount = (chunkCount < workerCount) ? static_cast<ULONG>(chunkCount) : workerCount;
+
+    if (workerCount <= 1)
+    {
+        for (TIndex i = begin; i < end; ++i)
+        {
+            func(i);
+        }
+        return S_OK;
+    }
+
+    typedef wistd::remove_reference_t<TFunc> func_t;
+    details::parallel_for_state<TIndex, func_t> state(begin, end, chunkSize, chunkCount, workerCount, func);
+    threadpool_batch_nothrow batch;
+    RETURN_IF_FAILED(batch.create(environment));
+    for (ULONG i = 1; i < workerCount; ++i)
+    {
+        batch.push(state.get_worker(i));
+    }
+    batch.submit(workerCount - 1);
+
+    // The calling thread takes worker 0 and then any workers the threadpool has not started yet; those find nothing left
+    // to steal and return at once, so the wait below only covers callbacks that are already running.
+    state.get_worker(0).run();
+    batch.run_pending();
+    batch.wait();
+    return S_OK;
+}
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+/** Same as @ref parallel_for_nothrow but throws if the threadpool work object could not be created. */
+template <typename TIndex, typename TFunc>
+void parallel_for(
+    TIndex begin, TIndex end, TFunc&& func, ULONG64 chunkSize = 0, _In_opt_ PTP_CALLBACK_ENVIRON environment = nullptr)
+{
+    THROW_IF_FAILED(parallel_for_nothrow(begin, end, wistd::forward<TFunc>(func), chunkSize, environment));
+}
+#endif // WIL_ENABLE_EXCEPTIONS
+#endif // WINAPI_PARTITION_DESKTOP && _WIN32_WINNT >= _WIN32_WINNT_WIN7
+
+class timer_wheel_entry;
+
+/// @cond
+namespace details
+{
+    // A node in one of the circular lists of a timer_wheel_t; each list is headed by a sentinel whose owner is null.
+    struct timer_wheel_link
+    {
+        timer_wheel_link* next;
+        timer_wheel_link* prev;
+        timer_wheel_entry* owner;
+
+        void init_sentinel() WI_NOEXCEPT
+        {
+            next = prev = this;
+            owner = nullptr;
+        }
+
+        bool empty() const WI_NOEXCEPT
+        {
+            return next == this;
+        }
+
+        void insert_tail(timer_wheel_link* link) WI_NOEXCEPT
+        {
+            link->next = this;
+            link->prev = prev;
+            prev->next = link;
+            prev = link;
+        }
+
+        void unlink() WI_NOEXCEPT
+        {
+            prev->next = next;
+            next->prev = prev;
+            next = prev = nullptr;
+        }
+    };
+
+    // Four levels of 64 slots cover 2^24 ticks (about 46 hours at 10ms); later timers are re-cascaded from the top level.
+    constexpr ULONG timer_wheel_level_bits = 6;
+    constexpr ULONG timer_wheel_slots = 1ul << timer_wheel_level_bits;
+    constexpr ULONG timer_wheel_levels = 4;
+    constexpr ULONG64 timer_wheel_range = 1ull << (timer_wheel_level_bits * timer_wheel_levels);
+} // namespace details
+/// @endcond
+
+/** A timer owned by the caller and scheduled on a @ref timer_wheel_t. Derive from this class and implement
+on_timer_expired(). An entry can be scheduled on one wheel at a time; it must not be destroyed while scheduled. */
+class timer_wheel_entry
+{
+public:
+    // Called on a threadpool thread, together with the other entries that expired on the same tick.
+    virtual void on_timer_expired() WI_NOEXCEPT = 0;
+
+protected:
+    timer_wheel_entry() WI_NOEXCEPT
+    {
+        m_link.owner = this;
+    }
+    ~timer_wheel_entry() = default;
+    timer_wheel_entry(const timer_wheel_entry&) = delete;
+    timer_wheel_entry& operator=(const timer_wheel_entry&) = delete;
+
+private:
+    template <typename, details::PendingCallbackCancellationBehavior>
+    friend class timer_wheel_t;
+
+    // next is non-null while the entry is linked into a wheel slot or the expired list.
+    details::timer_wheel_link m_link{};
+    ULONG64 m_expiry = 0;
+};
+
+/** Multiplexes many timers onto one threadpool timer.
+Entries live in a hierarchical timer wheel, so schedule() and cancel() take constant time whatever the number of pending
+timers. The threadpool timer only runs while timers are pending. It fires once per tick and delivers every entry that
+expired on that tick in one batch, rather than taking a callback per timer. Timers fire between their due time and about
+two ticks later; choose the tick to match the precision the timeouts need. Callbacks run on one thread at a time, so a
+slow callback delays the rest of its batch and any entries that expire while it runs.
+~~~~
+struct connection : wil::timer_wheel_entry
+{
+    void on_timer_expired() WI_NOEXCEPT override { abort(); }
+};
+
+wil::timer_wheel idleTimeouts(100); // 100ms ticks
+idleTimeouts.schedule(conn, 30 * 1000);
+// ... on activity
+idleTimeouts.schedule(conn, 30 * 1000); // pushes the timeout back
+// ... on close
+idleTimeouts.cancel(conn);
+~~~~
+Destruction stops the threadpool timer the same way unique_threadpool_timer (Cancel) or unique_threadpool_timer_nocancel
+(Wait) does. With Cancel, a batch being delivered stops after the current entry. With Wait, the batch is finished. Entries
+still scheduled are dropped without being called. The NoWait behavior is not supported because callbacks use the wheel. */
+template <
+    typename err_policy = err_exception_policy,
+    details::PendingCallbackCancellationBehavior cancellationBehavior = details::PendingCallbackCancellationBehavior::Cancel>
+class timer_wheel_t
+{
+    static_assert(cancellationBehavior != details::PendingCallbackCancellationBehavior::NoWait, "callbacks must be waited for");
+
+public:
+    // HRESULT or void error handling...
+    typedef typename err_policy::result result;
+
+    timer_wheel_t() WI_NOEXCEPT
+    {
+        initialize();
+    }
+
+    // Exception-based constructor to create the wheel with the given tick length
+    explicit timer_wheel_t(DWORD tickMilliseconds, _In_opt_ PTP_CALLBACK_ENVIRON environment = nullptr)
+    {
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
+        initialize();
+        create(tickMilliseconds, environment);
+    }
+
+    ~timer_wheel_t()
+    {
+        ::AcquireSRWLockExclusive(&m_lock);
+        m_stopping = true;
+        m_dropPending = (cancellationBehavior == details::PendingCallbackCancellationBehavior::Cancel);
+        ::ReleaseSRWLockExclusive(&m_lock);
+        m_timer.reset();
+
+        // Leave dropped entries unscheduled so that they can be destroyed or scheduled on another wheel.
+        for (auto& level : m_slots)
+        {
+            for (auto& slot : level)
+            {
+                clear(slot);
+            }
+        }
+        clear(m_expired);
+    }
+
+    timer_wheel_t(const timer_wheel_t&) = delete;
+    timer_wheel_t& operator=(const timer_wheel_t&) = delete;
+
+    // Returns HRESULT for timer_wheel_nothrow, void with exceptions for timer_wheel
+    result create(DWORD tickMilliseconds = 10, _In_opt_ PTP_CALLBACK_ENVIRON environment = nullptr)
+    {
+        __FAIL_FAST_ASSERT__(tickMilliseconds != 0);
+        m_tickMilliseconds = tickMilliseconds;
+        m_startTime = ::GetTickCount64();
+        m_timer.reset(::CreateThreadpoolTimer(&timer_wheel_t::timer_callback, this, environment));
+        return err_policy::LastErrorIfFalse(!!m_timer);
+    }
+
+    // Schedules the entry to expire after at least dueMilliseconds, replacing its previous due time if it was scheduled.
+    void schedule(timer_wheel_entry& entry, DWORD dueMilliseconds) WI_NOEXCEPT
+    {
+        __FAIL_FAST_ASSERT__(m_timer);
+        auto lock = wil::AcquireSRWLockExclusive(&m_lock);
+        const ULONG64 now = current_tick();
+        if (entry.m_link.next != nullptr)
+        {
+            entry.m_link.unlink();
+            --m_count;
+        }
+        else if ((m_count == 0) && !m_armed)
+        {
+            // Nothing is pending, so the ticks since the timer last ran need not be processed.
+            m_currentTick = now;
+        }
+
+        // One extra tick accounts for the part of the current tick that has already passed.
+        entry.m_expiry = now + 1 + ((static_cast<ULONG64>(dueMilliseconds) + m_tickMilliseconds - 1) / m_tickMilliseconds);
+        link(entry);
+        ++m_count;
+
+        if (!m_armed && !m_stopping)
+        {
+            const LONGLONG relativeDueTime = -static_cast<LONGLONG>(m_tickMilliseconds) * 10000;
+            FILETIME dueTime{static_cast<DWORD>(relativeDueTime), static_cast<DWORD>(relativeDueTime >> 32)};
+            ::SetThreadpoolTimer(m_timer.get(), &dueTime, m_tickMilliseconds, m_tickMilliseconds);
+            m_armed = true;
+        }
+    }
+
+    /** Cancels the entry. Returns true if it was scheduled (or expired but not yet delivered) and now will not be called.
+    If its callback is running on another thread, waits for it to return before returning false. */
+    bool cancel(timer_wheel_entry& entry) WI_NOEXCEPT
+    {
+        auto lock = wil::AcquireSRWLockExclusive(&m_lock);
+        if (entry.m_link.next != nullptr)
+        {
+            entry.m_link.unlink();
+            --m_count;
+            return true;
+        }
+        while ((m_running == &entry) && (m_runningThreadId != ::GetCurrentThreadId()))
+        {
+            ::SleepConditionVariableSRW(&m_runningChanged, &m_lock, INFINITE, 0);
+        }
+        return false;
+    }
+
+private:
+    void initialize() WI_NOEXCEPT
+    {
+        for (auto& level : m_slots)
+        {
+            for (auto& slot : level)
+            {
+                slot.init_sentinel();
+            }
+        }
+        m_expired.init_sentinel();
+    }
+
+    ULONG64 current_tick() const WI_NOEXCEPT
+    {
+        return (::GetTickCount64() - m_startTime) / m_tickMilliseconds;
+    }
+
+    static ULONG slot_index(ULONG64 tick, ULONG level) WI_NOEXCEPT
+    {
+        return static_cast<ULONG>((tick >> (details::timer_wheel_level_bits * level)) & (details::timer_wheel_slots - 1));
+    }
+
+    // Places the entry in the lowest level whose span covers its remaining ticks, as in a classic hierarchical wheel.
+    void link(timer_wheel_entry& entry) WI_NOEXCEPT
+    {
+        ULONG64 expiry = (entry.m_expiry > m_currentTick) ? entry.m_expiry : m_currentTick;
+        if ((expiry - m_currentTick) >= details::timer_wheel_range)
+        {
+            expiry = m_currentTick + details::timer_wheel_range - 1;
+        }
+
+        const ULONG64 delta = expiry - m_currentTick;
+        ULONG level = 0;
+        while ((level + 1 < details::timer_wheel_levels) && (delta >= (1ull << (details::timer_wheel_level_bits * (level + 1)))))
+        {
+            ++level;
+        }
+        m_slots[level][slot_index(expiry, level)].insert_tail(&entry.m_link);
+    }
+
+    // Moves the entries in one slot of a higher level down to the level (or expired list) that now covers them.
+    void cascade(ULONG level, ULONG slot) WI_NOEXCEPT
+    {
+        auto& head = m_slots[level][slot];
+        while (!head.empty())
+        {
+            auto node = head.next;
+            node->unlink();
+            link(*node->owner);
+        }
+    }
+
+    static void clear(details::timer_wheel_link& head) WI_NOEXCEPT
+    {
+        while (!head.empty())
+        {
+            head.next->unlink();
+        }
+    }
+
+    void process_tick(ULONG64 tick) WI_NOEXCEPT
+    {
+        for (ULONG level = 1; level < details::timer_wheel_levels; ++level)
+        {
+            if (slot_index(tick, level - 1) != 0)
+            {
+                break;
+            }
+            cascade(level, slot_index(tick, level));
+        }
+
+        auto& head = m_slots[0][slot_index(tick, 0)];
+        while (!head.empty())
+        {
+            auto node = head.next;
+            node->unlink();
+            m_expired.insert_tail(node);
+        }
+    }
+
+    static void CALLBACK timer_callback(PTP_CALLBACK_INSTANCE, void* context, PTP_TIMER) WI_NOEXCEPT
+    {
+        auto self = static_cast<timer_wheel_t*>(context);
+        ::AcquireSRWLockExclusive(&self->m_lock);
+        const ULONG64 now = self->current_tick();
+        for (; self->m_currentTick <= now; ++self->m_currentTick)
+        {
+            self->process_tick(self->m_currentTick);
+        }
+
+        // A tick that fires while another thread is still delivering only advances the wheel; that thread picks up the
+        // newly expired entries. Delivering on one thread at a time keeps m_running accurate for cancel().
+        if (self->m_delivering)
+        {
+            ::ReleaseSRWLockExclusive(&self->m_lock);
+            return;
+        }
+        self->m_delivering = true;
+
+        // Deliver the batch one entry at a time so cancel() can still remove entries that have not been called yet.
+        while (!self->m_expired.empty() && !self->m_dropPending)
+        {
+            auto node = self->m_expired.next;
+            node->unlink();
+            --self->m_count;
+            auto entry = node->owner;
+            self->m_running = entry;
+            self->m_runningThreadId = ::GetCurrentThreadId();
+            ::ReleaseSRWLockExclusive(&self->m_lock);
+            entry->on_timer_expired();
+            ::AcquireSRWLockExclusive(&self->m_lock);
+            self->m_running = nullptr;
+            ::WakeAllConditionVariable(&self->m_runningChanged);
+        }
+        self->m_delivering = false;
+
+        if ((self->m_count == 0) && self->m_armed)
+        {
+            ::SetThreadpoolTimer(self->m_timer.get(), nullptr, 0, 0);
+            self->m_armed = false;
+        }
+        ::ReleaseSRWLockExclusive(&self->m_lock);
+    }
+
+    SRWLOCK m_lock = SRWLOCK_INIT;
+    CONDITION_VARIABLE m_runningChanged = CONDITION_VARIABLE_INIT;
+    details::timer_wheel_link m_slots[details::timer_wheel_levels][details::timer_wheel_slots];
+    details::timer_wheel_link m_expired;
+    ULONG64 m_currentTick = 0;
+    ULONG64 m_startTime = 0;
+    DWORD m_tickMilliseconds = 0;
+    size_t m_count = 0;
+    timer_wheel_entry* m_running = nullptr;
+    DWORD m_runningThreadId = 0;
+    bool m_delivering = false;
+    bool m_armed = false;
+    bool m_stopping = false;
+    bool m_dropPending = false;
+    typedef wistd::conditional_t<
+        cancellationBehavior == details::PendingCallbackCancellationBehavior::Cancel,
+        unique_threadpool_timer,
+        unique_threadpool_timer_nocancel>
+        threadpool_timer_t;
+    threadpool_timer_t m_timer;
+};
+
+typedef timer_wheel_t<err_returncode_policy> timer_wheel_nothrow;
+typedef timer_wheel_t<err_failfast_policy> timer_wheel_failfast;
+typedef timer_wheel_t<err_returncode_policy, details::PendingCallbackCancellationBehavior::Wait> timer_wheel_nocancel_nothrow;
+#ifdef WIL_ENABLE_EXCEPTIONS
+typedef timer_wheel_t<err_exception_policy> timer_wheel;
+typedef timer_wheel_t<err_exception_policy, details::PendingCallbackCancellationBehavior::Wait> timer_wheel_nocancel;
+#endif
+
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN7)
+/** A private threadpool with its own threads, callback environment and cleanup group.
+Use it to keep latency-sensitive callbacks off the default process pool, where unrelated long-running work can hold every
+thread. The pool keeps at least `minThreads` threads alive and never grows past `maxThreads`.
+
+Objects made with the create_work(), create_wait(), create_timer() and create_io() methods, or by passing environment() to
+any API that takes a PTP_CALLBACK_ENVIRON (such as @ref threadpool_batch_t or @ref timer_wheel_t), run on this pool. They
+are owned by their unique_threadpool_* wrapper and may safely outlive this object; the pool is released once the last of
+them is closed. Objects created with group_environment() are instead owned by the cleanup group. They are closed together
+by close_group_members() or by the destructor, which cancels their pending callbacks and waits for running ones.
+~~~~
+wil::threadpool audioPool(1, 2, TP_CALLBACK_PRIORITY_HIGH);
+wil::unique_threadpool_timer mixTimer;
+audioPool.create_timer(mixTimer, &MixCallback, this);
+~~~~ */
+template <typename err_policy = err_exception_policy>
+class threadpool_t
+{
+public:
+    // HRESULT or void error handling...
+    typedef typename err_policy::result result;
+
+    threadpool_t() WI_NOEXCEPT = default;
+
+    // Exception-based constructor to create the pool
+    threadpool_t(DWORD minThreads, DWORD maxThreads, TP_CALLBACK_PRIORITY priority = TP_CALLBACK_PRIORITY_NORMAL)
+    {
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
+        create(minThreads, maxThreads, priority);
+    }
+
+    ~threadpool_t()
+    {
+        // Group members must be closed before the environments and pool they were created with.
+        m_cleanupGroup.reset();
+        if (m_pool)
+        {
+            ::DestroyThreadpoolEnvironment(&m_groupEnvironment);
+            ::DestroyThreadpoolEnvironment(&m_environment);
+        }
+    }
+
+    threadpool_t(const threadpool_t&) = delete;
+    threadpool_t& operator=(const threadpool_t&) = delete;
+
+    // Returns HRESULT for threadpool_nothrow, void with exceptions for threadpool
+    result create(DWORD minThreads, DWORD maxThreads, TP_CALLBACK_PRIORITY priority = TP_CALLBACK_PRIORITY_NORMAL)
+    {
+        return err_policy::HResult(create_nothrow(minThreads, maxThreads, priority));
+    }
+
+    WI_NODISCARD PTP_POOL get() const WI_NOEXCEPT
+    {
+        return m_pool.get();
+    }
+
+    // The environment for objects that are owned by their creator; they run on this pool at the configured priority.
+    WI_NODISCARD PTP_CALLBACK_ENVIRON environment() WI_NOEXCEPT
+    {
+        return &m_environment;
+    }
+
+    // The environment for objects owned by the cleanup group; never close them individually.
+    WI_NODISCARD PTP_CALLBACK_ENVIRON group_environment() WI_NOEXCEPT
+    {
+        return &m_groupEnvironment;
+    }
+
+    // Closes every object created with group_environment(), waiting for running callbacks.
+    void close_group_members(bool cancelPendingCallbacks = true) WI_NOEXCEPT
+    {
+        __FAIL_FAST_ASSERT__(m_cleanupGroup);
+        ::CloseThreadpoolCleanupGroupMembers(m_cleanupGroup.get(), cancelPendingCallbacks, nullptr);
+    }
+
+    template <typename unique_work_t = unique_threadpool_work>
+    result create_work(_Out_ unique_work_t& work, _In_ PTP_WORK_CALLBACK callback, _In_opt_ void* context = nullptr)
+    {
+        work.reset(::CreateThreadpoolWork(callback, context, environment()));
+        return err_policy::LastErrorIfFalse(!!work);
+    }
+
+    template <typename unique_wait_t = unique_threadpool_wait>
+    result create_wait(_Out_ unique_wait_t& wait, _In_ PTP_WAIT_CALLBACK callback, _In_opt_ void* context = nullptr)
+    {
+        wait.reset(::CreateThreadpoolWait(callback, context, environment()));
+        return err_policy::LastErrorIfFalse(!!wait);
+    }
+
+    template <typename unique_timer_t = unique_threadpool_timer>
+    result create_timer(_Out_ unique_timer_t& timer, _In_ PTP_TIMER_CALLBACK callback, _In_opt_ void* context = nullptr)
+    {
+        timer.reset(::CreateThreadpoolTimer(callback, context, environment()));
+        return err_policy::LastErrorIfFalse(!!timer);
+    }
+
+    template <typename unique_io_t = unique_threadpool_io>
+    result create_io(_Out_ unique_io_t& io, HANDLE file, _In_ PTP_WIN32_IO_CALLBACK callback, _In_opt_ void* context = nullptr)
+    {
+        io.reset(::CreateThreadpoolIo(file, callback, context, environment()));
+        return err_policy::LastErrorIfFalse(!!io);
+    }
+
+private:
+    HRESULT create_nothrow(DWORD minThreads, DWORD maxThreads, TP_CALLBACK_PRIORITY priority) WI_NOEXCEPT
+    {
+        __FAIL_FAST_ASSERT__(!m_pool);
+        unique_threadpool_pool pool(::CreateThreadpool(nullptr));
+        RETURN_LAST_ERROR_IF(!pool);
+        ::SetThreadpoolThreadMaximum(pool.get(), maxThreads);
+        RETURN_IF_WIN32_BOOL_FALSE(::SetThreadpoolThreadMinimum(pool.get(), minThreads));
+        unique_threadpool_cleanup_group cleanupGroup(::CreateThreadpoolCleanupGroup());
+        RETURN_LAST_ERROR_IF(!cleanupGroup);
+
+        ::InitializeThreadpoolEnvironment(&m_environment);
+        ::SetThreadpoolCallbackPool(&m_environment, pool.get());
+        ::SetThreadpoolCallbackPriority(&m_environment, priority);
+        m_groupEnvironment = m_environment;
+        ::SetThreadpoolCallbackCleanupGroup(&m_groupEnvironment, cleanupGroup.get(), nullptr);
+
+        m_pool = wistd::move(pool);
+        m_cleanupGroup = wistd::move(cleanupGroup);
+        return S_OK;
+    }
+
+    unique_threadpool_pool m_pool;
+    TP_CALLBACK_ENVIRON m_environment{};
+    TP_CALLBACK_ENVIRON m_groupEnvironment{};
+    unique_threadpool_cleanup_group m_cleanupGroup;
+};
+
+typedef threadpool_t<err_returncode_policy> threadpool_nothrow;
+typedef threadpool_t<err_failfast_policy> threadpool_failfast;
+#ifdef WIL_ENABLE_EXCEPTIONS
+typedef threadpool_t<err_exception_policy> threadpool;
+#endif
+#endif // WINAPI_PARTITION_DESKTOP && _WIN32_WINNT >= _WIN32_WINNT_WIN7
+
+#endif // __WIL_WINBASE_
+
+#if (defined(__WIL_WINBASE_) && defined(WIL_ENABLE_LOCK_CONTENTION_PROFILING) && defined(TraceLoggingWrite) && \
+     !defined(__WIL_LOCK_CONTENTION_TRACELOGGING)) ||                                                             \
+    defined(WIL_DOXYGEN)
+/// @cond
+#define __WIL_LOCK_CONTENTION_TRACELOGGING
+/// @endcond
+/** Writes a `LockContention` event to 'provider' for each lock reported by @ref for_each_lock_contention.
+Available when `WIL_ENABLE_LOCK_CONTENTION_PROFILING` is defined and TraceLoggingProvider.h is included. */
+inline void write_lock_contention_events(TraceLoggingHProvider provider) WI_NOEXCEPT
+{
+    for_each_lock_contention([&](const lock_contention_statistics& statistics) {
+        TraceLoggingWrite(
+            provider,
+            "LockContention",
+            TraceLoggingPointer(statistics.lock, "Lock"),
+            TraceLoggingString(statistics.lockType, "LockType"),
+            TraceLoggingUInt64(statistics.contentionCount, "ContentionCount"),
+            TraceLoggingUInt64(statistics.totalWaitMicroseconds, "TotalWaitMicroseconds"),
+            TraceLoggingUInt64(statistics.maxWaitMicroseconds, "MaxWaitMicroseconds"),
+            TraceLoggingPointer(statistics.lastContendedCallsite, "LastContendedCallsite"),
+            TraceLoggingUInt32(statistics.lastHolderThreadId, "LastHolderThreadId"));
+    });
+}
+#endif // __WIL_LOCK_CONTENTION_TRACELOGGING
+
+#if (defined(__WIL_WINBASE_) && defined(__NOTHROW_T_DEFINED) && !defined(__WIL_WINBASE_NOTHROW_T_DEFINED)) || defined(WIL_DOXYGEN)
+/// @cond
+#define __WIL_WINBASE_NOTHROW_T_DEFINED
+/// @endcond
+
+// unique_event_watcher, unique_event_watcher_nothrow, unique_event_watcher_failfast
+//
+// Clients must include <new> or <new.h> to enable use of this class as it uses new(std::nothrow).
+// This is to avoid the dependency on those headers that some clients can't tolerate.
+//
+// These classes makes it easy to execute a provided function when an event
+// is signaled. It will create the event handle for you, take ownership of one
+// or duplicate a handle provided. It supports the ability to signal the
+// event using SetEvent() and SetEvent_scope_exit();
+//
+// This can be used to support producer-consumer pattern
+// where a producer updates some state then signals the event when done.
+// The consumer will consume that state in the callback provided to unique_event_watcher.
+//
+// Note, multiple signals may coalesce into a single callback.
+//
+// Example use of throwing version:
+// auto globalStateWatcher = wil::make_event_watcher([]
+//     {
+//         currentState = GetGlobalState();
+//     });
+//
+// UpdateGlobalState(value);
+// globalStateWatcher.SetEvent(); // signal observers so they can update
+//
+// Example use of non-throwing version:
+// auto globalStateWatcher = wil::make_event_watcher_nothrow([]
+//     {
+//         currentState = GetGlobalState();
+//     });
+// RETURN_IF_NULL_ALLOC(globalStateWatcher);
+//
+// UpdateGlobalState(value);
+// globalStateWatcher.SetEvent(); // signal observers so they can update
+enum class event_watcher_options
+{
+    none = 0x0,
+    manual_reset = 0x1 << 0,
+    manual_start = 0x1 << 1,
+};
+
+DEFINE_ENUM_FLAG_OPERATORS(event_watcher_options);
+
+/// @cond
+namespace details
+{
+    struct event_watcher_state
+    {
+        wistd::function<void()> m_callback;
+        unique_event_nothrow m_event;
+        // The thread pool must be last to ensure that the other members are valid
+        // when it is destructed as it will reference them.
+        unique_threadpool_wait m_threadPoolWait;
+        event_watcher_options m_flags{event_watcher_options::none};
+    };
+
+    inline void delete_event_watcher_state(_In_opt_ event_watcher_state* watcherStorage)
+    {
+        delete watcherStorage;
+    }
+
+    typedef resource_policy<event_watcher_state*, decltype(&delete_event_watcher_state), delete_event_watcher_state, details::pointer_access_none> event_watcher_state_resource_policy;
+} // namespace details
+/// @endcond
+
+template <typename storage_t, typename err_policy = err_exception_policy>
+class event_watcher_t : public storage_t
+{
+public:
+    // forward all base class constructors...
+    template <typename... args_t>
+    explicit event_watcher_t(args_t&&... args) WI_NOEXCEPT : storage_t(wistd::forward<args_t>(args)...)
+    {
+    }
+
+    // HRESULT or void error handling...
+    typedef typename err_policy::result result;
+
+    // Exception-based constructors
+    template <typename from_err_policy>
+    event_watcher_t(
+        unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, from_err_policy>>&& eventHandle,
+        event_watcher_options optFlags,
+        wistd::function<void()>&& callback)
+    {
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
+        create(wistd::move(eventHandle), optFlags, wistd::move(callback));
+    }
+
+    template <typename from_err_policy>
+    event_watcher_t(
+        unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, from_err_policy>>&& eventHandle,
+        wistd::function<void()>&& callback) :
+        event_watcher_t(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback))
+    {
+    }
+
+    event_watcher_t(_In_ HANDLE eventHandle, event_watcher_options optFlags, wistd::function<void()>&& callback)
+    {
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
+        create(eventHandle, optFlags, wistd::move(callback));
+    }
+
+    event_watcher_t(_In_ HANDLE eventHandle, wistd::function<void()>&& callback) :
+        event_watcher_t(eventHandle, event_watcher_options::none, wistd::move(callback))
+    {
+    }
+
+    event_watcher_t(event_watcher_options optFlags, wistd::function<void()>&& callback)
+    {
+        static_assert(wistd::is_same<void, result>::value, "this constructor requires exceptions or fail fast; use the create method");
+        create(optFlags, wistd::move(callback));
+    }
+
+    event_watcher_t(wistd::function<void()>&& callback) : event_watcher_t(event_watcher_options::none, wistd::move(callback))
+    {
+    }
+
+    template <typename event_err_policy>
+    result create(
+        unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, event_err_policy>>&& eventHandle,
+        event_watcher_options optFlags,
+        wistd::function<void()>&& callback)
+    {
+        return err_policy::HResult(create_take_hevent_ownership(eventHandle.release(), optFlags, wistd::move(callback)));
+    }
+
+    template <typename event_err_policy>
+    result create(
+        unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, event_err_policy>>&& eventHandle,
+        wistd::function<void()>&& callback)
+    {
+        return create(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback));
+    }
+
+    // Creates the event that you will be watching.
+    result create(wistd::function<void()>&& callback)
+    {
+        return create(event_watcher_options::none, wistd::move(callback));
+    }
+
+    // Creates the event that you will be watching.
+    result create(event_watcher_options optFlags, wistd::function<void()>&& callback)
+    {
+        unique_event_nothrow eventHandle;
+        HRESULT hr = eventHandle.create(EventOptions::ManualReset); // auto-reset is supported too.
+        if (FAILED(hr))
+        {
+            return err_policy::HResult(hr);
+        }
+        return err_policy::HResult(create_take_hevent_ownership(eventHandle.release(), optFlags, wistd::move(callback)));
+    }
+
+    // Input is an event handler that is duplicated into this class.
+    result create(_In_ HANDLE eventHandle, wistd::function<void()>&& callback)
+    {
+        return create(eventHandle, event_watcher_options::none, wistd::move(callback));
+    }
+
+    result create(_In_ HANDLE eventHandle, event_watcher_options optFlags, wistd::function<void()>&& callback)
+    {
+        unique_event_nothrow ownedHandle;
+        if (!DuplicateHandle(GetCurrentProcess(), eventHandle, GetCurrentProcess(), &ownedHandle, 0, FALSE, DUPLICATE_SAME_ACCESS))
+        {
+            return err_policy::LastError();
+        }
+        return err_policy::HResult(create_take_hevent_ownership(ownedHandle.release(), optFlags, wistd::move(callback)));
+    }
+
+    // Provide access to the inner event and the very common SetEvent() method on it.
+    WI_NODISCARD unique_event_nothrow const& get_event() const WI_NOEXCEPT
+    {
+        return storage_t::get()->m_event;
+    }
+    void SetEvent() const WI_NOEXCEPT
+    {
+        storage_t::get()->m_event.SetEvent();
+    }
+
+    void start()
+    {
+        SetThreadpoolWait(storage_t::get()->m_threadPoolWait.get(), storage_t::get()->m_event.get(), nullptr);
+    }
+
+private:
+    // Had to move this from a Lambda so it would compile in C++/CLI (which thought the Lambda should be a managed function for some reason).
+    static void CALLBACK wait_callback(PTP_CALLBACK_INSTANCE, void* context, TP_WAIT* pThreadPoolWait, TP_WAIT_RESULT)
+    {
+        auto pThis = static_cast<details::event_watcher_state*>(context);
+        if (WI_IsFlagClear(pThis->m_flags, event_watcher_options::manual_reset))
+        {
+            // Manual events must be re-set to avoid missing the last notification.
+            pThis->m_event.ResetEvent();
+        }
+        // Call the client before re-arming to ensure that multiple callbacks don't
+        // run concurrently.
+        pThis->m_callback();
+        if (WI_IsFlagClear(pThis->m_flags, event_watcher_options::manual_start))
+        {
+            // Re-arm the wait only if not manual start.
+            SetThreadpoolWait(pThreadPoolWait, pThis->m_event.get(), nullptr);
+        }
+    }
+
+    // To avoid template expansion (if unique_event/unique_event_nothrow forms were used) this base
+    // create function takes a raw handle and assumes its ownership, even on failure.
+    HRESULT create_take_hevent_ownership(_In_ HANDLE rawHandleOwnershipTaken, event_watcher_options optFlags, wistd::function<void()>&& callback)
+    {
+        __FAIL_FAST_ASSERT__(rawHandleOwnershipTaken != nullptr); // invalid parameter
+        unique_event_nothrow eventHandle(rawHandleOwnershipTaken);
+        wistd::unique_ptr<details::event_watcher_state> watcherState(
+            new (std::nothrow) details::event_watcher_state{wistd::move(callback), wistd::move(eventHandle), nullptr, optFlags});
+        RETURN_IF_NULL_ALLOC(watcherState);
+
+        watcherState->m_threadPoolWait.reset(CreateThreadpoolWait(wait_callback, watcherState.get(), nullptr));
+        RETURN_LAST_ERROR_IF(!watcherState->m_threadPoolWait);
+        storage_t::reset(watcherState.release()); // no more failures after this, pass ownership
+        if (WI_IsFlagClear(optFlags, event_watcher_options::manual_start))
+        {
+            start();
+        }
+        return S_OK;
+    }
+};
+
+typedef unique_any_t<event_watcher_t<details::unique_storage<details::event_watcher_state_resource_policy>, err_returncode_policy>> unique_event_watcher_nothrow;
+typedef unique_any_t<event_watcher_t<details::unique_storage<details::event_watcher_state_resource_policy>, err_failfast_policy>> unique_event_watcher_failfast;
+
+template <typename err_policy>
+unique_event_watcher_nothrow make_event_watcher_nothrow(
+    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
+    event_watcher_options flags,
+    wistd::function<void()>&& callback) WI_NOEXCEPT
+{
+    unique_event_watcher_nothrow watcher;
+    watcher.create(wistd::move(eventHandle), flags, wistd::move(callback));
+    return watcher; // caller must test for success using if (watcher)
+}
+
+template <typename err_policy>
+unique_event_watcher_nothrow make_event_watcher_nothrow(
+    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
+    wistd::function<void()>&& callback) WI_NOEXCEPT
+{
+    return make_event_watcher_nothrow(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback));
+}
+
+inline unique_event_watcher_nothrow make_event_watcher_nothrow(
+    _In_ HANDLE eventHandle, event_watcher_options flags, wistd::function<void()>&& callback) WI_NOEXCEPT
+{
+    unique_event_watcher_nothrow watcher;
+    watcher.create(eventHandle, flags, wistd::move(callback));
+    return watcher; // caller must test for success using if (watcher)
+}
+
+inline unique_event_watcher_nothrow make_event_watcher_nothrow(_In_ HANDLE eventHandle, wistd::function<void()>&& callback) WI_NOEXCEPT
+{
+    return make_event_watcher_nothrow(eventHandle, event_watcher_options::none, wistd::move(callback));
+}
+
+inline unique_event_watcher_nothrow make_event_watcher_nothrow(event_watcher_options flags, wistd::function<void()>&& callback) WI_NOEXCEPT
+{
+    unique_event_watcher_nothrow watcher;
+    watcher.create(flags, wistd::move(callback));
+    return watcher; // caller must test for success using if (watcher)
+}
+
+inline unique_event_watcher_nothrow make_event_watcher_nothrow(wistd::function<void()>&& callback) WI_NOEXCEPT
+{
+    return make_event_watcher_nothrow(event_watcher_options::none, wistd::move(callback));
+}
+
+template <typename err_policy>
+unique_event_watcher_failfast make_event_watcher_failfast(
+    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
+    event_watcher_options flags,
+    wistd::function<void()>&& callback)
+{
+    return unique_event_watcher_failfast(wistd::move(eventHandle), flags, wistd::move(callback));
+}
+
+template <typename err_policy>
+unique_event_watcher_failfast make_event_watcher_failfast(
+    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
+    wistd::function<void()>&& callback)
+{
+    return make_event_watcher_failfast(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback));
+}
+
+inline unique_event_watcher_failfast make_event_watcher_failfast(
+    _In_ HANDLE eventHandle, event_watcher_options flags, wistd::function<void()>&& callback)
+{
+    return unique_event_watcher_failfast(eventHandle, flags, wistd::move(callback));
+}
+
+inline unique_event_watcher_failfast make_event_watcher_failfast(_In_ HANDLE eventHandle, wistd::function<void()>&& callback)
+{
+    return make_event_watcher_failfast(eventHandle, event_watcher_options::none, wistd::move(callback));
+}
+
+inline unique_event_watcher_failfast make_event_watcher_failfast(event_watcher_options flags, wistd::function<void()>&& callback)
+{
+    return unique_event_watcher_failfast(flags, wistd::move(callback));
+}
+
+inline unique_event_watcher_failfast make_event_watcher_failfast(wistd::function<void()>&& callback)
+{
+    return make_event_watcher_failfast(event_watcher_options::none, wistd::move(callback));
+}
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+typedef unique_any_t<event_watcher_t<details::unique_storage<details::event_watcher_state_resource_policy>, err_exception_policy>> unique_event_watcher;
+
+template <typename err_policy>
+unique_event_watcher make_event_watcher(
+    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
+    event_watcher_options flags,
+    wistd::function<void()>&& callback)
+{
+    return unique_event_watcher(wistd::move(eventHandle), flags, wistd::move(callback));
+}
+
+template <typename err_policy>
+unique_event_watcher make_event_watcher(
+    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
+    wistd::function<void()>&& callback)
+{
+    return make_event_watcher(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback));
+}
+
+inline unique_event_watcher make_event_watcher(_In_ HANDLE eventHandle, event_watcher_options flags, wistd::function<void()>&& callback)
+{
+    return unique_event_watcher(eventHandle, flags, wistd::move(callback));
+}
+
+inline unique_event_watcher make_event_watcher(_In_ HANDLE eventHandle, wistd::function<void()>&& callback)
+{
+    return make_event_watcher(eventHandle, event_watcher_options::none, wistd::move(callback));
+}
+
+inline unique_event_watcher make_event_watcher(event_watcher_options flags, wistd::function<void()>&& callback)
+{
+    return unique_event_watcher(flags, wistd::move(callback));
+}
+
+inline unique_event_watcher make_event_watcher(wistd::function<void()>&& callback)
+{
+    return make_event_watcher(event_watcher_options::none, wistd::move(callback));
+}
+#endif // WIL_ENABLE_EXCEPTIONS
+
+/// @cond
+namespace details
+{
+    struct event_watcher_group_block;
+
+    // One watched event in an event_watcher_group. The flags below are protected by the owning block's lock.
+    struct event_watcher_group_slot
     {
-        return create(eventHandle, event_watcher_options::none, wistd::move(callback));
-    }
+        event_watcher_group_block* block = nullptr;
+        wistd::function<void()> callback;
+        unique_event_nothrow event;
+        event_watcher_options flags{event_watcher_options::none};
+        ULONG running = 0; // callbacks that have been claimed from the block's pendingSlots and not yet returned
+        bool inUse = false;
+        bool armed = false;    // included in the block's wait
+        bool removing = false; // owner is closing the watcher
+    };
 
-    result create(_In_ HANDLE eventHandle, event_watcher_options optFlags, wistd::function<void()>&& callback)
+    // Up to MAXIMUM_WAIT_OBJECTS - 1 watchers share one wait thread (the remaining handle is 'control', used to ask it to
+    // rebuild its handle list) and one threadpool work object that runs the callbacks of every slot signaled since it last ran.
+    struct event_watcher_group_block
     {
-        unique_event_nothrow ownedHandle;
-        if (!DuplicateHandle(GetCurrentProcess(), eventHandle, GetCurrentProcess(), &ownedHandle, 0, FALSE, DUPLICATE_SAME_ACCESS))
+        static const DWORD slot_count = MAXIMUM_WAIT_OBJECTS - 1;
+
+        SRWLOCK lock = SRWLOCK_INIT;
+        CONDITION_VARIABLE changed = CONDITION_VARIABLE_INIT;
+        ULONG usedCount = 0;
+        ULONG requestedGeneration = 0; // bumped when a slot is removed
+        ULONG observedGeneration = 0;  // last generation the wait thread rebuilt its handle list for
+        bool exiting = false;
+        LONG64 pendingSlots = 0; // bitmask of slots whose callbacks should run; bits are only cleared under 'lock'
+        event_watcher_group_block* next = nullptr;
+        unique_event_nothrow control;
+        unique_threadpool_work_nocancel work;
+        unique_handle thread;
+        event_watcher_group_slot slots[slot_count];
+
+        void request_rebuild() WI_NOEXCEPT
         {
-            return err_policy::LastError();
+            control.SetEvent();
         }
-        return err_policy::HResult(create_take_hevent_ownership(ownedHandle.release(), optFlags, wistd::move(callback)));
+
+        static DWORD WINAPI wait_thread(_In_ void* context)
+        {
+            auto block = static_cast<event_watcher_group_block*>(context);
+            HANDLE handles[MAXIMUM_WAIT_OBJECTS];
+            DWORD slotIndexes[MAXIMUM_WAIT_OBJECTS];
+            for (;;)
+            {
+                DWORD handleCount = 1;
+                handles[0] = block->control.get();
+                ::AcquireSRWLockExclusive(&block->lock);
+                if (block->exiting)
+                {
+                    ::ReleaseSRWLockExclusive(&block->lock);
+                    return 0;
+                }
+                for (DWORD index = 0; index < slot_count; ++index)
+                {
+                    const auto& slot = block->slots[index];
+                    if (slot.inUse && slot.armed && !slot.removing)
+                    {
+                        handles[handleCount] = slot.event.get();
+                        slotIndexes[handleCount] = index;
+                        ++handleCount;
+                    }
+                }
+                block->observedGeneration = block->requestedGeneration;
+                ::ReleaseSRWLockExclusive(&block->lock);
+                ::WakeAllConditionVariable(&block->changed);
+
+                const DWORD status = ::WaitForMultipleObjects(handleCount, handles, FALSE, INFINITE);
+                __FAIL_FAST_ASSERT__(status < (WAIT_OBJECT_0 + handleCount));
+                if (status != WAIT_OBJECT_0)
+                {
+                    block->signal_slot(slotIndexes[status - WAIT_OBJECT_0]);
+                }
+            }
+        }
+
+        // Disarms a signaled slot and queues its callback; it is rearmed once the callback returns.
+        void signal_slot(DWORD index) WI_NOEXCEPT
+        {
+            auto& slot = slots[index];
+            ::AcquireSRWLockExclusive(&lock);
+            slot.armed = false;
+            const bool queue = !slot.removing;
+            if (queue)
+            {
+                if (WI_IsFlagClear(slot.flags, event_watcher_options::manual_reset))
+                {
+                    // Manual events must be re-set to avoid missing the last notification.
+                    slot.event.ResetEvent();
+                }
+                InterlockedOr64(&pendingSlots, static_cast<LONG64>(1ULL << index));
+            }
+            ::ReleaseSRWLockExclusive(&lock);
+            if (queue)
+            {
+                ::SubmitThreadpoolWork(work.get());
+            }
+        }
+
+        static void CALLBACK work_callback(PTP_CALLBACK_INSTANCE, _In_ void* context, PTP_WORK)
+        {
+            auto block = static_cast<event_watcher_group_block*>(context);
+            auto pending = static_cast<ULONG64>(ReadAcquire64(&block->pendingSlots));
+            for (DWORD index = 0; pending != 0; ++index, pending >>= 1)
+            {
+                if ((pending & 1) == 0)
+                {
+                    continue;
+                }
+
+                // Claim each callback just before running it, so that a watcher closed meanwhile (possibly by an earlier
+                // callback of this block) has already withdrawn it.
+                auto& slot = block->slots[index];
+                ::AcquireSRWLockExclusive(&block->lock);
+                const auto bit = static_cast<LONG64>(1ULL << index);
+                const bool claimed = (InterlockedAnd64(&block->pendingSlots, ~bit) & bit) != 0;
+                if (claimed)
+                {
+                    ++slot.running;
+                }
+                ::ReleaseSRWLockExclusive(&block->lock);
+                if (!claimed)
+                {
+                    continue;
+                }
+
+                // Call the client before re-arming to ensure that multiple callbacks don't run concurrently.
+                slot.callback();
+
+                ::AcquireSRWLockExclusive(&block->lock);
+                --slot.running;
+                const bool rearm = !slot.removing && WI_IsFlagClear(slot.flags, event_watcher_options::manual_start);
+                slot.armed = slot.armed || rearm;
+                ::ReleaseSRWLockExclusive(&block->lock);
+                ::WakeAllConditionVariable(&block->changed);
+                if (rearm)
+                {
+                    block->request_rebuild();
+                }
+            }
+        }
+    };
+
+    inline void close_event_watcher_group_slot(_In_opt_ event_watcher_group_slot* slot) WI_NOEXCEPT
+    {
+        if (slot == nullptr)
+        {
+            return;
+        }
+
+        // Withdraw a callback that is queued but has not started, then wait until the wait thread has stopped waiting on the
+        // event and any running callback has finished, as unique_threadpool_wait does for unique_event_watcher. Callbacks
+        // that have not started are not waited for, so one callback may close another watcher of the same block.
+        auto block = slot->block;
+        wistd::function<void()> callback;
+        unique_event_nothrow event;
+        ::AcquireSRWLockExclusive(&block->lock);
+        slot->removing = true;
+        InterlockedAnd64(&block->pendingSlots, ~static_cast<LONG64>(1ULL << (slot - block->slots)));
+        const ULONG generation = ++block->requestedGeneration;
+        block->request_rebuild();
+        while ((slot->running != 0) || (static_cast<LONG>(block->observedGeneration - generation) < 0))
+        {
+            ::SleepConditionVariableSRW(&block->changed, &block->lock, INFINITE, 0);
+        }
+        callback = wistd::move(slot->callback);
+        event = wistd::move(slot->event);
+        slot->inUse = false;
+        slot->armed = false;
+        slot->removing = false;
+        --block->usedCount;
+        ::ReleaseSRWLockExclusive(&block->lock);
+    }
+
+    typedef resource_policy<
+        event_watcher_group_slot*,
+        decltype(&close_event_watcher_group_slot),
+        close_event_watcher_group_slot,
+        details::pointer_access_none>
+        event_watcher_group_slot_resource_policy;
+} // namespace details
+/// @endcond
+
+/** A watcher created by @ref event_watcher_group. Offers the same `get_event()`, `SetEvent()` and `start()` members as
+`wil::unique_event_watcher`; releasing it stops watching and waits for any running callback to return. */
+template <typename storage_t>
+class group_event_watcher_t : public storage_t
+{
+public:
+    // forward all base class constructors...
+    template <typename... args_t>
+    explicit group_event_watcher_t(args_t&&... args) WI_NOEXCEPT : storage_t(wistd::forward<args_t>(args)...)
+    {
     }
 
-    // Provide access to the inner event and the very common SetEvent() method on it.
     WI_NODISCARD unique_event_nothrow const& get_event() const WI_NOEXCEPT
     {
-        return storage_t::get()->m_event;
+        return storage_t::get()->event;
     }
+
     void SetEvent() const WI_NOEXCEPT
     {
-        storage_t::get()->m_event.SetEvent();
+        storage_t::get()->event.SetEvent();
     }
 
-    void start()
+    // Arms the wait, typically for watchers created with event_watcher_options::manual_start. As with unique_event_watcher,
+    // starting from within the callback allows the next callback to begin before the current one returns.
+    void start() const WI_NOEXCEPT
     {
-        SetThreadpoolWait(storage_t::get()->m_threadPoolWait.get(), storage_t::get()->m_event.get(), nullptr);
+        auto slot = storage_t::get();
+        ::AcquireSRWLockExclusive(&slot->block->lock);
+        slot->armed = true;
+        ::ReleaseSRWLockExclusive(&slot->block->lock);
+        slot->block->request_rebuild();
     }
+};
 
-private:
-    // Had to move this from a Lambda so it would compile in C++/CLI (which thought the Lambda should be a managed function for some reason).
-    static void CALLBACK wait_callback(PTP_CALLBACK_INSTANCE, void* context, TP_WAIT* pThreadPoolWait, TP_WAIT_RESULT)
+typedef unique_any_t<group_event_watcher_t<details::unique_storage<details::event_watcher_group_slot_resource_policy>>>
+    unique_group_event_watcher;
+
+/** Watches many events with far fewer threadpool objects than one `wil::unique_event_watcher` per event.
+Each `wil::unique_event_watcher` owns a heap-allocated state, a `TP_WAIT` and a kernel wait registration. A group instead packs
+watchers into blocks of `MAXIMUM_WAIT_OBJECTS - 1`. Each block is a single allocation with one wait thread (a 64KB stack
+reservation) and one `TP_WORK` that runs the callbacks of every event signaled since it last ran. Callbacks keep the
+`unique_event_watcher` semantics: the event is reset first unless `event_watcher_options::manual_reset` is given, a watcher's
+callback never runs concurrently with itself, and the wait is re-armed after the callback returns unless
+`event_watcher_options::manual_start` is given. Blocks are reused as watchers come and go and are freed with the group, which
+must outlive every watcher it created.
+
+Fewer wait objects come at a cost. A block's callbacks run one after another on a single work item, so a slow callback
+delays every other signaled callback in its block (up to 62 of them); keep callbacks short or hand long work off to the
+threadpool. Every block also owns a dedicated thread, so 10,000 watchers use about 160 threads, where `unique_event_watcher`
+shares the threadpool's wait threads instead.
+~~~~
+wil::event_watcher_group connectionEvents;
+for (auto& connection : connections)
+{
+    connection.watcher = connectionEvents.make_event_watcher(connection.readyEvent.get(), [&connection] {
+        connection.OnReady();
+    });
+}
+~~~~ */
+class event_watcher_group
+{
+public:
+    event_watcher_group() = default;
+    event_watcher_group(const event_watcher_group&) = delete;
+    event_watcher_group& operator=(const event_watcher_group&) = delete;
+
+    ~event_watcher_group() WI_NOEXCEPT
     {
-        auto pThis = static_cast<details::event_watcher_state*>(context);
-        if (WI_IsFlagClear(pThis->m_flags, event_watcher_options::manual_reset))
+        while (m_blocks != nullptr)
         {
-            // Manual events must be re-set to avoid missing the last notification.
-            pThis->m_event.ResetEvent();
+            wistd::unique_ptr<details::event_watcher_group_block> block(m_blocks);
+            m_blocks = block->next;
+            __FAIL_FAST_ASSERT__(block->usedCount == 0); // every watcher must be released before its group
+            ::AcquireSRWLockExclusive(&block->lock);
+            block->exiting = true;
+            ::ReleaseSRWLockExclusive(&block->lock);
+            block->request_rebuild();
+            ::WaitForSingleObject(block->thread.get(), INFINITE);
         }
-        // Call the client before re-arming to ensure that multiple callbacks don't
-        // run concurrently.
-        pThis->m_callback();
-        if (WI_IsFlagClear(pThis->m_flags, event_watcher_options::manual_start))
+    }
+
+    // Watches a duplicate of 'eventHandle'; returns an empty watcher on failure.
+    unique_group_event_watcher make_event_watcher_nothrow(
+        _In_ HANDLE eventHandle, event_watcher_options flags, wistd::function<void()>&& callback) WI_NOEXCEPT
+    {
+        unique_group_event_watcher watcher;
+        unique_event_nothrow ownedHandle;
+        if (duplicate_event(eventHandle, ownedHandle))
         {
-            // Re-arm the wait only if not manual start.
-            SetThreadpoolWait(pThreadPoolWait, pThis->m_event.get(), nullptr);
+            LOG_IF_FAILED(add(wistd::move(ownedHandle), flags, wistd::move(callback), watcher));
         }
+        return watcher; // caller must test for success using if (watcher)
     }
 
-    // To avoid template expansion (if unique_event/unique_event_nothrow forms were used) this base
-    // create function takes a raw handle and assumes its ownership, even on failure.
-    HRESULT create_take_hevent_ownership(_In_ HANDLE rawHandleOwnershipTaken, event_watcher_options optFlags, wistd::function<void()>&& callback)
+    unique_group_event_watcher make_event_watcher_nothrow(_In_ HANDLE eventHandle, wistd::function<void()>&& callback) WI_NOEXCEPT
     {
-        __FAIL_FAST_ASSERT__(rawHandleOwnershipTaken != nullptr); // invalid parameter
-        unique_event_nothrow eventHandle(rawHandleOwnershipTaken);
-        wistd::unique_ptr<details::event_watcher_state> watcherState(
-            new (std::nothrow) details::event_watcher_state{wistd::move(callback), wistd::move(eventHandle), nullptr, optFlags});
-        RETURN_IF_NULL_ALLOC(watcherState);
+        return make_event_watcher_nothrow(eventHandle, event_watcher_options::none, wistd::move(callback));
+    }
 
-        watcherState->m_threadPoolWait.reset(CreateThreadpoolWait(wait_callback, watcherState.get(), nullptr));
-        RETURN_LAST_ERROR_IF(!watcherState->m_threadPoolWait);
-        storage_t::reset(watcherState.release()); // no more failures after this, pass ownership
-        if (WI_IsFlagClear(optFlags, event_watcher_options::manual_start))
+    // Creates the event that will be watched; it is available from the watcher's get_event().
+    unique_group_event_watcher make_event_watcher_nothrow(
+        event_watcher_options flags, wistd::function<void()>&& callback) WI_NOEXCEPT
+    {
+        unique_group_event_watcher watcher;
+        unique_event_nothrow eventHandle;
+        if (SUCCEEDED(eventHandle.create(EventOptions::ManualReset)))
         {
-            start();
+            LOG_IF_FAILED(add(wistd::move(eventHandle), flags, wistd::move(callback), watcher));
+        }
+        return watcher; // caller must test for success using if (watcher)
+    }
+
+    unique_group_event_watcher make_event_watcher_nothrow(wistd::function<void()>&& callback) WI_NOEXCEPT
+    {
+        return make_event_watcher_nothrow(event_watcher_options::none, wistd::move(callback));
+    }
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+    unique_group_event_watcher make_event_watcher(
+        _In_ HANDLE eventHandle, event_watcher_options flags, wistd::function<void()>&& callback)
+    {
+        unique_event_nothrow ownedHandle;
+        THROW_LAST_ERROR_IF(!duplicate_event(eventHandle, ownedHandle));
+        unique_group_event_watcher watcher;
+        THROW_IF_FAILED(add(wistd::move(ownedHandle), flags, wistd::move(callback), watcher));
+        return watcher;
+    }
+
+    unique_group_event_watcher make_event_watcher(_In_ HANDLE eventHandle, wistd::function<void()>&& callback)
+    {
+        return make_event_watcher(eventHandle, event_watcher_options::none, wistd::move(callback));
+    }
+
+    unique_group_event_watcher make_event_watcher(event_watcher_options flags, wistd::function<void()>&& callback)
+    {
+        unique_event_nothrow eventHandle;
+        THROW_IF_FAILED(eventHandle.create(EventOptions::ManualReset));
+        unique_group_event_watcher watcher;
+        THROW_IF_FAILED(add(wistd::move(eventHandle), flags, wistd::move(callback), watcher));
+        return watcher;
+    }
+
+    unique_group_event_watcher make_event_watcher(wistd::function<void()>&& callback)
+    {
+        return make_event_watcher(event_watcher_options::none, wistd::move(callback));
+    }
+#endif // WIL_ENABLE_EXCEPTIONS
+
+private:
+    static bool duplicate_event(_In_ HANDLE eventHandle, unique_event_nothrow& ownedHandle) WI_NOEXCEPT
+    {
+        return !!::DuplicateHandle(
+            GetCurrentProcess(), eventHandle, GetCurrentProcess(), &ownedHandle, 0, FALSE, DUPLICATE_SAME_ACCESS);
+    }
+
+    // Returns the first block with a free slot, with that block's lock held.
+    details::event_watcher_group_block* acquire_block_with_free_slot() WI_NOEXCEPT
+    {
+        for (auto block = m_blocks; block != nullptr; block = block->next)
+        {
+            ::AcquireSRWLockExclusive(&block->lock);
+            if (block->usedCount < details::event_watcher_group_block::slot_count)
+            {
+                return block;
+            }
+            ::ReleaseSRWLockExclusive(&block->lock);
+        }
+        return nullptr;
+    }
+
+    HRESULT add(
+        unique_event_nothrow&& eventHandle,
+        event_watcher_options flags,
+        wistd::function<void()>&& callback,
+        unique_group_event_watcher& watcher) WI_NOEXCEPT
+    {
+        auto lock = wil::AcquireSRWLockExclusive(&m_lock);
+        details::event_watcher_group_block* block = acquire_block_with_free_slot();
+        if (block == nullptr)
+        {
+            RETURN_IF_FAILED(create_block(block));
+            ::AcquireSRWLockExclusive(&block->lock);
+        }
+
+        details::event_watcher_group_slot* slot = block->slots;
+        while (slot->inUse)
+        {
+            ++slot;
         }
+        slot->block = block;
+        slot->callback = wistd::move(callback);
+        slot->event = wistd::move(eventHandle);
+        slot->flags = flags;
+        slot->inUse = true;
+        slot->armed = WI_IsFlagClear(flags, event_watcher_options::manual_start);
+        ++block->usedCount;
+        ::ReleaseSRWLockExclusive(&block->lock);
+
+        watcher.reset(slot);
+        block->request_rebuild();
+        return S_OK;
+    }
+
+    HRESULT create_block(details::event_watcher_group_block*& result) WI_NOEXCEPT
+    {
+        wistd::unique_ptr<details::event_watcher_group_block> block(new (std::nothrow) details::event_watcher_group_block());
+        RETURN_IF_NULL_ALLOC(block);
+        RETURN_IF_FAILED(block->control.create(EventOptions::None));
+        block->work.reset(::CreateThreadpoolWork(details::event_watcher_group_block::work_callback, block.get(), nullptr));
+        RETURN_LAST_ERROR_IF(!block->work);
+        block->thread.reset(::CreateThread(
+            nullptr,
+            64 * 1024,
+            details::event_watcher_group_block::wait_thread,
+            block.get(),
+            STACK_SIZE_PARAM_IS_A_RESERVATION,
+            nullptr));
+        RETURN_LAST_ERROR_IF(!block->thread);
+
+        block->next = m_blocks;
+        m_blocks = block.release();
+        result = m_blocks;
         return S_OK;
     }
+
+    SRWLOCK m_lock = SRWLOCK_INIT;
+    details::event_watcher_group_block* m_blocks = nullptr;
 };
 
-typedef unique_any_t<event_watcher_t<details::unique_storage<details::event_watcher_state_resource_policy>, err_returncode_policy>> unique_event_watcher_nothrow;
-typedef unique_any_t<event_watcher_t<details::unique_storage<details::event_watcher_state_resource_policy>, err_failfast_policy>> unique_event_watcher_failfast;
+/** Functions to wait for any number of handles.
 
-template <typename err_policy>
-unique_event_watcher_nothrow make_event_watcher_nothrow(
-    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
-    event_watcher_options flags,
-    wistd::function<void()>&& callback) WI_NOEXCEPT
-{
-    unique_event_watcher_nothrow watcher;
-    watcher.create(wistd::move(eventHandle), flags, wistd::move(callback));
-    return watcher; // caller must test for success using if (watcher)
-}
+wait_for_any() and wait_for_all(), and their _failfast and _nothrow variants, are the counterparts of wait_any() and
+wait_all() for handle arrays too large for WaitForMultipleObjects. They take a pointer and a count, for example
+`handles.data(), handles.size()` for a std::vector<HANDLE>, and return a wait_many_result whose index() refers to that
+array. Up to MAXIMUM_WAIT_OBJECTS handles are passed straight to WaitForMultipleObjects.
 
-template <typename err_policy>
-unique_event_watcher_nothrow make_event_watcher_nothrow(
-    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
-    wistd::function<void()>&& callback) WI_NOEXCEPT
+Beyond that, wait_for_any() waits for the first MAXIMUM_WAIT_OBJECTS - 1 handles on the calling thread and registers a
+threadpool wait for each of the rest. The first to fire wakes the caller. wait_for_all() waits for the handles in groups
+of MAXIMUM_WAIT_OBJECTS, one group after another, within the overall timeout. Neither wait is atomic across groups, and a
+threadpool wait consumes the signal of any handle it sees fire. Above MAXIMUM_WAIT_OBJECTS handles, use them only for
+objects whose wait has no side effect, such as processes, threads and manual-reset events, not mutexes, semaphores or
+auto-reset events.
+@code
+std::vector<HANDLE> processes = ...; // thousands of child processes
+auto result = wil::wait_for_any(processes.data(), processes.size());
+if (result)
 {
-    return make_event_watcher_nothrow(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback));
+    OnProcessExited(processes[result.index()]);
 }
-
-inline unique_event_watcher_nothrow make_event_watcher_nothrow(
-    _In_ HANDLE eventHandle, event_watcher_options flags, wistd::function<void()>&& callback) WI_NOEXCEPT
+@endcode
+*/
+struct wait_many_result : wait_result
 {
-    unique_event_watcher_nothrow watcher;
-    watcher.create(eventHandle, flags, wistd::move(callback));
-    return watcher; // caller must test for success using if (watcher)
-}
+    // status is WAIT_OBJECT_0, WAIT_ABANDONED_0, WAIT_TIMEOUT or WAIT_FAILED; the handle is identified by index alone.
+    constexpr wait_many_result(DWORD status = WAIT_FAILED, size_t index = 0) WI_NOEXCEPT : wait_result(status), m_index(index)
+    {
+    }
 
-inline unique_event_watcher_nothrow make_event_watcher_nothrow(_In_ HANDLE eventHandle, wistd::function<void()>&& callback) WI_NOEXCEPT
-{
-    return make_event_watcher_nothrow(eventHandle, event_watcher_options::none, wistd::move(callback));
-}
+    // This constructor is used for failure cases (WAIT_FAILED) only!
+    constexpr wait_many_result(HRESULT hr) WI_NOEXCEPT : wait_result(hr)
+    {
+    }
 
-inline unique_event_watcher_nothrow make_event_watcher_nothrow(event_watcher_options flags, wistd::function<void()>&& callback) WI_NOEXCEPT
+    WI_NODISCARD constexpr size_t index() const WI_NOEXCEPT
+    {
+        // index() should only be called if the object was signaled or abandoned.
+        if (!signaled() && !abandoned())
+        {
+            FAIL_FAST();
+        }
+        return m_index;
+    }
+
+private:
+    size_t m_index = 0;
+};
+
+/// @cond
+namespace details
 {
-    unique_event_watcher_nothrow watcher;
-    watcher.create(flags, wistd::move(callback));
-    return watcher; // caller must test for success using if (watcher)
-}
+    template <typename err_policy>
+    wait_many_result wait_many_failed(HRESULT hr)
+    {
+        err_policy::HResult(hr);
+        return wait_many_result{hr};
+    }
+
+    // Converts the status of a WaitForMultipleObjects call on handles[offset...] to a result for the whole array.
+    inline wait_many_result make_wait_many_result(DWORD status, size_t offset) WI_NOEXCEPT
+    {
+        if (status < (WAIT_OBJECT_0 + MAXIMUM_WAIT_OBJECTS))
+        {
+            return wait_many_result{static_cast<DWORD>(WAIT_OBJECT_0), offset + (status - WAIT_OBJECT_0)};
+        }
+        if ((status >= WAIT_ABANDONED_0) && (status < (WAIT_ABANDONED_0 + MAXIMUM_WAIT_OBJECTS)))
+        {
+            return wait_many_result{static_cast<DWORD>(WAIT_ABANDONED_0), offset + (status - WAIT_ABANDONED_0)};
+        }
+        return wait_many_result{status};
+    }
+
+    inline DWORD remaining_wait_milliseconds(DWORD timeout, ULONGLONG start) WI_NOEXCEPT
+    {
+        if (timeout == INFINITE)
+        {
+            return INFINITE;
+        }
+        const ULONGLONG elapsed = ::GetTickCount64() - start;
+        return (elapsed >= timeout) ? 0 : static_cast<DWORD>(timeout - elapsed);
+    }
+
+    template <typename err_policy>
+    wait_many_result wait_for_all_in_groups(_In_reads_(count) const HANDLE* handles, size_t count, DWORD timeout)
+    {
+        const ULONGLONG start = ::GetTickCount64();
+        wait_many_result result{static_cast<DWORD>(WAIT_OBJECT_0), 0};
+        for (size_t offset = 0; offset < count; offset += MAXIMUM_WAIT_OBJECTS)
+        {
+            const size_t remaining = count - offset;
+            const auto groupCount = static_cast<DWORD>((remaining < MAXIMUM_WAIT_OBJECTS) ? remaining : MAXIMUM_WAIT_OBJECTS);
+            const DWORD status =
+                ::WaitForMultipleObjects(groupCount, handles + offset, TRUE, remaining_wait_milliseconds(timeout, start));
+            if (status == WAIT_FAILED)
+            {
+                return wait_many_failed<err_policy>(HRESULT_FROM_WIN32(::GetLastError()));
+            }
+
+            const auto groupResult = make_wait_many_result(status, offset);
+            if (!groupResult)
+            {
+                return groupResult;
+            }
+            if (groupResult.abandoned() && !result.abandoned())
+            {
+                result = groupResult;
+            }
+        }
+        return result;
+    }
+
+    struct wait_for_any_state
+    {
+        LONG64 winner = -1;
+        DWORD status = WAIT_FAILED;
+        unique_event_nothrow done;
+    };
+
+    // One threadpool wait of wait_for_any_fanout; the first to fire records its index and wakes the caller.
+    struct wait_for_any_registration
+    {
+        wait_for_any_state* state = nullptr;
+        size_t index = 0;
+        unique_threadpool_wait wait;
+
+        static void CALLBACK callback(PTP_CALLBACK_INSTANCE, void* context, PTP_WAIT, TP_WAIT_RESULT waitResult) WI_NOEXCEPT
+        {
+            auto self = static_cast<wait_for_any_registration*>(context);
+            if (::InterlockedCompareExchange64(&self->state->winner, static_cast<LONG64>(self->index), -1) == -1)
+            {
+                self->state->status = waitResult;
+                self->state->done.SetEvent();
+            }
+        }
+    };
+
+    template <typename err_policy>
+    wait_many_result wait_for_any_fanout(_In_reads_(count) const HANDLE* handles, size_t count, DWORD timeout)
+    {
+        // The calling thread waits on the first handles itself, alongside the event set by the threadpool waits.
+        constexpr size_t directCount = MAXIMUM_WAIT_OBJECTS - 1;
+        wait_for_any_state state;
+        const HRESULT hr = state.done.create(EventOptions::ManualReset);
+        if (FAILED(hr))
+        {
+            return wait_many_failed<err_policy>(hr);
+        }
 
-inline unique_event_watcher_nothrow make_event_watcher_nothrow(wistd::function<void()>&& callback) WI_NOEXCEPT
-{
-    return make_event_watcher_nothrow(event_watcher_options::none, wistd::move(callback));
-}
+        // Declared after 'state' so that every threadpool wait is closed, and its callback finished, before 'state' goes away.
+        const size_t registrationCount = count - directCount;
+        wistd::unique_ptr<wait_for_any_registration[]> registrations(
+            new (std::nothrow) wait_for_any_registration[registrationCount]);
+        if (!registrations)
+        {
+            return wait_many_failed<err_policy>(E_OUTOFMEMORY);
+        }
+        for (size_t i = 0; i < registrationCount; ++i)
+        {
+            auto& registration = registrations[i];
+            registration.state = &state;
+            registration.index = directCount + i;
+            registration.wait.reset(::CreateThreadpoolWait(&wait_for_any_registration::callback, &registration, nullptr));
+            if (!registration.wait)
+            {
+                return wait_many_failed<err_policy>(HRESULT_FROM_WIN32(::GetLastError()));
+            }
+            ::SetThreadpoolWait(registration.wait.get(), handles[directCount + i], nullptr);
+        }
 
-template <typename err_policy>
-unique_event_watcher_failfast make_event_watcher_failfast(
-    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
-    event_watcher_options flags,
-    wistd::function<void()>&& callback)
-{
-    return unique_event_watcher_failfast(wistd::move(eventHandle), flags, wistd::move(callback));
-}
+        HANDLE waitHandles[MAXIMUM_WAIT_OBJECTS];
+        waitHandles[0] = state.done.get();
+        for (size_t i = 0; i < directCount; ++i)
+        {
+            waitHandles[i + 1] = handles[i];
+        }
 
-template <typename err_policy>
-unique_event_watcher_failfast make_event_watcher_failfast(
-    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
-    wistd::function<void()>&& callback)
-{
-    return make_event_watcher_failfast(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback));
-}
+        const DWORD status = ::WaitForMultipleObjects(ARRAYSIZE(waitHandles), waitHandles, FALSE, timeout);
+        if (status == WAIT_FAILED)
+        {
+            return wait_many_failed<err_policy>(HRESULT_FROM_WIN32(::GetLastError()));
+        }
+        if (status == WAIT_OBJECT_0)
+        {
+            return make_wait_many_result(state.status, static_cast<size_t>(state.winner));
+        }
 
-inline unique_event_watcher_failfast make_event_watcher_failfast(
-    _In_ HANDLE eventHandle, event_watcher_options flags, wistd::function<void()>&& callback)
-{
-    return unique_event_watcher_failfast(eventHandle, flags, wistd::move(callback));
-}
+        // waitHandles is offset by one from the caller's array because of the event in slot 0.
+        const auto result = make_wait_many_result(status, 0);
+        return result ? wait_many_result{result.status(), result.index() - 1} : result;
+    }
 
-inline unique_event_watcher_failfast make_event_watcher_failfast(_In_ HANDLE eventHandle, wistd::function<void()>&& callback)
-{
-    return make_event_watcher_failfast(eventHandle, event_watcher_options::none, wistd::move(callback));
-}
+    template <typename err_policy>
+    wait_many_result wait_for_many(_In_reads_(count) const HANDLE* handles, size_t count, bool waitAll, DWORD timeout)
+    {
+        __FAIL_FAST_ASSERT__(handles != nullptr);
+        __FAIL_FAST_ASSERT__(count > 0);
 
-inline unique_event_watcher_failfast make_event_watcher_failfast(event_watcher_options flags, wistd::function<void()>&& callback)
-{
-    return unique_event_watcher_failfast(flags, wistd::move(callback));
-}
+        if (count <= MAXIMUM_WAIT_OBJECTS)
+        {
+            const DWORD status = ::WaitForMultipleObjects(static_cast<DWORD>(count), handles, waitAll, timeout);
+            if (status == WAIT_FAILED)
+            {
+                return wait_many_failed<err_policy>(HRESULT_FROM_WIN32(::GetLastError()));
+            }
+            return make_wait_many_result(status, 0);
+        }
+        return waitAll ? wait_for_all_in_groups<err_policy>(handles, count, timeout)
+                       : wait_for_any_fanout<err_policy>(handles, count, timeout);
+    }
+} // namespace details
+/// @endcond
 
-inline unique_event_watcher_failfast make_event_watcher_failfast(wistd::function<void()>&& callback)
-{
-    return make_event_watcher_failfast(event_watcher_options::none, wistd::move(callback));
-}
+// exception throwing versions
 
 #ifdef WIL_ENABLE_EXCEPTIONS
-typedef unique_any_t<event_watcher_t<details::unique_storage<details::event_watcher_state_resource_policy>, err_exception_policy>> unique_event_watcher;
-
-template <typename err_policy>
-unique_event_watcher make_event_watcher(
-    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
-    event_watcher_options flags,
-    wistd::function<void()>&& callback)
+inline wait_many_result wait_for_any(_In_reads_(count) const HANDLE* handles, size_t count, DWORD timeout_milliseconds = INFINITE)
 {
-    return unique_event_watcher(wistd::move(eventHandle), flags, wistd::move(callback));
+    return details::wait_for_many<err_exception_policy>(handles, count, false, timeout_milliseconds);
 }
 
-template <typename err_policy>
-unique_event_watcher make_event_watcher(
-    unique_any_t<event_t<details::unique_storage<details::handle_resource_policy>, err_policy>>&& eventHandle,
-    wistd::function<void()>&& callback)
+inline wait_many_result wait_for_all(_In_reads_(count) const HANDLE* handles, size_t count, DWORD timeout_milliseconds = INFINITE)
 {
-    return make_event_watcher(wistd::move(eventHandle), event_watcher_options::none, wistd::move(callback));
+    return details::wait_for_many<err_exception_policy>(handles, count, true, timeout_milliseconds);
 }
+#endif // WIL_ENABLE_EXCEPTIONS
 
-inline unique_event_watcher make_event_watcher(_In_ HANDLE eventHandle, event_watcher_options flags, wistd::function<void()>&& callback)
+// fail_fast versions
+
+inline wait_many_result wait_for_any_failfast(
+    _In_reads_(count) const HANDLE* handles, size_t count, DWORD timeout_milliseconds = INFINITE) WI_NOEXCEPT
 {
-    return unique_event_watcher(eventHandle, flags, wistd::move(callback));
+    return details::wait_for_many<err_failfast_policy>(handles, count, false, timeout_milliseconds);
 }
 
-inline unique_event_watcher make_event_watcher(_In_ HANDLE eventHandle, wistd::function<void()>&& callback)
+inline wait_many_result wait_for_all_failfast(
+    _In_reads_(count) const HANDLE* handles, size_t count, DWORD timeout_milliseconds = INFINITE) WI_NOEXCEPT
 {
-    return make_event_watcher(eventHandle, event_watcher_options::none, wistd::move(callback));
+    return details::wait_for_many<err_failfast_policy>(handles, count, true, timeout_milliseconds);
 }
 
-inline unique_event_watcher make_event_watcher(event_watcher_options flags, wistd::function<void()>&& callback)
+// returncode versions
+
+inline wait_many_result wait_for_any_nothrow(
+    _In_reads_(count) const HANDLE* handles, size_t count, DWORD timeout_milliseconds = INFINITE) WI_NOEXCEPT
 {
-    return unique_event_watcher(flags, wistd::move(callback));
+    return details::wait_for_many<err_returncode_policy>(handles, count, false, timeout_milliseconds);
 }
 
-inline unique_event_watcher make_event_watcher(wistd::function<void()>&& callback)
+inline wait_many_result wait_for_all_nothrow(
+    _In_reads_(count) const HANDLE* handles, size_t count, DWORD timeout_milliseconds = INFINITE) WI_NOEXCEPT
 {
-    return make_event_watcher(event_watcher_options::none, wistd::move(callback));
+    return details::wait_for_many<err_returncode_policy>(handles, count, true, timeout_milliseconds);
 }
-#endif // WIL_ENABLE_EXCEPTIONS
 
 #endif // __WIL_WINBASE_NOTHROW_T_DEFINED
 
@@ -4614,6 +8037,10 @@ typedef shared_any<unique_hfile> shared_hfile;
 typedef shared_any<unique_handle> shared_handle;
 typedef shared_any<unique_hfind> shared_hfind;
 typedef shared_any<unique_hmodule> shared_hmodule;
+typedef shared_any_t<event_t<details::compact_shared_storage<unique_event>>> compact_shared_event;
+typedef shared_any_t<mutex_t<details::compact_shared_storage<unique_mutex>>> compact_shared_mutex;
+typedef shared_any_t<semaphore_t<details::compact_shared_storage<unique_semaphore>>> compact_shared_semaphore;
+typedef compact_shared_any<unique_handle> compact_shared_handle;
 
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 typedef shared_any<unique_threadpool_wait> shared_threadpool_wait;
@@ -4728,6 +8155,287 @@ inline auto make_process_heap_ansistring(
 }
 #endif // WIL_NO_ANSI_STRINGS
 #endif // WIL_ENABLE_EXCEPTIONS
+
+/** A heap created with `HeapCreate()`. Destroying it frees every allocation made from it at once, which suits a subsystem
+that makes many short-lived allocations and can drop them together. */
+typedef unique_any<HANDLE, decltype(&::HeapDestroy), ::HeapDestroy> unique_private_heap;
+
+//! Options for @ref create_private_heap_nothrow.
+enum class private_heap_options
+{
+    none = 0x0,
+    //! Skips the heap lock (`HEAP_NO_SERIALIZE`); the heap must only be used by one thread at a time. Such heaps cannot use
+    //! the low-fragmentation heap.
+    no_serialize = 0x1,
+};
+DEFINE_ENUM_FLAG_OPERATORS(private_heap_options);
+
+/// @cond
+namespace details
+{
+    inline HANDLE CreatePrivateHeap(private_heap_options options, size_t initialSize, size_t maximumSize) WI_NOEXCEPT
+    {
+        const bool noSerialize = WI_IsFlagSet(options, private_heap_options::no_serialize);
+        const auto heap = ::HeapCreate(noSerialize ? HEAP_NO_SERIALIZE : 0, initialSize, maximumSize);
+        if ((heap != nullptr) && !noSerialize && (maximumSize == 0))
+        {
+            // Growable heaps eventually switch to the low-fragmentation heap on their own; opt in from the start. This
+            // is only an optimization, so a failure is ignored.
+            ULONG lowFragmentationHeap = 2;
+            ::HeapSetInformation(heap, HeapCompatibilityInformation, &lowFragmentationHeap, sizeof(lowFragmentationHeap));
+        }
+        return heap;
+    }
+} // namespace details
+/// @endcond
+
+/** Creates a private heap, using the low-fragmentation heap unless `no_serialize` is requested or the heap has a maximum
+size. Returns an empty heap on failure; `GetLastError()` holds the reason. */
+inline unique_private_heap create_private_heap_nothrow(
+    private_heap_options options = private_heap_options::none, size_t initialSize = 0, size_t maximumSize = 0) WI_NOEXCEPT
+{
+    return unique_private_heap(details::CreatePrivateHeap(options, initialSize, maximumSize));
+}
+
+//! Creates a private heap, failing fast on failure. See @ref create_private_heap_nothrow.
+inline unique_private_heap create_private_heap_failfast(
+    private_heap_options options = private_heap_options::none, size_t initialSize = 0, size_t maximumSize = 0) WI_NOEXCEPT
+{
+    unique_private_heap heap(details::CreatePrivateHeap(options, initialSize, maximumSize));
+    FAIL_FAST_LAST_ERROR_IF(!heap);
+    return heap;
+}
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+//! Creates a private heap, throwing on failure. See @ref create_private_heap_nothrow.
+inline unique_private_heap create_private_heap(
+    private_heap_options options = private_heap_options::none, size_t initialSize = 0, size_t maximumSize = 0)
+{
+    unique_private_heap heap(details::CreatePrivateHeap(options, initialSize, maximumSize));
+    THROW_LAST_ERROR_IF(!heap);
+    return heap;
+}
+#endif // WIL_ENABLE_EXCEPTIONS
+
+//! Frees memory allocated from a private heap. Unlike process_heap_deleter, it carries the heap handle.
+struct private_heap_deleter
+{
+    HANDLE heap = nullptr;
+
+    template <typename T>
+    void operator()(_Pre_valid_ _Frees_ptr_ T* ptr) const
+    {
+        ::HeapFree(heap, 0, ptr);
+    }
+};
+
+template <typename T = void>
+using unique_private_heap_ptr = wistd::unique_ptr<details::ensure_trivially_destructible_t<T>, private_heap_deleter>;
+
+/** Provides `std::make_unique()` semantics for resources allocated from a private heap in a context that may not throw upon
+allocation failure. The returned pointer frees the memory back to `heap`, which must outlive it. See
+`wil::make_unique_hlocal_nothrow()` for more details.
+@code
+auto heap = wil::create_private_heap_nothrow();
+auto foo = wil::make_unique_private_heap_nothrow<Foo>(heap.get());
+@endcode
+*/
+template <typename T, typename... Args>
+inline typename wistd::enable_if<!wistd::is_array<T>::value, unique_private_heap_ptr<T>>::type make_unique_private_heap_nothrow(
+    HANDLE heap, Args&&... args)
+{
+    unique_private_heap_ptr<T> result(static_cast<T*>(::HeapAlloc(heap, 0, sizeof(T))), private_heap_deleter{heap});
+    if (result)
+    {
+        // use placement new to initialize memory from the previous allocation
+        new (result.get()) T(wistd::forward<Args>(args)...);
+    }
+    return result;
+}
+
+/** Provides `std::make_unique()` semantics for array resources allocated from a private heap in a context that may not throw
+upon allocation failure. See the overload of `wil::make_unique_private_heap_nothrow()` for non-array types for more details. */
+template <typename T>
+inline typename wistd::enable_if<wistd::is_array<T>::value && wistd::extent<T>::value == 0, unique_private_heap_ptr<T>>::type make_unique_private_heap_nothrow(
+    HANDLE heap, size_t size)
+{
+    typedef typename wistd::remove_extent<T>::type E;
+    FAIL_FAST_IF((__WI_SIZE_MAX / sizeof(E)) < size);
+    unique_private_heap_ptr<T> result(static_cast<E*>(::HeapAlloc(heap, 0, sizeof(E) * size)), private_heap_deleter{heap});
+    if (result)
+    {
+        for (auto& elem : make_range(static_cast<E*>(result.get()), size))
+        {
+            new (&elem) E();
+        }
+    }
+    return result;
+}
+
+/** Provides `std::make_unique()` semantics for resources allocated from a private heap in a context that must fail fast upon
+allocation failure. See the overload of `wil::make_unique_private_heap_nothrow()` for non-array types for more details. */
+template <typename T, typename... Args>
+inline typename wistd::enable_if<!wistd::is_array<T>::value, unique_private_heap_ptr<T>>::type make_unique_private_heap_failfast(
+    HANDLE heap, Args&&... args)
+{
+    unique_private_heap_ptr<T> result(make_unique_private_heap_nothrow<T>(heap, wistd::forward<Args>(args)...));
+    FAIL_FAST_IF_NULL_ALLOC(result);
+    return result;
+}
+
+/** Provides `std::make_unique()` semantics for array resources allocated from a private heap in a context that must fail fast
+upon allocation failure. See the overload of `wil::make_unique_private_heap_nothrow()` for non-array types for more details. */
+template <typename T>
+inline typename wistd::enable_if<wistd::is_array<T>::value && wistd::extent<T>::value == 0, unique_private_heap_ptr<T>>::type make_unique_private_heap_failfast(
+    HANDLE heap, size_t size)
+{
+    unique_private_heap_ptr<T> result(make_unique_private_heap_nothrow<T>(heap, size));
+    FAIL_FAST_IF_NULL_ALLOC(result);
+    return result;
+}
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+/** Provides `std::make_unique()` semantics for resources allocated from a private heap.
+See the overload of `wil::make_unique_private_heap_nothrow()` for non-array types for more details. */
+template <typename T, typename... Args>
+inline typename wistd::enable_if<!wistd::is_array<T>::value, unique_private_heap_ptr<T>>::type make_unique_private_heap(
+    HANDLE heap, Args&&... args)
+{
+    unique_private_heap_ptr<T> result(make_unique_private_heap_nothrow<T>(heap, wistd::forward<Args>(args)...));
+    THROW_IF_NULL_ALLOC(result);
+    return result;
+}
+
+/** Provides `std::make_unique()` semantics for array resources allocated from a private heap.
+See the overload of `wil::make_unique_private_heap_nothrow()` for non-array types for more details. */
+template <typename T>
+inline typename wistd::enable_if<wistd::is_array<T>::value && wistd::extent<T>::value == 0, unique_private_heap_ptr<T>>::type make_unique_private_heap(
+    HANDLE heap, size_t size)
+{
+    unique_private_heap_ptr<T> result(make_unique_private_heap_nothrow<T>(heap, size));
+    THROW_IF_NULL_ALLOC(result);
+    return result;
+}
+#endif // WIL_ENABLE_EXCEPTIONS
+
+/// @cond
+namespace details
+{
+    // Private heap strings store their heap handle just before the characters, so a plain close function can free them.
+    inline void __stdcall FreePrivateHeapString(_Pre_opt_valid_ _Frees_ptr_opt_ void* string) WI_NOEXCEPT
+    {
+        if (string != nullptr)
+        {
+            auto header = static_cast<HANDLE*>(string) - 1;
+            ::HeapFree(*header, 0, header);
+        }
+    }
+
+    // Copies up to length characters of source (or the whole string when length is -1) after the heap header.
+    template <typename string_type, typename char_type>
+    string_type make_private_heap_string_nothrow(HANDLE heap, const char_type* source, size_t length) WI_NOEXCEPT
+    {
+        // guard against invalid parameters (null source with -1 length)
+        FAIL_FAST_IF(!source && (length == static_cast<size_t>(-1)));
+
+        size_t lengthToCopy = length;
+        if (source)
+        {
+            size_t maxLength = length < MAKE_UNIQUE_STRING_MAX_CCH ? length : MAKE_UNIQUE_STRING_MAX_CCH;
+            auto endOfSource = source;
+            while (maxLength && (*endOfSource != 0))
+            {
+                endOfSource++;
+                maxLength--;
+            }
+            lengthToCopy = endOfSource - source;
+        }
+
+        if (length == static_cast<size_t>(-1))
+        {
+            length = lengthToCopy;
+        }
+        if (length >= ((__WI_SIZE_MAX - sizeof(HANDLE)) / sizeof(char_type)))
+        {
+            return string_type();
+        }
+
+        // The zeroed allocation terminates both the copied characters and the end of the buffer.
+        const size_t allocatedBytes = (length + 1) * sizeof(char_type);
+        auto header = static_cast<HANDLE*>(::HeapAlloc(heap, HEAP_ZERO_MEMORY, sizeof(HANDLE) + allocatedBytes));
+        if (header == nullptr)
+        {
+            return string_type();
+        }
+        *header = heap;
+        auto result = reinterpret_cast<char_type*>(header + 1);
+        if (source)
+        {
+            memcpy_s(result, allocatedBytes, source, lengthToCopy * sizeof(char_type));
+        }
+        return string_type(result);
+    }
+} // namespace details
+/// @endcond
+
+/** A string allocated from a private heap; it remembers its heap, so it can be freed without one being supplied. Create one
+with `make_private_heap_string_nothrow()` or its variants, which take the heap explicitly. The string_maker-based helpers
+cannot make these strings because they have no way to be told which heap to use.
+@code
+auto heap = wil::create_private_heap();
+auto name = wil::make_private_heap_string(heap.get(), L"name");
+@endcode
+*/
+typedef unique_any<PWSTR, decltype(&details::FreePrivateHeapString), details::FreePrivateHeapString> unique_private_heap_string;
+#ifndef WIL_NO_ANSI_STRINGS
+typedef unique_any<PSTR, decltype(&details::FreePrivateHeapString), details::FreePrivateHeapString>
+    unique_private_heap_ansistring;
+#endif // WIL_NO_ANSI_STRINGS
+
+//! Copies a string (up to the given length) into memory allocated from `heap`, returning null on failure.
+inline unique_private_heap_string make_private_heap_string_nothrow(
+    HANDLE heap,
+    _When_((source != nullptr) && length != static_cast<size_t>(-1), _In_reads_(length))
+        _When_((source != nullptr) && length == static_cast<size_t>(-1), _In_z_) PCWSTR source,
+    size_t length = static_cast<size_t>(-1)) WI_NOEXCEPT
+{
+    return details::make_private_heap_string_nothrow<unique_private_heap_string>(heap, source, length);
+}
+
+inline unique_private_heap_string make_private_heap_string_failfast(
+    HANDLE heap,
+    _When_((source != nullptr) && length != static_cast<size_t>(-1), _In_reads_(length))
+        _When_((source != nullptr) && length == static_cast<size_t>(-1), _In_z_) PCWSTR source,
+    size_t length = static_cast<size_t>(-1)) WI_NOEXCEPT
+{
+    auto result(make_private_heap_string_nothrow(heap, source, length));
+    FAIL_FAST_IF_NULL_ALLOC(result);
+    return result;
+}
+
+#ifndef WIL_NO_ANSI_STRINGS
+inline unique_private_heap_ansistring make_private_heap_ansistring_nothrow(
+    HANDLE heap,
+    _When_((source != nullptr) && length != static_cast<size_t>(-1), _In_reads_(length))
+        _When_((source != nullptr) && length == static_cast<size_t>(-1), _In_z_) PCSTR source,
+    size_t length = static_cast<size_t>(-1)) WI_NOEXCEPT
+{
+    return details::make_private_heap_string_nothrow<unique_private_heap_ansistring>(heap, source, length);
+}
+#endif // WIL_NO_ANSI_STRINGS
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+inline unique_private_heap_string make_private_heap_string(
+    HANDLE heap,
+    _When_((source != nullptr) && length != static_cast<size_t>(-1), _In_reads_(length))
+        _When_((source != nullptr) && length == static_cast<size_t>(-1), _In_z_) PCWSTR source,
+    size_t length = static_cast<size_t>(-1))
+{
+    auto result(make_private_heap_string_nothrow(heap, source, length));
+    THROW_IF_NULL_ALLOC(result);
+    return result;
+}
+#endif // WIL_ENABLE_EXCEPTIONS
 #endif // _HEAPAPI_H_
 
 #if (defined(__WIL_WINBASE_) && defined(__NOTHROW_T_DEFINED) && !defined(__WIL_WINBASE_NOTHROW_T_DEFINED_STL) && defined(WIL_RESOURCE_STL) && WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)) || \
@@ -8297,6 +12005,19 @@ namespace details
     {
     };
 
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+    // Specializations for sharded_rwlock
+    template <>
+    struct lock_proof_traits<sharded_rwlock_release_shared_scope_exit> : shared_lock_proof
+    {
+    };
+
+    template <>
+    struct lock_proof_traits<sharded_rwlock_release_exclusive_scope_exit> : exclusive_lock_proof
+    {
+    };
+#endif
+
     // Specialization for critical_section
     template <>
     struct lock_proof_traits<cs_leave_scope_exit> : exclusive_lock_proof
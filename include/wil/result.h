@@ -201,7 +201,7 @@ namespace details_abi
             WI_VERIFY_SUCCEEDED(StringCchCopyW(localName, ARRAYSIZE(localName), name));
             WI_VERIFY_SUCCEEDED(StringCchCatW(localName, ARRAYSIZE(localName), __WI_SEMAHPORE_VERSION));
 
-            wil::unique_semaphore_nothrow semaphoreLow(::OpenSemaphoreW(SEMAPHORE_ALL_ACCESS, FALSE, localName));
+            wil::details::cross_module_semaphore_nothrow semaphoreLow(::OpenSemaphoreW(SEMAPHORE_ALL_ACCESS, FALSE, localName));
             if (!semaphoreLow)
             {
                 __WIL_PRIVATE_RETURN_HR_IF(S_OK, (::GetLastError() == ERROR_FILE_NOT_FOUND));
@@ -216,7 +216,8 @@ namespace details_abi
             if (is64Bit)
             {
                 WI_VERIFY_SUCCEEDED(StringCchCatW(localName, ARRAYSIZE(localName), L"h"));
-                wil::unique_semaphore_nothrow semaphoreHigh(::OpenSemaphoreW(SEMAPHORE_ALL_ACCESS, FALSE, localName));
+                wil::details::cross_module_semaphore_nothrow semaphoreHigh(
+                    ::OpenSemaphoreW(SEMAPHORE_ALL_ACCESS, FALSE, localName));
                 __WIL_PRIVATE_RETURN_LAST_ERROR_IF_NULL(semaphoreHigh);
 
                 __WIL_PRIVATE_RETURN_IF_FAILED(GetValueFromSemaphore(semaphoreHigh.get(), &countHigh));
@@ -232,15 +233,15 @@ namespace details_abi
             return S_OK;
         }
 
-        wil::unique_semaphore_nothrow m_semaphore;
-        wil::unique_semaphore_nothrow m_semaphoreHigh;
+        wil::details::cross_module_semaphore_nothrow m_semaphore;
+        wil::details::cross_module_semaphore_nothrow m_semaphoreHigh;
     };
 
     template <typename T>
     class ProcessLocalStorageData
     {
     public:
-        ProcessLocalStorageData(unique_mutex_nothrow&& mutex, SemaphoreValue&& value) :
+        ProcessLocalStorageData(details::cross_module_mutex_nothrow&& mutex, SemaphoreValue&& value) :
             m_mutex(wistd::move(mutex)), m_value(wistd::move(value)), m_data()
         {
             static_assert(sizeof(m_mutex) == sizeof(HANDLE), "unique_any must be equivalent to the handle size to safely use across module");
@@ -291,7 +292,7 @@ namespace details_abi
             WI_VERIFY(SUCCEEDED(StringCchPrintfW(
                 name, ARRAYSIZE(name), L"Local\\SM0:%lu:%lu:%hs", ::GetCurrentProcessId(), size, staticNameWithVersion)));
 
-            unique_mutex_nothrow mutex;
+            details::cross_module_mutex_nothrow mutex;
             mutex.reset(::CreateMutexExW(nullptr, name, 0, MUTEX_ALL_ACCESS));
 
             // This will fail in some environments and will be fixed with deliverable 12394134
@@ -316,12 +317,14 @@ namespace details_abi
 
     private:
         volatile long m_refCount = 1;
-        unique_mutex_nothrow m_mutex;
+        details::cross_module_mutex_nothrow m_mutex;
         SemaphoreValue m_value;
         T m_data;
 
         static HRESULT MakeAndInitialize(
-            PCWSTR name, unique_mutex_nothrow&& mutex, _Outptr_result_nullonfailure_ ProcessLocalStorageData<T>** data)
+            PCWSTR name,
+            details::cross_module_mutex_nothrow&& mutex,
+            _Outptr_result_nullonfailure_ ProcessLocalStorageData<T>** data)
         {
             *data = nullptr;
 
@@ -886,16 +889,24 @@ namespace details
 
     __declspec(selectany) details_abi::ThreadLocalStorage<ThreadFailureCallbackHolder*>* g_pThreadFailureCallbacks = nullptr;
 
+    // Optionally invoked on the failing thread just before a call context is read, allowing its owner to defer work
+    // (such as formatting the context message) until a failure actually needs it.
+    typedef void(__stdcall* PrepareCallContextFn)(_Inout_ CallContextInfo* pCallContext) WI_PFN_NOEXCEPT;
+
     class ThreadFailureCallbackHolder
     {
     public:
         ThreadFailureCallbackHolder(
-            _In_opt_ IFailureCallback* pCallbackParam, _In_opt_ CallContextInfo* pCallContext = nullptr, bool watchNow = true) WI_NOEXCEPT
+            _In_opt_ IFailureCallback* pCallbackParam,
+            _In_opt_ CallContextInfo* pCallContext = nullptr,
+            bool watchNow = true,
+            _In_opt_ PrepareCallContextFn pfnPrepareCallContext = nullptr) WI_NOEXCEPT
             : m_ppThreadList(nullptr),
               m_pCallback(pCallbackParam),
               m_pNext(nullptr),
               m_threadId(0),
-              m_pCallContext(pCallContext)
+              m_pCallContext(pCallContext),
+              m_pfnPrepareCallContext(pfnPrepareCallContext)
         {
             if (watchNow)
             {
@@ -903,11 +914,13 @@ namespace details
             }
         }
 
-        ThreadFailureCallbackHolder(ThreadFailureCallbackHolder&& other) WI_NOEXCEPT : m_ppThreadList(nullptr),
-                                                                                       m_pCallback(other.m_pCallback),
-                                                                                       m_pNext(nullptr),
-                                                                                       m_threadId(0),
-                                                                                       m_pCallContext(other.m_pCallContext)
+        ThreadFailureCallbackHolder(ThreadFailureCallbackHolder&& other) WI_NOEXCEPT
+            : m_ppThreadList(nullptr),
+              m_pCallback(other.m_pCallback),
+              m_pNext(nullptr),
+              m_threadId(0),
+              m_pCallContext(other.m_pCallContext),
+              m_pfnPrepareCallContext(other.m_pfnPrepareCallContext)
         {
             if (other.m_threadId != 0)
             {
@@ -924,9 +937,10 @@ namespace details
             }
         }
 
-        void SetCallContext(_In_opt_ CallContextInfo* pCallContext)
+        void SetCallContext(_In_opt_ CallContextInfo* pCallContext, _In_opt_ PrepareCallContextFn pfnPrepareCallContext = nullptr)
         {
             m_pCallContext = pCallContext;
+            m_pfnPrepareCallContext = pfnPrepareCallContext;
         }
 
         CallContextInfo* CallContextInfo()
@@ -1014,6 +1028,11 @@ namespace details
                         context.contextId = ::InterlockedIncrementNoFence(&s_telemetryId);
                     }
 
+                    if (pCallback->m_pfnPrepareCallContext != nullptr)
+                    {
+                        pCallback->m_pfnPrepareCallContext(&context);
+                    }
+
                     if (pFailure->callContextOriginating.contextId == 0)
                     {
                         pFailure->callContextOriginating = context;
@@ -1084,6 +1103,7 @@ namespace details
         ThreadFailureCallbackHolder* m_pNext;
         DWORD m_threadId;
         wil::CallContextInfo* m_pCallContext;
+        PrepareCallContextFn m_pfnPrepareCallContext;
     };
 
     __declspec(selectany) long volatile ThreadFailureCallbackHolder::s_telemetryId = 1;
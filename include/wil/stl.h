@@ -22,6 +22,9 @@
 #if (__WI_LIBCPP_STD_VER >= 17) && WI_HAS_INCLUDE(<string_view>, 1) // Assume present if C++17
 #include <string_view>
 #endif
+#if (__WI_LIBCPP_STD_VER >= 17) && WI_HAS_INCLUDE(<memory_resource>, 1) // Assume present if C++17
+#include <memory_resource>
+#endif
 
 /// @cond
 #ifndef WI_STL_FAIL_FAST_IF
@@ -81,6 +84,247 @@ using secure_wstring = std::basic_string<wchar_t, std::char_traits<wchar_t>, wil
 //! `wil::secure_string` will be securely zeroed before deallocation.
 using secure_string = std::basic_string<char, std::char_traits<char>, wil::secure_allocator<char>>;
 
+#if defined(__WIL_WINBASE_) || defined(WIL_DOXYGEN)
+//! Options for @ref secure_pool.
+enum class secure_pool_options
+{
+    none = 0x0,
+    //! Locks the pool's pages with `VirtualLock` so their contents are never written to the page file. Locked pages count
+    //! against the process's minimum working set; raise it with `SetProcessWorkingSetSize` if allocations fail.
+    lock_pages = 0x1,
+};
+DEFINE_ENUM_FLAG_OPERATORS(secure_pool_options);
+
+/** A pool of zeroed memory for secrets that are allocated and freed often.
+Requests of up to 2KB are served from per-size-class free lists carved out of 64KB slabs, so freeing a buffer costs one
+`SecureZeroMemory` of the bytes that were handed out plus a list push, instead of a trip through the heap. Larger requests
+get pages of their own. Blocks are always zero when handed out, and all memory is zeroed again before it is returned to
+the system. The pool is thread-safe and must outlive every allocation made from it; use it through
+@ref secure_pool_allocator.
+@code
+wil::secure_pool pool(wil::secure_pool_options::lock_pages);
+wil::secure_pool_wstring password(wil::secure_pool_allocator<wchar_t>(pool));
+@endcode
+*/
+class secure_pool
+{
+public:
+    explicit secure_pool(secure_pool_options options = secure_pool_options::none) noexcept : m_options(options)
+    {
+    }
+
+    ~secure_pool()
+    {
+        for (auto slab : m_slabs)
+        {
+            release_region(slab, slab_size);
+        }
+    }
+
+    secure_pool(const secure_pool&) = delete;
+    secure_pool& operator=(const secure_pool&) = delete;
+
+    /** The pool used by default-constructed secure_pool_allocators. Its pages are not locked. It is never destroyed, so
+    containers with static storage duration can still free their buffers into it during process shutdown. */
+    static secure_pool& default_pool() noexcept
+    {
+        alignas(secure_pool) static unsigned char s_storage[sizeof(secure_pool)];
+        static secure_pool* const s_pool = new (s_storage) secure_pool();
+        return *s_pool;
+    }
+
+    //! Returns `bytes` of zeroed memory aligned to `alignment`, throwing on failure.
+    _Ret_bytecap_(bytes) void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+    {
+        const auto sizeClass = size_class_for((bytes < alignment) ? alignment : bytes);
+        if (sizeClass == size_class_count)
+        {
+            return allocate_region(round_to_pages(bytes));
+        }
+
+        auto lock = m_lock.lock_exclusive();
+        auto& head = m_freeLists[sizeClass];
+        if (head == nullptr)
+        {
+            refill(sizeClass);
+        }
+        auto block = head;
+        head = block->next;
+        block->next = nullptr;
+        return block;
+    }
+
+    //! Zeroes and frees memory returned by allocate(); `bytes` and `alignment` must match that call.
+    void deallocate(_Pre_valid_ _Frees_ptr_ void* ptr, size_t bytes, size_t alignment = alignof(std::max_align_t)) noexcept
+    {
+        const auto sizeClass = size_class_for((bytes < alignment) ? alignment : bytes);
+        if (sizeClass == size_class_count)
+        {
+            release_region(ptr, round_to_pages(bytes));
+            return;
+        }
+
+        // Only the caller's bytes can have been written; the rest of the block is still zero.
+        SecureZeroMemory(ptr, bytes);
+        auto block = static_cast<free_block*>(ptr);
+        auto lock = m_lock.lock_exclusive();
+        block->next = m_freeLists[sizeClass];
+        m_freeLists[sizeClass] = block;
+    }
+
+private:
+    struct free_block
+    {
+        free_block* next;
+    };
+
+    static constexpr size_t min_block_size = 16;
+    static constexpr size_t size_class_count = 8; // 16 bytes through 2KB
+    static constexpr size_t page_size = 4096;
+    static constexpr size_t slab_size = 64 * 1024;
+
+    static size_t size_class_for(size_t bytes) noexcept
+    {
+        size_t sizeClass = 0;
+        while ((sizeClass < size_class_count) && ((min_block_size << sizeClass) < bytes))
+        {
+            ++sizeClass;
+        }
+        return sizeClass;
+    }
+
+    static size_t round_to_pages(size_t bytes)
+    {
+        if (bytes > (__WI_SIZE_MAX - page_size))
+        {
+            throw std::bad_alloc();
+        }
+        return (bytes + page_size - 1) & ~(page_size - 1);
+    }
+
+    void* allocate_region(size_t bytes)
+    {
+        const auto region = ::VirtualAlloc(nullptr, bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+        if (region == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        if (WI_IsFlagSet(m_options, secure_pool_options::lock_pages) && !::VirtualLock(region, bytes))
+        {
+            const auto error = ::GetLastError();
+            ::VirtualFree(region, 0, MEM_RELEASE);
+            THROW_WIN32(error);
+        }
+        return region;
+    }
+
+    void release_region(void* region, size_t bytes) noexcept
+    {
+        SecureZeroMemory(region, bytes);
+        if (WI_IsFlagSet(m_options, secure_pool_options::lock_pages))
+        {
+            ::VirtualUnlock(region, bytes);
+        }
+        ::VirtualFree(region, 0, MEM_RELEASE);
+    }
+
+    // Splits one page from the current slab into blocks of the given size class. Called with the lock held.
+    void refill(size_t sizeClass)
+    {
+        if (m_slabs.empty() || (m_nextPage == (slab_size / page_size)))
+        {
+            // Grow the list first so that push_back cannot throw and leak the new slab.
+            if (m_slabs.size() == m_slabs.capacity())
+            {
+                m_slabs.reserve(m_slabs.empty() ? 4 : m_slabs.size() * 2);
+            }
+            m_slabs.push_back(static_cast<BYTE*>(allocate_region(slab_size)));
+            m_nextPage = 0;
+        }
+
+        const auto page = m_slabs.back() + (m_nextPage++ * page_size);
+        const auto blockSize = min_block_size << sizeClass;
+        for (size_t offset = page_size; offset != 0; offset -= blockSize)
+        {
+            auto block = reinterpret_cast<free_block*>(page + offset - blockSize);
+            block->next = m_freeLists[sizeClass];
+            m_freeLists[sizeClass] = block;
+        }
+    }
+
+    const secure_pool_options m_options;
+    srwlock m_lock;
+    free_block* m_freeLists[size_class_count]{};
+    std::vector<BYTE*> m_slabs;
+    size_t m_nextPage = 0;
+};
+
+/** Allocator for STL containers that draws from a @ref secure_pool.
+Like `wil::secure_allocator`, memory is zeroed when it is freed, but buffers are recycled through the pool rather than the
+heap and can be kept out of the page file. Note that `std::basic_string` keeps short strings inside the string object
+itself; only its heap buffers come from the pool. */
+template <typename T>
+struct secure_pool_allocator
+{
+    using value_type = T;
+
+    secure_pool_allocator() noexcept : m_pool(&secure_pool::default_pool())
+    {
+    }
+
+    explicit secure_pool_allocator(secure_pool& pool) noexcept : m_pool(&pool)
+    {
+    }
+
+    template <typename U>
+    secure_pool_allocator(const secure_pool_allocator<U>& other) noexcept : m_pool(&other.pool())
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (n > (__WI_SIZE_MAX / sizeof(T)))
+        {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(m_pool->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        m_pool->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    secure_pool& pool() const noexcept
+    {
+        return *m_pool;
+    }
+
+    template <typename U>
+    bool operator==(const secure_pool_allocator<U>& other) const noexcept
+    {
+        return m_pool == &other.pool();
+    }
+
+    template <typename U>
+    bool operator!=(const secure_pool_allocator<U>& other) const noexcept
+    {
+        return m_pool != &other.pool();
+    }
+
+private:
+    secure_pool* m_pool;
+};
+
+//! A vector whose buffers come from a @ref secure_pool.
+template <typename Type>
+using secure_pool_vector = std::vector<Type, secure_pool_allocator<Type>>;
+//! A wide string whose heap buffers come from a @ref secure_pool.
+using secure_pool_wstring = std::basic_string<wchar_t, std::char_traits<wchar_t>, wil::secure_pool_allocator<wchar_t>>;
+//! A string whose heap buffers come from a @ref secure_pool.
+using secure_pool_string = std::basic_string<char, std::char_traits<char>, wil::secure_pool_allocator<char>>;
+#endif // __WIL_WINBASE_
+
 /// @cond
 namespace details
 {
@@ -119,6 +363,51 @@ namespace details
             return value.c_str();
         }
 
+        // Appends in place, growing the capacity geometrically so that repeated concatenation stays amortized linear.
+        // Pieces that point into 'value' itself are instead copied into a new string.
+        static HRESULT append(std::wstring& value, _In_reads_(strCount) string_view_t const* strList, size_t strCount) WI_NOEXCEPT
+        try
+        {
+            auto const valueBegin = value.data();
+            auto const valueEnd = valueBegin + value.size();
+            auto length = value.size();
+            auto aliased = false;
+            for (auto& string : make_range(strList, strCount))
+            {
+                length += string.length;
+                aliased = aliased || ((string.data >= valueBegin) && (string.data <= valueEnd));
+            }
+
+            if (aliased)
+            {
+                std::wstring result;
+                result.reserve(length);
+                result.append(value);
+                for (auto& string : make_range(strList, strCount))
+                {
+                    result.append(string.data, string.length);
+                }
+                value = std::move(result);
+            }
+            else
+            {
+                auto const grownCapacity = value.capacity() + value.capacity() / 2;
+                if (length > value.capacity())
+                {
+                    value.reserve((length > grownCapacity) ? length : grownCapacity);
+                }
+                for (auto& string : make_range(strList, strCount))
+                {
+                    value.append(string.data, string.length);
+                }
+            }
+            return S_OK;
+        }
+        catch (...)
+        {
+            return E_OUTOFMEMORY;
+        }
+
     private:
         std::wstring m_value;
     };
@@ -383,6 +672,196 @@ overloaded(T...) -> overloaded<T...>;
 
 #endif // __WI_LIBCPP_STD_VER >= 17
 
+#if __cpp_lib_memory_resource >= 201603L
+/// @cond
+namespace details
+{
+    // A memory_resource over a malloc-like allocator that only guarantees MEMORY_ALLOCATION_ALIGNMENT. Stricter alignments
+    // over-allocate and keep the allocator's pointer just ahead of the aligned block.
+    template <typename allocator_t>
+    class allocator_memory_resource : public std::pmr::memory_resource
+    {
+    public:
+        explicit allocator_memory_resource(allocator_t allocator = {}) noexcept : m_allocator(allocator)
+        {
+        }
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            if (alignment <= MEMORY_ALLOCATION_ALIGNMENT)
+            {
+                return allocate_or_throw(bytes);
+            }
+
+            constexpr size_t header = sizeof(void*);
+            if (bytes > (__WI_SIZE_MAX - header - alignment))
+            {
+                throw std::bad_alloc();
+            }
+            const auto raw = allocate_or_throw(bytes + header + alignment - 1);
+            const auto aligned = (reinterpret_cast<uintptr_t>(raw) + header + alignment - 1) & ~(uintptr_t{alignment} - 1);
+            reinterpret_cast<void**>(aligned)[-1] = raw;
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        void do_deallocate(void* ptr, size_t /*bytes*/, size_t alignment) override
+        {
+            m_allocator.free((alignment <= MEMORY_ALLOCATION_ALIGNMENT) ? ptr : static_cast<void**>(ptr)[-1]);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+    private:
+        void* allocate_or_throw(size_t bytes)
+        {
+            const auto result = m_allocator.allocate(bytes);
+            if (result == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+            return result;
+        }
+
+        allocator_t m_allocator;
+    };
+
+#if defined(__WIL__WIL_HEAP_API)
+    struct heap_memory_allocator
+    {
+        HANDLE heap = ::GetProcessHeap();
+
+        void* allocate(size_t bytes) const noexcept
+        {
+            return ::HeapAlloc(heap, 0, bytes);
+        }
+
+        void free(void* ptr) const noexcept
+        {
+            ::HeapFree(heap, 0, ptr);
+        }
+    };
+#endif // __WIL__WIL_HEAP_API
+
+#if defined(__WIL_WINBASE_)
+    struct hlocal_memory_allocator
+    {
+        static void* allocate(size_t bytes) noexcept
+        {
+            return ::LocalAlloc(LMEM_FIXED, bytes);
+        }
+
+        static void free(void* ptr) noexcept
+        {
+            ::LocalFree(ptr);
+        }
+    };
+#endif // __WIL_WINBASE_
+
+#if defined(__WIL__COMBASEAPI_H_)
+    struct cotaskmem_memory_allocator
+    {
+        static void* allocate(size_t bytes) noexcept
+        {
+            return ::CoTaskMemAlloc(bytes);
+        }
+
+        static void free(void* ptr) noexcept
+        {
+            ::CoTaskMemFree(ptr);
+        }
+    };
+#endif // __WIL__COMBASEAPI_H_
+} // namespace details
+/// @endcond
+
+// Memory resources that let std::pmr containers draw from the same allocation families as WIL's smart pointers, so a
+// subsystem can switch allocation strategy without changing its container types. The process-wide resources are
+// singletons, like std::pmr::new_delete_resource(); pass one to a container or make it the default with
+// std::pmr::set_default_resource(). All of them throw std::bad_alloc on failure.
+//
+// Example:
+//        std::pmr::vector<int> values(wil::process_heap_resource());
+//        auto heap = wil::create_private_heap(wil::private_heap_options::no_serialize);
+//        wil::private_heap_resource heapResource(heap.get());
+//        std::pmr::unordered_map<int, std::pmr::wstring> names(&heapResource);
+//
+#if defined(__WIL__WIL_HEAP_API)
+//! Returns a memory_resource that allocates with HeapAlloc from the process heap.
+inline std::pmr::memory_resource* process_heap_resource() noexcept
+{
+    static details::allocator_memory_resource<details::heap_memory_allocator> s_resource;
+    return &s_resource;
+}
+
+//! A memory_resource that allocates from a heap, typically a @ref unique_private_heap. The heap must outlive it.
+class private_heap_resource : public details::allocator_memory_resource<details::heap_memory_allocator>
+{
+public:
+    explicit private_heap_resource(HANDLE heap) noexcept :
+        details::allocator_memory_resource<details::heap_memory_allocator>(details::heap_memory_allocator{heap})
+    {
+    }
+};
+#endif // __WIL__WIL_HEAP_API
+
+#if defined(__WIL_WINBASE_)
+//! Returns a memory_resource that allocates with LocalAlloc.
+inline std::pmr::memory_resource* hlocal_resource() noexcept
+{
+    static details::allocator_memory_resource<details::hlocal_memory_allocator> s_resource;
+    return &s_resource;
+}
+
+/** A memory_resource over a @ref virtual_arena_t. Deallocation is a no-op; memory is reclaimed when the arena is reset or
+destroyed, so containers using it must be gone by then. Unlike `std::pmr::monotonic_buffer_resource`, the arena grows in
+place within its reserved region instead of chaining new buffers from an upstream resource. */
+template <typename err_policy>
+class virtual_arena_resource : public std::pmr::memory_resource
+{
+public:
+    explicit virtual_arena_resource(virtual_arena_t<err_policy>& arena) noexcept : m_arena(arena)
+    {
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        const auto result = m_arena.allocate(bytes, alignment);
+        if (result == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return result;
+    }
+
+    void do_deallocate(void* /*ptr*/, size_t /*bytes*/, size_t /*alignment*/) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+
+private:
+    virtual_arena_t<err_policy>& m_arena;
+};
+#endif // __WIL_WINBASE_
+
+#if defined(__WIL__COMBASEAPI_H_)
+//! Returns a memory_resource that allocates with CoTaskMemAlloc.
+inline std::pmr::memory_resource* cotaskmem_resource() noexcept
+{
+    static details::allocator_memory_resource<details::cotaskmem_memory_allocator> s_resource;
+    return &s_resource;
+}
+#endif // __WIL__COMBASEAPI_H_
+#endif // __cpp_lib_memory_resource >= 201603L
+
 } // namespace wil
 
 // This suppression is a temporary workaround to allow libraries built with C++20 to link into binaries built with
@@ -394,6 +873,60 @@ template <typename TChar>
 struct std::formatter<wil::basic_zstring_view<TChar>, TChar> : std::formatter<std::basic_string_view<TChar>, TChar>
 {
 };
+
+#if __cpp_lib_format >= 202207L // std::wformat_string
+namespace wil
+{
+/// @cond
+namespace details
+{
+    template <typename string_type, typename... Args>
+    string_type str_format(std::wformat_string<Args...> format, Args&&... args)
+    {
+        // Most results fit on the stack and are formatted once; only longer ones are formatted a second time into the
+        // final, exactly sized string.  Formatting only reads the arguments, so forwarding them to both calls is safe.
+        wchar_t stackBuffer[256];
+        auto const result =
+            std::format_to_n(stackBuffer, static_cast<ptrdiff_t>(ARRAYSIZE(stackBuffer)), format, std::forward<Args>(args)...);
+        auto const length = static_cast<size_t>(result.size);
+        string_maker<string_type> maker;
+        if (length <= ARRAYSIZE(stackBuffer))
+        {
+            THROW_IF_FAILED(maker.make(stackBuffer, length));
+            return maker.release();
+        }
+        THROW_IF_FAILED(maker.make(nullptr, length));
+        auto const buffer = maker.buffer();
+        std::format_to_n(buffer, result.size, format, std::forward<Args>(args)...);
+        buffer[length] = L'\0';
+        return maker.release();
+    }
+} // namespace details
+/// @endcond
+
+/** Formats the arguments with std::format into any of the string types supported by str_concat (unique_cotaskmem_string,
+unique_hlocal_string, unique_hstring, std::wstring, ...).  The format string is checked at compile time like std::format.
+~~~
+auto message = wil::str_format<wil::unique_cotaskmem_string>(L"{} of {} items copied", copied, total);
+~~~
+*/
+template <typename string_type, typename... Args>
+string_type str_format(std::wformat_string<Args...> format, Args&&... args)
+{
+    return details::str_format<string_type, Args...>(format, std::forward<Args>(args)...);
+}
+
+//! A nothrow variant of `str_format` that returns the error of a failed allocation or formatting operation.
+template <typename string_type, typename... Args>
+HRESULT str_format_nothrow(string_type& result, std::wformat_string<Args...> format, Args&&... args) noexcept
+try
+{
+    result = details::str_format<string_type, Args...>(format, std::forward<Args>(args)...);
+    return S_OK;
+}
+CATCH_RETURN();
+} // namespace wil
+#endif // __cpp_lib_format >= 202207L
 #endif
 #endif
 
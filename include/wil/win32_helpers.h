@@ -408,6 +408,45 @@ constexpr rect_type rect_from_size(length_type x, length_type y, length_type wid
 }
 #pragma endregion
 
+/** Remembers the buffer length that last satisfied a call to @ref AdaptFixedSizeToAllocatedResult.
+Callers whose results routinely exceed the stack buffer (long paths, large environment blocks) otherwise pay for two calls to the
+underlying API and an allocation every time. Passing the same hint to each call lets the adapter allocate the remembered length
+up front, so the first call usually succeeds. The hint is only a first guess: the adapter still grows the buffer when the required
+length increases, and forgets the hint once the result fits on the stack again. Keep one hint per call site, typically as a
+function-local static; it may be shared between threads.
+~~~
+static wil::buffer_size_hint s_modulePathHint;
+wil::unique_cotaskmem_string path;
+RETURN_IF_FAILED(wil::GetModuleFileNameW(module, path, &s_modulePathHint));
+~~~ */
+class buffer_size_hint
+{
+public:
+    buffer_size_hint() WI_NOEXCEPT = default;
+    buffer_size_hint(const buffer_size_hint&) = delete;
+    buffer_size_hint& operator=(const buffer_size_hint&) = delete;
+
+    //! Returns the remembered buffer length in characters, including the null terminator, or 0 if there is none.
+    size_t get() const WI_NOEXCEPT
+    {
+        return static_cast<size_t>(::ReadNoFence(&m_lengthWithNull));
+    }
+
+    //! Remembers `lengthWithNull` for the next call; lengths that do not fit are dropped rather than truncated.
+    void set(size_t lengthWithNull) WI_NOEXCEPT
+    {
+        ::WriteNoFence(&m_lengthWithNull, (lengthWithNull <= MAXLONG) ? static_cast<LONG>(lengthWithNull) : 0);
+    }
+
+    void reset() WI_NOEXCEPT
+    {
+        set(0);
+    }
+
+private:
+    LONG volatile m_lengthWithNull{};
+};
+
 /** Adapts a Win32 API that fills a fixed-size, caller-provided buffer into one that returns an allocated string.
 Many Win32 APIs write into a fixed-size buffer and report how much space is required. This helper first tries a stack buffer of
 `stackBufferLength` characters and, if that is too small, allocates a buffer of the required size, retrying if the required size
@@ -434,41 +473,58 @@ RETURN_IF_FAILED(wil::AdaptFixedSizeToAllocatedResult(dir,
 @param callback Invoked to fill the buffer. It is passed the buffer, the buffer length in characters, and an out pointer that it
         must set to the number of characters needed including the null terminator. It returns an `HRESULT`, and any failure is
         propagated to the caller.
+@param sizeHint Optional. When the remembered length exceeds `stackBufferLength` the stack attempt is skipped and a buffer of
+        that length is allocated first; on success the hint is updated with the length that worked. See @ref buffer_size_hint.
 @return `S_OK` on success, or a failure `HRESULT` from `callback` or from allocation. */
 template <typename string_type, size_t stackBufferLength = 256>
-HRESULT AdaptFixedSizeToAllocatedResult(string_type& result, const wistd::function<HRESULT(PWSTR, size_t, size_t*)>& callback) WI_NOEXCEPT
+HRESULT AdaptFixedSizeToAllocatedResult(
+    string_type& result,
+    const wistd::function<HRESULT(PWSTR, size_t, size_t*)>& callback,
+    _Inout_opt_ buffer_size_hint* sizeHint = nullptr) WI_NOEXCEPT
 {
     details::string_maker<string_type> maker;
 
-    wchar_t value[stackBufferLength]{};
-    size_t valueLengthNeededWithNull{}; // callback returns the number of characters needed including the null terminator.
-    RETURN_IF_FAILED_EXPECTED(callback(value, ARRAYSIZE(value), &valueLengthNeededWithNull));
-    WI_ASSERT(valueLengthNeededWithNull > 0);
-    if (valueLengthNeededWithNull <= ARRAYSIZE(value))
+    // callback returns the number of characters needed including the null terminator. Seed it from the hint so a remembered
+    // length that will not fit on the stack goes straight to the allocated buffer below.
+    size_t valueLengthNeededWithNull = sizeHint ? sizeHint->get() : 0;
+    if (valueLengthNeededWithNull <= stackBufferLength)
     {
-        // Success case as described above, make() adds the space for the null.
-        RETURN_IF_FAILED(maker.make(value, valueLengthNeededWithNull - 1));
+        wchar_t value[stackBufferLength]{};
+        RETURN_IF_FAILED_EXPECTED(callback(value, ARRAYSIZE(value), &valueLengthNeededWithNull));
+        WI_ASSERT(valueLengthNeededWithNull > 0);
+        if (valueLengthNeededWithNull <= ARRAYSIZE(value))
+        {
+            // Success case as described above, make() adds the space for the null.
+            RETURN_IF_FAILED(maker.make(value, valueLengthNeededWithNull - 1));
+            result = maker.release();
+            return S_OK;
+        }
     }
-    else
+
+    // Did not fit in the stack allocated buffer, need to do 2 phase construction.
+    // May need to loop more than once if external conditions cause the value to change.
+    size_t bufferLength;
+    do
     {
-        // Did not fit in the stack allocated buffer, need to do 2 phase construction.
-        // May need to loop more than once if external conditions cause the value to change.
-        size_t bufferLength;
-        do
-        {
-            bufferLength = valueLengthNeededWithNull;
-            // bufferLength includes the null so subtract that as make() will add space for it.
-            RETURN_IF_FAILED(maker.make(nullptr, bufferLength - 1));
+        bufferLength = valueLengthNeededWithNull;
+        // bufferLength includes the null so subtract that as make() will add space for it.
+        RETURN_IF_FAILED(maker.make(nullptr, bufferLength - 1));
 
-            RETURN_IF_FAILED_EXPECTED(callback(maker.buffer(), bufferLength, &valueLengthNeededWithNull));
-            WI_ASSERT(valueLengthNeededWithNull > 0);
+        RETURN_IF_FAILED_EXPECTED(callback(maker.buffer(), bufferLength, &valueLengthNeededWithNull));
+        WI_ASSERT(valueLengthNeededWithNull > 0);
 
-            // If the value shrunk, then adjust the string to trim off the excess buffer.
-            if (valueLengthNeededWithNull < bufferLength)
-            {
-                RETURN_IF_FAILED(maker.trim_at_existing_null(valueLengthNeededWithNull - 1));
-            }
-        } while (valueLengthNeededWithNull > bufferLength);
+        // If the value shrunk, then adjust the string to trim off the excess buffer.
+        if (valueLengthNeededWithNull < bufferLength)
+        {
+            RETURN_IF_FAILED(maker.trim_at_existing_null(valueLengthNeededWithNull - 1));
+        }
+    } while (valueLengthNeededWithNull > bufferLength);
+
+    if (sizeHint)
+    {
+        // Remember the buffer that worked rather than the length reported, as some callbacks (GetModuleFileNameExW) cannot
+        // distinguish an exact fit from truncation. Once the value fits on the stack again the hint is no longer needed.
+        sizeHint->set((valueLengthNeededWithNull <= stackBufferLength) ? 0 : bufferLength);
     }
     result = maker.release();
     return S_OK;
@@ -476,14 +532,15 @@ HRESULT AdaptFixedSizeToAllocatedResult(string_type& result, const wistd::functi
 
 /** Expands the '%' quoted environment variables in 'input' using ExpandEnvironmentStringsW(); */
 template <typename string_type, size_t stackBufferLength = 256>
-HRESULT ExpandEnvironmentStringsW(_In_ PCWSTR input, string_type& result) WI_NOEXCEPT
+HRESULT ExpandEnvironmentStringsW(
+    _In_ PCWSTR input, string_type& result, _Inout_opt_ buffer_size_hint* sizeHint = nullptr) WI_NOEXCEPT
 {
     return wil::AdaptFixedSizeToAllocatedResult<string_type, stackBufferLength>(
         result, [&](_Out_writes_(valueLength) PWSTR value, size_t valueLength, _Out_ size_t* valueLengthNeededWithNul) -> HRESULT {
             *valueLengthNeededWithNul = ::ExpandEnvironmentStringsW(input, value, static_cast<DWORD>(valueLength));
             RETURN_LAST_ERROR_IF(*valueLengthNeededWithNul == 0);
             return S_OK;
-        });
+        }, sizeHint);
 }
 
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP | WINAPI_PARTITION_SYSTEM | WINAPI_PARTITION_GAMES)
@@ -556,7 +613,8 @@ HRESULT ExpandEnvAndSearchPath(_In_ PCWSTR input, string_type& result) WI_NOEXCE
 
 /** Looks up the environment variable 'key' and fails if it is not found. */
 template <typename string_type, size_t initialBufferLength = 128>
-inline HRESULT GetEnvironmentVariableW(_In_ PCWSTR key, string_type& result) WI_NOEXCEPT
+inline HRESULT GetEnvironmentVariableW(
+    _In_ PCWSTR key, string_type& result, _Inout_opt_ buffer_size_hint* sizeHint = nullptr) WI_NOEXCEPT
 {
     return wil::AdaptFixedSizeToAllocatedResult<string_type, initialBufferLength>(
         result, [&](_Out_writes_(valueLength) PWSTR value, size_t valueLength, _Out_ size_t* valueLengthNeededWithNul) -> HRESULT {
@@ -579,7 +637,7 @@ inline HRESULT GetEnvironmentVariableW(_In_ PCWSTR key, string_type& result) WI_
                 (*valueLengthNeededWithNul)++; // It fit, account for the null.
             }
             return S_OK;
-        });
+        }, sizeHint);
 }
 
 /** Looks up the environment variable 'key' and returns null if it is not found. */
@@ -594,7 +652,11 @@ HRESULT TryGetEnvironmentVariableW(_In_ PCWSTR key, string_type& result) WI_NOEX
 /** Retrieves the fully qualified path for the file containing the specified module loaded by a given process.
 Note GetModuleFileNameExW is a macro. */
 template <typename string_type, size_t initialBufferLength = 128>
-HRESULT GetModuleFileNameExW(_In_opt_ HANDLE process, _In_opt_ HMODULE module, string_type& path) WI_NOEXCEPT
+HRESULT GetModuleFileNameExW(
+    _In_opt_ HANDLE process,
+    _In_opt_ HMODULE module,
+    string_type& path,
+    _Inout_opt_ buffer_size_hint* sizeHint = nullptr) WI_NOEXCEPT
 {
     auto adapter = [&](_Out_writes_(valueLength) PWSTR value, size_t valueLength, _Out_ size_t* valueLengthNeededWithNul) -> HRESULT {
         DWORD copiedCount{};
@@ -630,25 +692,26 @@ HRESULT GetModuleFileNameExW(_In_opt_ HANDLE process, _In_opt_ HMODULE module, s
         return S_OK;
     };
 
-    return wil::AdaptFixedSizeToAllocatedResult<string_type, initialBufferLength>(path, wistd::move(adapter));
+    return wil::AdaptFixedSizeToAllocatedResult<string_type, initialBufferLength>(path, wistd::move(adapter), sizeHint);
 }
 
 /** Retrieves the fully qualified path for the file that contains the specified module.
 The module must have been loaded by the current process. The path returned will use the same format that was specified when the
 module was loaded. Therefore, the path can be a long or short file name, and can have the prefix '\\?\'. */
 template <typename string_type, size_t initialBufferLength = 128>
-HRESULT GetModuleFileNameW(HMODULE module, string_type& path) WI_NOEXCEPT
+HRESULT GetModuleFileNameW(HMODULE module, string_type& path, _Inout_opt_ buffer_size_hint* sizeHint = nullptr) WI_NOEXCEPT
 {
-    return wil::GetModuleFileNameExW<string_type, initialBufferLength>(nullptr, module, path);
+    return wil::GetModuleFileNameExW<string_type, initialBufferLength>(nullptr, module, path, sizeHint);
 }
 
 /** Retrieves the path of the Windows system directory, using `GetSystemDirectoryW`.
 @tparam string_type The string type to produce the result in.
 @tparam stackBufferLength The size, in characters, of the initial stack buffer.
 @param result Receives the system directory path on success.
+@param sizeHint Optional. Remembers the buffer length between calls; see @ref buffer_size_hint.
 @return `S_OK` on success, or a failure `HRESULT`. */
 template <typename string_type, size_t stackBufferLength = 256>
-HRESULT GetSystemDirectoryW(string_type& result) WI_NOEXCEPT
+HRESULT GetSystemDirectoryW(string_type& result, _Inout_opt_ buffer_size_hint* sizeHint = nullptr) WI_NOEXCEPT
 {
     return wil::AdaptFixedSizeToAllocatedResult<string_type, stackBufferLength>(
         result, [&](_Out_writes_(valueLength) PWSTR value, size_t valueLength, _Out_ size_t* valueLengthNeededWithNul) -> HRESULT {
@@ -659,7 +722,7 @@ HRESULT GetSystemDirectoryW(string_type& result) WI_NOEXCEPT
                 (*valueLengthNeededWithNul)++; // it fit, account for the null
             }
             return S_OK;
-        });
+        }, sizeHint);
 }
 
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP | WINAPI_PARTITION_SYSTEM | WINAPI_PARTITION_GAMES)
@@ -667,9 +730,10 @@ HRESULT GetSystemDirectoryW(string_type& result) WI_NOEXCEPT
 @tparam string_type The string type to produce the result in.
 @tparam stackBufferLength The size, in characters, of the initial stack buffer.
 @param result Receives the Windows directory path on success.
+@param sizeHint Optional. Remembers the buffer length between calls; see @ref buffer_size_hint.
 @return `S_OK` on success, or a failure `HRESULT`. */
 template <typename string_type, size_t stackBufferLength = 256>
-HRESULT GetWindowsDirectoryW(string_type& result) WI_NOEXCEPT
+HRESULT GetWindowsDirectoryW(string_type& result, _Inout_opt_ buffer_size_hint* sizeHint = nullptr) WI_NOEXCEPT
 {
     return wil::AdaptFixedSizeToAllocatedResult<string_type, stackBufferLength>(
         result, [&](_Out_writes_(valueLength) PWSTR value, size_t valueLength, _Out_ size_t* valueLengthNeededWithNul) -> HRESULT {
@@ -680,17 +744,17 @@ HRESULT GetWindowsDirectoryW(string_type& result) WI_NOEXCEPT
                 (*valueLengthNeededWithNul)++; // it fit, account for the null
             }
             return S_OK;
-        });
+        }, sizeHint);
 }
 #endif
 
 #ifdef WIL_ENABLE_EXCEPTIONS
 /** Expands the '%' quoted environment variables in 'input' using ExpandEnvironmentStringsW(); */
 template <typename string_type = wil::unique_cotaskmem_string, size_t stackBufferLength = 256>
-string_type ExpandEnvironmentStringsW(_In_ PCWSTR input)
+string_type ExpandEnvironmentStringsW(_In_ PCWSTR input, _Inout_opt_ buffer_size_hint* sizeHint = nullptr)
 {
     string_type result{};
-    THROW_IF_FAILED((wil::ExpandEnvironmentStringsW<string_type, stackBufferLength>(input, result)));
+    THROW_IF_FAILED((wil::ExpandEnvironmentStringsW<string_type, stackBufferLength>(input, result, sizeHint)));
     return result;
 }
 
@@ -708,10 +772,10 @@ string_type TrySearchPathW(_In_opt_ PCWSTR path, _In_ PCWSTR fileName, PCWSTR _I
 
 /** Looks up the environment variable 'key' and fails if it is not found. */
 template <typename string_type = wil::unique_cotaskmem_string, size_t initialBufferLength = 128>
-string_type GetEnvironmentVariableW(_In_ PCWSTR key)
+string_type GetEnvironmentVariableW(_In_ PCWSTR key, _Inout_opt_ buffer_size_hint* sizeHint = nullptr)
 {
     string_type result{};
-    THROW_IF_FAILED((wil::GetEnvironmentVariableW<string_type, initialBufferLength>(key, result)));
+    THROW_IF_FAILED((wil::GetEnvironmentVariableW<string_type, initialBufferLength>(key, result, sizeHint)));
     return result;
 }
 
@@ -729,12 +793,14 @@ Throws on failure. The module must have been loaded by the current process.
 @tparam string_type The string type to return; defaults to `wil::unique_cotaskmem_string`.
 @tparam initialBufferLength The size, in characters, of the initial stack buffer.
 @param module The module to query, or `nullptr` for the current process's executable.
+@param sizeHint Optional. Remembers the buffer length between calls; see @ref buffer_size_hint.
 @return The module's fully qualified path. */
 template <typename string_type = wil::unique_cotaskmem_string, size_t initialBufferLength = 128>
-string_type GetModuleFileNameW(HMODULE module = nullptr /* current process module */)
+string_type GetModuleFileNameW(
+    HMODULE module = nullptr /* current process module */, _Inout_opt_ buffer_size_hint* sizeHint = nullptr)
 {
     string_type result{};
-    THROW_IF_FAILED((wil::GetModuleFileNameW<string_type, initialBufferLength>(module, result)));
+    THROW_IF_FAILED((wil::GetModuleFileNameW<string_type, initialBufferLength>(module, result, sizeHint)));
     return result;
 }
 
@@ -744,12 +810,13 @@ Throws on failure. Note `GetModuleFileNameExW` is a macro.
 @tparam initialBufferLength The size, in characters, of the initial stack buffer.
 @param process The process that loaded the module, or `nullptr` to use the current process.
 @param module The module to query, or `nullptr` for the process's executable.
+@param sizeHint Optional. Remembers the buffer length between calls; see @ref buffer_size_hint.
 @return The module's fully qualified path. */
 template <typename string_type = wil::unique_cotaskmem_string, size_t initialBufferLength = 128>
-string_type GetModuleFileNameExW(HANDLE process, HMODULE module)
+string_type GetModuleFileNameExW(HANDLE process, HMODULE module, _Inout_opt_ buffer_size_hint* sizeHint = nullptr)
 {
     string_type result{};
-    THROW_IF_FAILED((wil::GetModuleFileNameExW<string_type, initialBufferLength>(process, module, result)));
+    THROW_IF_FAILED((wil::GetModuleFileNameExW<string_type, initialBufferLength>(process, module, result, sizeHint)));
     return result;
 }
 
@@ -758,12 +825,13 @@ string_type GetModuleFileNameExW(HANDLE process, HMODULE module)
 Throws on failure.
 @tparam string_type The string type to return; defaults to `wil::unique_cotaskmem_string`.
 @tparam stackBufferLength The size, in characters, of the initial stack buffer.
+@param sizeHint Optional. Remembers the buffer length between calls; see @ref buffer_size_hint.
 @return The Windows directory path. */
 template <typename string_type = wil::unique_cotaskmem_string, size_t stackBufferLength = 256>
-string_type GetWindowsDirectoryW()
+string_type GetWindowsDirectoryW(_Inout_opt_ buffer_size_hint* sizeHint = nullptr)
 {
     string_type result;
-    THROW_IF_FAILED((wil::GetWindowsDirectoryW<string_type, stackBufferLength>(result)));
+    THROW_IF_FAILED((wil::GetWindowsDirectoryW<string_type, stackBufferLength>(result, sizeHint)));
     return result;
 }
 #endif
@@ -772,12 +840,13 @@ string_type GetWindowsDirectoryW()
 Throws on failure.
 @tparam string_type The string type to return; defaults to `wil::unique_cotaskmem_string`.
 @tparam stackBufferLength The size, in characters, of the initial stack buffer.
+@param sizeHint Optional. Remembers the buffer length between calls; see @ref buffer_size_hint.
 @return The system directory path. */
 template <typename string_type = wil::unique_cotaskmem_string, size_t stackBufferLength = 256>
-string_type GetSystemDirectoryW()
+string_type GetSystemDirectoryW(_Inout_opt_ buffer_size_hint* sizeHint = nullptr)
 {
     string_type result;
-    THROW_IF_FAILED((wil::GetSystemDirectoryW<string_type, stackBufferLength>(result)));
+    THROW_IF_FAILED((wil::GetSystemDirectoryW<string_type, stackBufferLength>(result, sizeHint)));
     return result;
 }
 
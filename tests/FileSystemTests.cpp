@@ -7,6 +7,7 @@
 #ifdef WIL_ENABLE_EXCEPTIONS
 #include <string>
 #include <thread>
+#include <vector>
 #endif
 
 // TODO: str_raw_ptr is not two-phase name lookup clean (https://github.com/Microsoft/wil/issues/8)
@@ -511,6 +512,30 @@ TEST_CASE("FileSystemTests::VerifyStrConcat", "[filesystem]")
         REQUIRE_SUCCEEDED(wil::str_concat_nothrow(combinedStringNT, part1, part2, part3, part4, part5));
         REQUIRE(CompareStringOrdinal(combinedStringNT.get(), -1, L"Test1Test2Test3Test4Test5Test6", -1, TRUE) == CSTR_EQUAL);
     }
+
+    SECTION("Concat appends to std::wstring in place")
+    {
+        std::wstring combined;
+        std::wstring expected;
+        for (int index = 0; index < 100; index++)
+        {
+            REQUIRE_SUCCEEDED(wil::str_concat_nothrow(combined, L"Test", std::wstring_view(L"1234", 2)));
+            expected += L"Test12";
+        }
+        REQUIRE(combined == expected);
+
+        // Pieces that refer to the destination itself
+        std::wstring doubled = L"ab";
+        REQUIRE_SUCCEEDED(wil::str_concat_nothrow(doubled, doubled, doubled.c_str() + 1, std::wstring_view(L"\0c", 2)));
+        REQUIRE(doubled == std::wstring(L"ababb\0c", 7));
+    }
+
+    SECTION("Concat into an existing hstring")
+    {
+        auto combined = wil::make_unique_string_nothrow<wil::unique_hstring>(L"Test1");
+        REQUIRE_SUCCEEDED(wil::str_concat_nothrow(combined, L"Test2", L""));
+        REQUIRE(wcscmp(WindowsGetStringRawBuffer(combined.get(), nullptr), L"Test1Test2") == 0);
+    }
 #endif
 }
 
@@ -748,6 +773,88 @@ TEST_CASE("FileSystemTests::CreateFileW helpers", "[filesystem]")
     }
 }
 
+TEST_CASE("FileSystemTests::MappedFile", "[filesystem]")
+{
+    auto path = wil::ExpandEnvironmentStringsW<std::wstring>(LR"(%TEMP%\wil_mapped_file_test)");
+    std::vector<BYTE> contents(3 * 64 * 1024 + 100);
+    for (size_t i = 0; i < contents.size(); ++i)
+    {
+        contents[i] = static_cast<BYTE>(i % 251);
+    }
+    {
+        auto file = wil::open_or_truncate_existing_file(path.c_str());
+        DWORD written{};
+        REQUIRE(::WriteFile(file.get(), contents.data(), static_cast<DWORD>(contents.size()), &written, nullptr));
+    }
+
+    // Whole-file mapping and typed views
+    {
+        wil::mapped_file file(path.c_str(), wil::mapped_file_access::read_only, wil::mapped_file_options::sequential_scan);
+        REQUIRE(file.size() == contents.size());
+        REQUIRE(file.file_size() == contents.size());
+        REQUIRE(memcmp(file.data(), contents.data(), contents.size()) == 0);
+
+        auto words = file.view<DWORD>(4, 2);
+        REQUIRE(words != nullptr);
+        REQUIRE(words[0] == *reinterpret_cast<const DWORD*>(contents.data() + 4));
+        REQUIRE(file.view<DWORD>(1) == nullptr);                     // misaligned
+        REQUIRE(file.view<DWORD>(contents.size() - 2) == nullptr);   // runs past the end
+        REQUIRE(file.view<BYTE>(contents.size() + 1) == nullptr);    // starts past the end
+#if __cpp_lib_span >= 202002L
+        REQUIRE(file.bytes().size() == contents.size());
+        REQUIRE(file.view_span<WORD>(8, 4).size() == 4);
+        REQUIRE(file.view_span<WORD>(contents.size(), 1).empty());
+#endif
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+        file.prefetch();
+        file.prefetch(64 * 1024, 4096);
+#endif
+    }
+
+    // Sliding windows start at any offset, not just allocation granularity boundaries
+    {
+        wil::mapped_file_nothrow file;
+        REQUIRE_SUCCEEDED(file.open(path.c_str(), wil::mapped_file_access::read_only, wil::mapped_file_options::none, 4096));
+        REQUIRE(file.size() == 4096);
+        REQUIRE_SUCCEEDED(file.map_window(64 * 1024 + 10, 100));
+        REQUIRE(file.offset() == 64 * 1024 + 10);
+        REQUIRE(file.size() == 100);
+        REQUIRE(memcmp(file.data(), contents.data() + 64 * 1024 + 10, 100) == 0);
+
+        // Windows are clamped to the end of the file
+        REQUIRE_SUCCEEDED(file.map_window(contents.size() - 50, 4096));
+        REQUIRE(file.size() == 50);
+        REQUIRE_SUCCEEDED(file.map_window(contents.size() + 50, 4096));
+        REQUIRE(file.size() == 0);
+        REQUIRE(file.data() == nullptr);
+    }
+
+    // Writes through a read-write mapping reach the file
+    {
+        wil::mapped_file file(path.c_str(), wil::mapped_file_access::read_write);
+        file.writable_data()[1000] = 0xAB;
+    }
+    {
+        wil::mapped_file file(path.c_str());
+        REQUIRE(file.data()[1000] == 0xAB);
+    }
+
+    // Empty files map to an empty view
+    {
+        auto file = wil::open_or_truncate_existing_file(path.c_str());
+    }
+    {
+        wil::mapped_file file(path.c_str());
+        REQUIRE(file.size() == 0);
+        REQUIRE(file.view<BYTE>() == nullptr);
+    }
+
+    wil::mapped_file_nothrow missing;
+    REQUIRE(missing.open(LR"(C:\does\not\exist\wil_mapped_file_test)") == HRESULT_FROM_WIN32(ERROR_PATH_NOT_FOUND));
+    REQUIRE_THROWS(wil::mapped_file(LR"(C:\does\not\exist\wil_mapped_file_test)"));
+    ::DeleteFileW(path.c_str());
+}
+
 TEST_CASE("FileSystemTest::FolderChangeReader destructor does not hang", "[filesystem]")
 {
     wil::unique_cotaskmem_string testRootTmp;
@@ -895,6 +1002,49 @@ TEST_CASE("GetModuleFileNameTests::VerifyFileNameExactlyMatchingTheInitialBuffer
     REQUIRE(wcslen(path.get()) == (pathLength - 1));
 }
 
+TEST_CASE("GetModuleFileNameTests::VerifySizeHintAvoidsRetry", "[filesystem]")
+{
+    const DWORD pathLength = 300;
+    int callCount = 0;
+    witest::detoured_thread_function<&GetModuleFileNameW> mock;
+    REQUIRE_SUCCEEDED(mock.reset([&](HMODULE, _Out_ PWSTR fileName, _In_ DWORD bufferSize) -> DWORD {
+        ++callCount;
+        const DWORD amountToCopy = std::min(pathLength, bufferSize);
+        std::fill_n(fileName, amountToCopy, L'a');
+        fileName[amountToCopy - 1] = L'\0';
+        SetLastError((pathLength < bufferSize) ? ERROR_SUCCESS : ERROR_INSUFFICIENT_BUFFER);
+        return (pathLength < bufferSize) ? amountToCopy : bufferSize;
+    }));
+
+    wil::buffer_size_hint hint;
+    wil::unique_cotaskmem_string path;
+    REQUIRE_SUCCEEDED(wil::GetModuleFileNameW(nullptr, path, &hint));
+    REQUIRE(wcslen(path.get()) == (pathLength - 1));
+    REQUIRE(callCount > 1);
+    REQUIRE(hint.get() > 128);
+
+    // The remembered length satisfies the next call on the first attempt.
+    callCount = 0;
+    REQUIRE_SUCCEEDED(wil::GetModuleFileNameW(nullptr, path, &hint));
+    REQUIRE(wcslen(path.get()) == (pathLength - 1));
+    REQUIRE(callCount == 1);
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+    // The throwing variant takes the same hint.
+    callCount = 0;
+    auto thrownPath = wil::GetModuleFileNameW<wil::unique_cotaskmem_string>(nullptr, &hint);
+    REQUIRE(wcslen(thrownPath.get()) == (pathLength - 1));
+    REQUIRE(callCount == 1);
+#endif
+
+    // A result that fits on the stack again clears the hint.
+    hint.set(1024);
+    wil::unique_cotaskmem_string shortPath;
+    REQUIRE_SUCCEEDED(wil::GetModuleFileNameW<wil::unique_cotaskmem_string, 512>(nullptr, shortPath, &hint));
+    REQUIRE(wcslen(shortPath.get()) == (pathLength - 1));
+    REQUIRE(hint.get() == 0);
+}
+
 TEST_CASE("GetModuleFileNameTests::VerifyFileNameExactlyMaximumNTPathLength", "[filesystem]")
 {
     const DWORD pathLength = wil::max_extended_path_length;
@@ -0,0 +1,68 @@
+#include "pch.h"
+
+// WIL_ENABLE_HANDLE_LIFETIME_PROFILING changes the layout of unique_any_t, so these tests build into their own executable
+#include <wil/result.h>
+#include <wil/resource.h>
+
+#include "common.h"
+
+// Profiled wrappers carry their acquisition site next to the handle.
+static_assert(sizeof(wil::unique_handle) == 2 * sizeof(HANDLE), "profiled wrappers record their acquisition site");
+
+// result.h shares these across modules, so they must stay a bare HANDLE even when profiling is enabled.
+static_assert(sizeof(wil::details::cross_module_mutex_nothrow) == sizeof(HANDLE), "cross-module handles are not profiled");
+static_assert(sizeof(wil::details::cross_module_semaphore_nothrow) == sizeof(HANDLE), "cross-module handles are not profiled");
+static_assert(sizeof(wil::details_abi::SemaphoreValue) == 2 * sizeof(HANDLE), "SemaphoreValue is shared across modules");
+
+TEST_CASE("HandleLifetimeProfilingTests::CountsAcquisitionsAndCloses", "[resource][profiling]")
+{
+    const auto before = wil::get_handle_lifetime_statistics<wil::unique_handle>();
+    {
+        wil::unique_handle first(::CreateEventW(nullptr, TRUE, FALSE, nullptr));
+        wil::unique_handle second;
+        second.reset(::CreateEventW(nullptr, TRUE, FALSE, nullptr));
+        auto during = wil::get_handle_lifetime_statistics<wil::unique_handle>();
+        REQUIRE(during.live == before.live + 2);
+        REQUIRE(during.highWaterMark >= during.live);
+
+        // Moving a handle between wrappers does not change its lifetime.
+        auto moved = std::move(second);
+        wil::unique_handle assigned;
+        assigned = std::move(moved);
+        REQUIRE(wil::get_handle_lifetime_statistics<wil::unique_handle>().live == before.live + 2);
+
+        wil::unique_handle filled;
+        const auto process = ::GetCurrentProcess();
+        REQUIRE(::DuplicateHandle(process, first.get(), process, filled.put(), 0, FALSE, DUPLICATE_SAME_ACCESS));
+        REQUIRE(wil::get_handle_lifetime_statistics<wil::unique_handle>().live == before.live + 3);
+        ::CloseHandle(filled.release());
+
+        // A put() that is never filled in is not counted once the wrapper goes away.
+        wil::unique_handle unfilled;
+        (void)unfilled.put();
+    }
+
+    const auto after = wil::get_handle_lifetime_statistics<wil::unique_handle>();
+    REQUIRE(after.live == before.live);
+    REQUIRE(after.acquired == before.acquired + 3);
+    REQUIRE(after.closed == before.closed + 3);
+    REQUIRE(after.siteCount > 0);
+
+    bool found = false;
+    wil::for_each_handle_lifetime([&](const wil::handle_lifetime_statistics& statistics) {
+        found = found || (statistics.typeName == after.typeName);
+    });
+    REQUIRE(found);
+}
+
+TEST_CASE("HandleLifetimeProfilingTests::CrossModuleHandlesAreNotCounted", "[resource][profiling]")
+{
+    const auto before = wil::get_handle_lifetime_statistics<wil::unique_handle>();
+    {
+        wil::details_abi::SemaphoreValue semaphore;
+        REQUIRE_SUCCEEDED(semaphore.CreateFromValue(L"HandleLifetimeProfilingTests", 42u));
+        semaphore.Destroy();
+    }
+    const auto after = wil::get_handle_lifetime_statistics<wil::unique_handle>();
+    REQUIRE(after.acquired == before.acquired);
+}
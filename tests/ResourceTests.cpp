@@ -675,6 +675,87 @@ TEST_CASE("UniqueStringAndStringMakerTests::VerifyStringMakerProcessHeap", "[res
         REQUIRE(wcscmp(value, result.get()) == 0);
     });
 }
+
+TEST_CASE("UniqueStringAndStringMakerTests::VerifyPrivateHeapString", "[resource][string_maker]")
+{
+    auto heap = wil::create_private_heap_nothrow();
+    REQUIRE(heap);
+
+    auto full = wil::make_private_heap_string_nothrow(heap.get(), L"Foo");
+    REQUIRE(wcscmp(full.get(), L"Foo") == 0);
+    REQUIRE(::HeapSize(heap.get(), 0, reinterpret_cast<HANDLE*>(full.get()) - 1) != static_cast<SIZE_T>(-1));
+
+    auto truncated = wil::make_private_heap_string_failfast(heap.get(), L"Foobar", 3);
+    REQUIRE(wcscmp(truncated.get(), L"Foo") == 0);
+
+    auto reserved = wil::make_private_heap_string_nothrow(heap.get(), nullptr, 5);
+    REQUIRE(reserved.get()[0] == L'\0');
+    REQUIRE(reserved.get()[5] == L'\0');
+
+#ifndef WIL_NO_ANSI_STRINGS
+    auto ansi = wil::make_private_heap_ansistring_nothrow(heap.get(), "Foobar", 3);
+    REQUIRE(strcmp(ansi.get(), "Foo") == 0);
+#endif
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+    auto thrown = wil::make_private_heap_string(heap.get(), L"Foo");
+    REQUIRE(wcscmp(thrown.get(), L"Foo") == 0);
+#endif
+}
+
+TEST_CASE("ResourceTests::PrivateHeapAndArena", "[resource][heap]")
+{
+    auto heap = wil::create_private_heap_failfast(wil::private_heap_options::no_serialize);
+    {
+        auto value = wil::make_unique_private_heap_nothrow<int>(heap.get(), 42);
+        REQUIRE(value);
+        REQUIRE(*value == 42);
+        auto values = wil::make_unique_private_heap_failfast<int[]>(heap.get(), 16);
+        REQUIRE(values[15] == 0);
+
+        auto text = wil::make_private_heap_string_nothrow(heap.get(), L"private");
+        REQUIRE(wcscmp(text.get(), L"private") == 0);
+    }
+
+    wil::virtual_arena_nothrow arena;
+    REQUIRE(FAILED(arena.create(0)));
+    REQUIRE_SUCCEEDED(arena.create(256 * 1024, 4096));
+    REQUIRE(arena.reserved() == 256 * 1024);
+    REQUIRE(arena.committed() == 0);
+
+    struct alignas(64) aligned_value
+    {
+        int value;
+    };
+    auto first = wil::make_unique_arena_nothrow<aligned_value>(arena, aligned_value{7});
+    REQUIRE(first);
+    REQUIRE(first->value == 7);
+    REQUIRE((reinterpret_cast<ULONG_PTR>(first.get()) % 64) == 0);
+    REQUIRE(arena.committed() == 4096);
+
+    auto name = wil::make_arena_string_failfast(arena, L"arena", 3);
+    REQUIRE(wcscmp(name, L"are") == 0);
+
+    REQUIRE(arena.allocate(100 * 1024) != nullptr);
+    REQUIRE(arena.committed() >= arena.used());
+    REQUIRE(arena.allocate(512 * 1024) == nullptr);
+
+    // Alignment beyond the 64KB allocation granularity cannot be guaranteed, so it is refused.
+    REQUIRE(arena.allocate(16, 128 * 1024) == nullptr);
+    REQUIRE(arena.allocate(16, wil::virtual_arena_nothrow::max_alignment) != nullptr);
+    REQUIRE(arena.allocate(16) != nullptr);
+
+    first.reset();
+    const auto committed = arena.committed();
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    REQUIRE(arena.committed() == committed);
+
+    wil::virtual_arena_nothrow moved(wistd::move(arena));
+    REQUIRE(moved);
+    REQUIRE(!arena);
+    REQUIRE(arena.allocate(16) == nullptr);
+}
 #endif
 
 TEST_CASE("UniqueStringAndStringMakerTests::VerifyStringMakerMidl", "[resource][string_maker]")
@@ -931,6 +1012,12 @@ TEST_CASE("read_lock_required", "[resource]")
     read_lock_function(lock.lock_shared());
     read_lock_function(lock.lock_exclusive()); // an exclusive lock also counts as a read lock
 
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+    wil::sharded_rwlock shardedLock;
+    read_lock_function(shardedLock.lock_shared());
+    read_lock_function(shardedLock.lock_exclusive());
+#endif
+
     wil::critical_section cs;
     read_lock_function(cs.lock());
 
@@ -948,6 +1035,11 @@ TEST_CASE("write_lock_required", "[resource]")
     wil::srwlock lock;
     write_lock_function(lock.lock_exclusive());
 
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+    wil::sharded_rwlock shardedLock;
+    write_lock_function(shardedLock.lock_exclusive());
+#endif
+
     wil::critical_section cs;
     write_lock_function(cs.lock());
 
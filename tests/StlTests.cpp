@@ -7,6 +7,9 @@
 
 #include <wil/stl.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 struct dummy
 {
     char value;
@@ -48,6 +51,56 @@ TEST_CASE("StlTests::TestSecureAllocator", "[stl][secure_allocator]")
     }
 }
 
+TEST_CASE("StlTests::TestSecurePool", "[stl][secure_allocator]")
+{
+    wil::secure_pool pool;
+
+    // Freed blocks are zeroed and recycled most-recently-freed first.
+    auto first = static_cast<BYTE*>(pool.allocate(40));
+    memset(first, 0xAB, 40);
+    pool.deallocate(first, 40);
+    auto second = static_cast<BYTE*>(pool.allocate(33));
+    REQUIRE(second == first);
+    REQUIRE(std::all_of(second, second + 64, [](BYTE value) { return value == 0; }));
+    pool.deallocate(second, 33);
+
+    // Enough blocks to span many slabs.
+    std::vector<void*> blocks;
+    for (int i = 0; i < 2000; ++i)
+    {
+        blocks.push_back(pool.allocate(2048));
+    }
+    for (auto block : blocks)
+    {
+        pool.deallocate(block, 2048);
+    }
+
+    auto large = static_cast<BYTE*>(pool.allocate(10000));
+    REQUIRE(large[9999] == 0);
+    pool.deallocate(large, 10000);
+
+    {
+        wil::secure_pool_wstring secret(L"a secret long enough to need a heap buffer", wil::secure_pool_allocator<wchar_t>{pool});
+        secret += secret;
+        REQUIRE(&secret.get_allocator().pool() == &pool);
+
+        wil::secure_pool_vector<int> values{wil::secure_pool_allocator<int>(pool)};
+        for (int i = 0; i < 5000; ++i)
+        {
+            values.push_back(i);
+        }
+        REQUIRE(values[4999] == 4999);
+    }
+
+    wil::secure_pool_string defaultPooled("uses the default pool, which is shared by the whole process");
+    REQUIRE(defaultPooled.get_allocator() == wil::secure_pool_allocator<wchar_t>());
+    REQUIRE(defaultPooled.get_allocator() != wil::secure_pool_allocator<char>(pool));
+
+    wil::secure_pool lockedPool(wil::secure_pool_options::lock_pages);
+    wil::secure_pool_vector<BYTE> lockedBytes(100, BYTE{0x5A}, wil::secure_pool_allocator<BYTE>(lockedPool));
+    REQUIRE(lockedBytes[99] == 0x5A);
+}
+
 struct CustomNoncopyableString
 {
     CustomNoncopyableString() = default;
@@ -203,6 +256,40 @@ TEST_CASE("StlTests::TestZStringView formatting", "[stl][zstring_view]")
     }
 }
 
+#if __cpp_lib_format >= 202207L
+TEST_CASE("StlTests::TestStrFormat", "[stl][str_format]")
+{
+    SECTION("Formats into WIL string types")
+    {
+        auto cotaskmem = wil::str_format<wil::unique_cotaskmem_string>(L"{} of {} {}", 3, 4, L"items"_zv);
+        REQUIRE(wcscmp(cotaskmem.get(), L"3 of 4 items") == 0);
+
+        auto hlocal = wil::str_format<wil::unique_hlocal_string>(L"{:>5}|{:.2f}", L"ab", 6.283);
+        REQUIRE(wcscmp(hlocal.get(), L"   ab|6.28") == 0);
+
+        std::wstring stlString;
+        REQUIRE_SUCCEEDED(wil::str_format_nothrow(stlString, L"{:#x}", 255));
+        REQUIRE(stlString == L"0xff");
+    }
+
+    SECTION("Output that exactly fills the stack buffer")
+    {
+        std::wstring const text(254, L'x');
+        auto formatted = wil::str_format<std::wstring>(L"[{}]", text);
+        REQUIRE(formatted == L"[" + text + L"]");
+    }
+
+    SECTION("Output larger than the stack buffer")
+    {
+        std::wstring const longText(1000, L'x');
+        auto formatted = wil::str_format<wil::unique_cotaskmem_string>(L"[{}]", longText);
+        REQUIRE(wcslen(formatted.get()) == longText.size() + 2);
+        REQUIRE(formatted.get()[0] == L'[');
+        REQUIRE(formatted.get()[longText.size() + 1] == L']');
+    }
+}
+#endif
+
 #endif
 
 TEST_CASE("StlTests::TestZWStringView", "[stl][zstring_view]")
@@ -279,4 +366,48 @@ TEST_CASE("StlTests::TestZWStringView", "[stl][zstring_view]")
     REQUIRE(wil::zwstring_view(fake_path) == L"hello");
 }
 
+#if __cpp_lib_memory_resource >= 201603L
+template <typename Resource>
+static void VerifyMemoryResource(Resource&& resource)
+{
+    std::pmr::vector<int> values(resource);
+    for (int i = 0; i < 1000; ++i)
+    {
+        values.push_back(i);
+    }
+    REQUIRE(values[999] == 999);
+
+    std::pmr::unordered_map<int, std::pmr::wstring> names(resource);
+    for (int i = 0; i < 100; ++i)
+    {
+        names.emplace(i, L"a string long enough to avoid the small string buffer");
+    }
+    REQUIRE(names.size() == 100);
+
+    // Over-aligned requests take the over-allocation path.
+    auto aligned = resource->allocate(100, 256);
+    REQUIRE((reinterpret_cast<uintptr_t>(aligned) % 256) == 0);
+    resource->deallocate(aligned, 100, 256);
+}
+
+TEST_CASE("StlTests::TestMemoryResources", "[stl][memory_resource]")
+{
+    VerifyMemoryResource(wil::process_heap_resource());
+    VerifyMemoryResource(wil::hlocal_resource());
+    VerifyMemoryResource(wil::cotaskmem_resource());
+    REQUIRE(wil::process_heap_resource()->is_equal(*wil::process_heap_resource()));
+    REQUIRE(!wil::process_heap_resource()->is_equal(*wil::hlocal_resource()));
+
+    auto heap = wil::create_private_heap(wil::private_heap_options::no_serialize);
+    wil::private_heap_resource heapResource(heap.get());
+    VerifyMemoryResource(&heapResource);
+
+    wil::virtual_arena arena(1024 * 1024);
+    wil::virtual_arena_resource<wil::err_exception_policy> arenaResource(arena);
+    VerifyMemoryResource(&arenaResource);
+    REQUIRE(arena.used() > 0);
+    REQUIRE_THROWS_AS(arenaResource.allocate(2 * 1024 * 1024), std::bad_alloc);
+}
+#endif // __cpp_lib_memory_resource >= 201603L
+
 #endif
@@ -0,0 +1,332 @@
+#include "pch.h"
+
+// wil::trace_memory_sink replaces the ETW write for the whole module, so these tests build into their own executable
+#define PROVIDER_CLASS_NAME TestProvider
+#include "TraceLoggingTests.h"
+
+#include "common.h"
+
+// Writes an event from its enable callback, as providers that log a rundown on enable do
+class RundownProvider : public wil::TraceLoggingProvider
+{
+    // 4d3c1f9e-2b7a-4c5e-9f01-6a8d2e3b7c41
+    IMPLEMENT_TRACELOGGING_CLASS_WITH_MICROSOFT_TELEMETRY_AND_CALLBACK(
+        RundownProvider, "WIL.UnitTests.Rundown", (0x4d3c1f9e, 0x2b7a, 0x4c5e, 0x9f, 0x01, 0x6a, 0x8d, 0x2e, 0x3b, 0x7c, 0x41));
+
+public:
+    DEFINE_TRACELOGGING_EVENT(Rundown);
+
+    // Set once the provider exists; the callbacks that run while it is being registered must not use Instance()
+    static bool s_rundownOnEnable;
+};
+
+bool RundownProvider::s_rundownOnEnable = false;
+
+VOID NTAPI RundownProvider::Callback(
+    _In_ const GUID*, ULONG ControlCode, UCHAR, ULONGLONG, ULONGLONG, _In_opt_ EVENT_FILTER_DESCRIPTOR*, void*)
+{
+    if (s_rundownOnEnable && (ControlCode == EVENT_CONTROL_CODE_ENABLE_PROVIDER))
+    {
+        Rundown();
+    }
+}
+
+TEST_CASE("TraceLoggingMemorySinkTests::MemorySink", "[tracelogging]")
+{
+    auto& sink = wil::trace_memory_sink::instance();
+    sink.clear();
+
+    SECTION("Captures event name, fields and sizes")
+    {
+        TestProvider::Event2(42, 3.5);
+
+        REQUIRE(sink.size() == 1);
+        REQUIRE(sink.total_events() == 1);
+        REQUIRE(sink.total_payload_bytes() == sizeof(int) + sizeof(double));
+
+        wil::trace_memory_sink_event event{};
+        REQUIRE(sink.try_get(0, event));
+        REQUIRE(strcmp(event.name, "Event2") == 0);
+        REQUIRE(event.fieldCount == 2);
+        REQUIRE(strcmp(event.fieldNames, "param0;param1") == 0);
+        REQUIRE(event.payloadSize == sizeof(int) + sizeof(double));
+        REQUIRE(event.metadataSize > 0);
+        REQUIRE_FALSE(sink.try_get(1, event));
+    }
+
+    SECTION("Retains only the most recent events")
+    {
+        for (UINT32 index = 0; index <= WIL_TRACELOGGING_MEMORY_SINK_CAPACITY; index++)
+        {
+            TestProvider::EventUInt32(index);
+        }
+        TestProvider::Event0();
+
+        REQUIRE(sink.size() == WIL_TRACELOGGING_MEMORY_SINK_CAPACITY);
+        REQUIRE(sink.total_events() == WIL_TRACELOGGING_MEMORY_SINK_CAPACITY + 2);
+        REQUIRE(sink.total_payload_bytes() == (WIL_TRACELOGGING_MEMORY_SINK_CAPACITY + 1) * sizeof(UINT32));
+
+        wil::trace_memory_sink_event event{};
+        REQUIRE(sink.try_get(0, event));
+        REQUIRE(strcmp(event.name, "EventUInt32") == 0);
+        REQUIRE(sink.try_get(WIL_TRACELOGGING_MEMORY_SINK_CAPACITY - 1, event));
+        REQUIRE(strcmp(event.name, "Event0") == 0);
+        REQUIRE(event.fieldCount == 0);
+        REQUIRE(event.payloadSize == 0);
+    }
+
+    SECTION("Activities write start and stop events")
+    {
+        {
+            auto activity = TestProvider::TraceloggingActivity::Start();
+        }
+
+        REQUIRE(sink.size() == 2);
+        wil::trace_memory_sink_event start{};
+        wil::trace_memory_sink_event stop{};
+        REQUIRE(sink.try_get(0, start));
+        REQUIRE(sink.try_get(1, stop));
+        REQUIRE(start.opcode == WINEVENT_OPCODE_START);
+        REQUIRE(stop.opcode == WINEVENT_OPCODE_STOP);
+        REQUIRE(strcmp(start.name, stop.name) == 0);
+        REQUIRE(IsEqualGUID(start.activityId, stop.activityId));
+    }
+
+    sink.clear();
+}
+
+TEST_CASE("TraceLoggingMemorySinkTests::BatchedEvents", "[tracelogging]")
+{
+    auto& sink = wil::trace_memory_sink::instance();
+    TestProvider::FlushPeriodicEvents();
+    sink.clear();
+
+    TestProvider::BatchedEvent2(1, 1.0);
+    TestProvider::BatchedEvent2(2, 2.0);
+    TestProvider::BatchedEvent2(3, 3.0);
+    REQUIRE(sink.size() == 0);
+
+    TestProvider::FlushPeriodicEvents();
+
+    // Each processor buffers separately, so the three calls may arrive in more than one event
+    size_t const entrySize = sizeof(int) + sizeof(double);
+    REQUIRE(sink.size() >= 1);
+    REQUIRE(sink.size() <= 3);
+    REQUIRE(sink.total_payload_bytes() == (sink.size() * sizeof(UINT16)) + (3 * entrySize));
+    for (size_t index = 0; index < sink.size(); index++)
+    {
+        wil::trace_memory_sink_event event{};
+        REQUIRE(sink.try_get(index, event));
+        REQUIRE(strcmp(event.name, "BatchedEvent2") == 0);
+        REQUIRE(strcmp(event.fieldNames, "events;param0;param1") == 0);
+    }
+
+    sink.clear();
+    TestProvider::FlushPeriodicEvents();
+    REQUIRE(sink.size() == 0);
+}
+
+TEST_CASE("TraceLoggingMemorySinkTests::FastActivityId", "[tracelogging]")
+{
+    auto& sink = wil::trace_memory_sink::instance();
+    sink.clear();
+
+    {
+        auto first = TestProvider::Activity_FastActivityId::Start();
+        auto second = TestProvider::Activity_FastActivityId::Start();
+    }
+
+    REQUIRE(sink.size() == 4);
+    wil::trace_memory_sink_event first{};
+    wil::trace_memory_sink_event second{};
+    REQUIRE(sink.try_get(0, first));
+    REQUIRE(sink.try_get(1, second));
+    REQUIRE(first.opcode == WINEVENT_OPCODE_START);
+    REQUIRE(second.opcode == WINEVENT_OPCODE_START);
+
+    // Ids share the per-process prefix, differ in the counter and are well-formed version 4 GUIDs
+    REQUIRE_FALSE(IsEqualGUID(first.activityId, second.activityId));
+    REQUIRE(memcmp(&first.activityId, &second.activityId, offsetof(GUID, Data4) + 1) == 0);
+    REQUIRE((first.activityId.Data3 & 0xF000) == 0x4000);
+    REQUIRE((first.activityId.Data4[0] & 0xC0) == 0x80);
+
+    sink.clear();
+}
+
+TEST_CASE("TraceLoggingMemorySinkTests::EventArgumentConversions", "[tracelogging]")
+{
+    auto& sink = wil::trace_memory_sink::instance();
+    sink.clear();
+
+    // Arguments of differing types all convert to the declared field types and produce the same event layout
+    int const param0 = 7;
+    float param1 = 1.5f;
+    TestProvider::Event2(param0, param1);
+    TestProvider::Event2(static_cast<short>(8), 2.5);
+    TestProvider::Event2(9L, 3);
+
+    REQUIRE(sink.size() == 3);
+    REQUIRE(sink.total_payload_bytes() == 3 * (sizeof(int) + sizeof(double)));
+    for (size_t index = 0; index < 3; index++)
+    {
+        wil::trace_memory_sink_event event{};
+        REQUIRE(sink.try_get(index, event));
+        REQUIRE(strcmp(event.name, "Event2") == 0);
+        REQUIRE(strcmp(event.fieldNames, "param0;param1") == 0);
+    }
+
+    sink.clear();
+}
+
+TEST_CASE("TraceLoggingMemorySinkTests::AggregateDuration", "[tracelogging]")
+{
+    auto& sink = wil::trace_memory_sink::instance();
+    TestProvider::FlushPeriodicEvents();
+    sink.clear();
+
+    // Successful activities write no start or stop events; their durations go into the histogram instead
+    ULONG const stopCount = 5;
+    for (ULONG index = 0; index < stopCount; index++)
+    {
+        auto activity = TestProvider::Activity_AggregateDuration::Start();
+        ::Sleep(2);
+    }
+    REQUIRE(sink.size() == 0);
+
+    TestProvider::FlushPeriodicEvents();
+    REQUIRE(sink.size() == 1);
+    wil::trace_memory_sink_event summary{};
+    REQUIRE(sink.try_get(0, summary));
+    REQUIRE(strcmp(summary.name, "ActivityDurationSummary") == 0);
+    PCSTR const summaryFields =
+        "activityName;count;meanMicroseconds;p50Microseconds;p90Microseconds;p99Microseconds;maxMicroseconds";
+    REQUIRE(strcmp(summary.fieldNames, summaryFields) == 0);
+
+    // The payload starts with the activity name, then the count and the mean, percentiles and maximum in microseconds
+    auto const activityName = reinterpret_cast<PCSTR>(summary.payload);
+    REQUIRE(strcmp(activityName, "Activity_AggregateDuration") == 0);
+    ULONGLONG values[6]{};
+    auto const valuesOffset = strlen(activityName) + 1;
+    REQUIRE(valuesOffset + sizeof(values) <= sizeof(summary.payload));
+    memcpy(values, summary.payload + valuesOffset, sizeof(values));
+    REQUIRE(values[0] == stopCount);
+    REQUIRE(values[1] >= 1000);      // each activity lasted about 2ms
+    REQUIRE(values[2] <= values[3]); // p50 <= p90
+    REQUIRE(values[3] <= values[4]); // p90 <= p99
+    REQUIRE(values[4] <= values[5]); // p99 <= max
+    REQUIRE(values[5] >= values[1]); // buckets report their highest value, so max is at least the mean
+
+    // Nothing is written once the histogram has been drained
+    sink.clear();
+    TestProvider::FlushPeriodicEvents();
+    REQUIRE(sink.size() == 0);
+
+    // A failed activity still writes its stop event
+    {
+        auto activity = TestProvider::Activity_AggregateDuration::Start();
+        activity.SetStopResult(E_FAIL);
+    }
+    REQUIRE(sink.size() == 1);
+    wil::trace_memory_sink_event stop{};
+    REQUIRE(sink.try_get(0, stop));
+    REQUIRE(stop.opcode == WINEVENT_OPCODE_STOP);
+    REQUIRE(strcmp(stop.name, "Activity_AggregateDuration") == 0);
+
+    TestProvider::FlushPeriodicEvents();
+    sink.clear();
+}
+
+TEST_CASE("TraceLoggingMemorySinkTests::EnableCallbackWritesEvent", "[tracelogging]")
+{
+    auto& sink = wil::trace_memory_sink::instance();
+    auto const provider = RundownProvider::Provider();
+    RundownProvider::s_rundownOnEnable = true;
+    sink.clear();
+
+    // The sink must not hold its event lock while the callback runs, or this write would deadlock or time out
+    REQUIRE_SUCCEEDED(sink.enable_provider(provider));
+    REQUIRE(sink.size() == 1);
+    wil::trace_memory_sink_event event{};
+    REQUIRE(sink.try_get(0, event));
+    REQUIRE(strcmp(event.name, "Rundown") == 0);
+
+    RundownProvider::s_rundownOnEnable = false;
+    sink.clear();
+}
+
+TEST_CASE("TraceLoggingMemorySinkTests::CachedEventsWrite", "[tracelogging]")
+{
+    auto& sink = wil::trace_memory_sink::instance();
+    sink.clear();
+    TestProvider::Event1(1);
+    TestProvider::TelemetryEvent1(2);
+    REQUIRE(sink.size() == 2);
+    sink.clear();
+}
+
+TEST_CASE("TraceLoggingMemorySinkTests::EnablementCacheRefresh", "[tracelogging]")
+{
+    auto& sink = wil::trace_memory_sink::instance();
+    auto const provider = TestProvider::Provider();
+    REQUIRE(TestProvider::IsEventEnabled<WINEVENT_LEVEL_VERBOSE, 0>());
+    REQUIRE(TestProvider::IsEventEnabled<WINEVENT_LEVEL_ERROR, MICROSOFT_KEYWORD_TELEMETRY>());
+
+    // Each change goes through the provider's enable callback, which refreshes the bits already assigned above
+    REQUIRE_SUCCEEDED(sink.disable_provider(provider));
+    REQUIRE_FALSE(TestProvider::IsEventEnabled<WINEVENT_LEVEL_VERBOSE, 0>());
+    REQUIRE_FALSE(TestProvider::IsEventEnabled<WINEVENT_LEVEL_ERROR, MICROSOFT_KEYWORD_TELEMETRY>());
+    REQUIRE_FALSE(TestProvider::IsEnabled());
+
+    sink.clear();
+    TestProvider::Event1(1);
+    TestProvider::TelemetryEvent1(2);
+    REQUIRE(sink.size() == 0);
+
+    REQUIRE_SUCCEEDED(sink.enable_provider(provider, WINEVENT_LEVEL_ERROR, MICROSOFT_KEYWORD_TELEMETRY));
+    REQUIRE_FALSE(TestProvider::IsEventEnabled<WINEVENT_LEVEL_VERBOSE, 0>());
+    REQUIRE(TestProvider::IsEventEnabled<WINEVENT_LEVEL_ERROR, MICROSOFT_KEYWORD_TELEMETRY>());
+    REQUIRE(TestProvider::IsEventEnabled<WINEVENT_LEVEL_ERROR, 0>() == TestProvider::IsEnabled(WINEVENT_LEVEL_ERROR, 0));
+
+    REQUIRE_SUCCEEDED(sink.enable_provider(provider));
+    REQUIRE(TestProvider::IsEventEnabled<WINEVENT_LEVEL_VERBOSE, 0>());
+    TestProvider::Event1(3);
+    REQUIRE(sink.size() == 1);
+    sink.clear();
+}
+
+// Counts the conversions to the declared field type, which only happen once an event passes its inline check
+struct counted_int
+{
+    static int s_conversions;
+
+    operator int() const
+    {
+        ++s_conversions;
+        return 0;
+    }
+};
+
+int counted_int::s_conversions = 0;
+
+TEST_CASE("TraceLoggingMemorySinkTests::KeywordEventsCheckTheirKeyword", "[tracelogging]")
+{
+    auto& sink = wil::trace_memory_sink::instance();
+    auto const provider = TestProvider::Provider();
+    sink.clear();
+    counted_int::s_conversions = 0;
+
+    // Telemetry events are checked against their keyword before the writer is called; generic events only against
+    // the provider being enabled, as their level and keywords are only known to TraceLoggingWrite
+    REQUIRE_SUCCEEDED(sink.enable_provider(provider, WINEVENT_LEVEL_VERBOSE, MICROSOFT_KEYWORD_MEASURES));
+    TestProvider::TelemetryEvent1(counted_int{});
+    REQUIRE(counted_int::s_conversions == 0);
+    TestProvider::MeasuresEvent1(counted_int{});
+    REQUIRE(counted_int::s_conversions == 1);
+    TestProvider::Event1(counted_int{});
+    REQUIRE(counted_int::s_conversions == 2);
+
+    REQUIRE_SUCCEEDED(sink.enable_provider(provider));
+    TestProvider::TelemetryEvent1(counted_int{});
+    REQUIRE(counted_int::s_conversions == 3);
+    sink.clear();
+}
@@ -3,3 +3,54 @@
 // Just verify that Tracelogging.h compiles.
 #define PROVIDER_CLASS_NAME TestProvider
 #include "TraceLoggingTests.h"
+
+#include "common.h"
+
+TEST_CASE("TraceLoggingTests::CallContextMessage", "[tracelogging]")
+{
+    std::wstring message;
+    auto monitor = wil::ThreadFailureCallback([&](wil::FailureInfo const& failure) -> bool {
+        message = (failure.callContextCurrent.contextMessage != nullptr) ? failure.callContextCurrent.contextMessage : L"";
+        return false;
+    });
+
+    SECTION("Value arguments are formatted when a failure occurs")
+    {
+        auto activity = TestProvider::Activity::Start();
+        activity.SetMessage("count %d, size %Iu, ratio %.2f, char %c", 42, static_cast<size_t>(7), 0.5, 'x');
+        LOG_HR(E_FAIL);
+        REQUIRE(message == L"count 42, size 7, ratio 0.50, char x");
+    }
+
+    SECTION("String arguments are formatted immediately")
+    {
+        auto activity = TestProvider::Activity::Start();
+        {
+            std::string name("temporary");
+            activity.SetMessage("name %hs, width %*d", name.c_str(), 4, 1);
+        }
+        LOG_HR(E_FAIL);
+        REQUIRE(message == L"name temporary, width    1");
+    }
+
+    SECTION("Copies of the context keep the deferred message")
+    {
+        auto activity = TestProvider::Activity::Start();
+        activity.SetMessage("id %I64u", 1234567890123ull);
+        auto watcher = activity.ContinueOnCurrentThread();
+        LOG_HR(E_FAIL);
+        REQUIRE(message == L"id 1234567890123");
+    }
+}
+
+TEST_CASE("TraceLoggingTests::EnablementCache", "[tracelogging]")
+{
+    // The first query assigns a cache slot, later ones read the cached bit; both agree with TraceLogging
+    for (int pass = 0; pass < 2; pass++)
+    {
+        REQUIRE(TestProvider::IsEventEnabled<WINEVENT_LEVEL_VERBOSE, 0>() == TestProvider::IsEnabled(WINEVENT_LEVEL_VERBOSE, 0));
+        REQUIRE(
+            TestProvider::IsEventEnabled<WINEVENT_LEVEL_ERROR, MICROSOFT_KEYWORD_TELEMETRY>() ==
+            TestProvider::IsEnabled(WINEVENT_LEVEL_ERROR, MICROSOFT_KEYWORD_TELEMETRY));
+    }
+}
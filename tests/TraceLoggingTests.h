@@ -14,6 +14,8 @@ class PROVIDER_CLASS_NAME : wil::TraceLoggingProvider
 public:
     DEFINE_CUSTOM_ACTIVITY(Activity);
     DEFINE_CUSTOM_ACTIVITY(Activity_Params, wil::ActivityOptions::None, WINEVENT_KEYWORD_WDI_DIAG, WINEVENT_LEVEL_VERBOSE);
+    DEFINE_CUSTOM_ACTIVITY(Activity_AggregateDuration, wil::ActivityOptions::AggregateDuration);
+    DEFINE_CUSTOM_ACTIVITY(Activity_FastActivityId, wil::ActivityOptions::FastActivityId);
 
     BEGIN_CUSTOM_ACTIVITY_CLASS(CustomActivity)
     DEFINE_TAGGED_EVENT_METHOD(Custom)(const std::wstring& str)
@@ -53,6 +55,10 @@ public:
     DEFINE_TRACELOGGING_EVENT_UINT32(EventUInt32, value);
     DEFINE_TRACELOGGING_EVENT_BOOL(EventBool, value);
     DEFINE_TRACELOGGING_EVENT_STRING(EventString, value);
+    DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM1(BatchedEvent1, int, param0);
+    DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM2(BatchedEvent2, int, param0, double, param1);
+    DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM3(BatchedEvent3, int, param0, double, param1, bool, param2);
+    DEFINE_TRACELOGGING_BATCHED_EVENT_PARAM4(BatchedEvent4, int, param0, double, param1, bool, param2, GUID, param3);
     DEFINE_EVENT_METHOD(Custom)(const std::wstring& str)
     {
         TraceLoggingWrite(Provider(), "Custom", TraceLoggingValue(str.c_str(), "str"));
@@ -5,6 +5,7 @@
 #include <wil/resource.h>
 
 #include <memory>         // For shared_event_watcher
+#include <vector>
 #include <wil/resource.h> // NOLINT(readability-duplicate-include): Intentionally testing "light up" code
 
 #include "common.h"
@@ -218,6 +219,93 @@ TEST_CASE("EventWatcherTests::VerifyLastChangeObserved", "[resource][event_watch
     }
 }
 
+TEST_CASE("EventWatcherTests::VerifyGroupDelivery", "[resource][event_watcher]")
+{
+    // Use more watchers than one wait block holds so that several blocks are exercised.
+    const LONG watcherCount = 2 * MAXIMUM_WAIT_OBJECTS + 5;
+    wil::event_watcher_group group;
+    auto allDelivered = make_event(wil::EventOptions::ManualReset);
+    LONG volatile countObserved = 0;
+
+    std::vector<wil::unique_group_event_watcher> watchers;
+    for (LONG i = 0; i < watcherCount; ++i)
+    {
+        watchers.emplace_back(group.make_event_watcher_nothrow([&] {
+            if (InterlockedIncrement(&countObserved) == watcherCount)
+            {
+                allDelivered.SetEvent();
+            }
+        }));
+        REQUIRE(watchers.back() != nullptr);
+    }
+
+    for (auto& watcher : watchers)
+    {
+        watcher.SetEvent();
+    }
+    REQUIRE(allDelivered.wait(5000)); // 5 second max wait
+    REQUIRE(countObserved == watcherCount);
+
+    // The waits were re-armed, so a second signal is delivered too.
+    allDelivered.ResetEvent();
+    countObserved = 0;
+    for (auto& watcher : watchers)
+    {
+        watcher.SetEvent();
+    }
+    REQUIRE(allDelivered.wait(5000)); // 5 second max wait
+
+    // Released watchers stop receiving notifications and free their slot for reuse.
+    auto notificationReceived = make_event();
+    watchers.clear();
+    auto manualStart = group.make_event_watcher_nothrow(wil::event_watcher_options::manual_start, [&] {
+        notificationReceived.SetEvent();
+    });
+    REQUIRE(manualStart != nullptr);
+    manualStart.SetEvent();
+    REQUIRE_FALSE(notificationReceived.wait(500));
+    manualStart.start();
+    REQUIRE(notificationReceived.wait(5000)); // 5 second max wait
+
+    // A watcher created from an existing handle sees signals on the original event.
+    auto watchedEvent = make_event(wil::EventOptions::ManualReset);
+    auto duplicated = group.make_event_watcher_nothrow(watchedEvent.get(), [&] {
+        notificationReceived.SetEvent();
+    });
+    REQUIRE(duplicated != nullptr);
+    watchedEvent.SetEvent();
+    REQUIRE(notificationReceived.wait(5000)); // 5 second max wait
+}
+
+TEST_CASE("EventWatcherTests::VerifyGroupCallbackReleasesSibling", "[resource][event_watcher]")
+{
+    // Both watchers share a block, so the second callback may be queued behind the first when the first releases it.
+    wil::event_watcher_group group;
+    auto firstDone = make_event(wil::EventOptions::ManualReset);
+    LONG volatile secondCalledAfterRelease = 0;
+    bool secondReleased = false;
+    wil::unique_group_event_watcher second;
+    auto first = group.make_event_watcher_nothrow([&] {
+        second.reset();
+        secondReleased = true;
+        firstDone.SetEvent();
+    });
+    REQUIRE(first != nullptr);
+    second = group.make_event_watcher_nothrow([&] {
+        if (secondReleased)
+        {
+            InterlockedIncrement(&secondCalledAfterRelease);
+        }
+    });
+    REQUIRE(second != nullptr);
+
+    second.SetEvent();
+    first.SetEvent();
+    REQUIRE(firstDone.wait(5000)); // 5 second max wait
+    REQUIRE(second == nullptr);
+    REQUIRE(secondCalledAfterRelease == 0);
+}
+
 #define ROOT_KEY_PAIR HKEY_CURRENT_USER, L"Software\\Microsoft\\RegistryWatcherTest"
 
 TEST_CASE("RegistryWatcherTests::Construction", "[registry][registry_watcher]")
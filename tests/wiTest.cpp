@@ -10,10 +10,12 @@
 #include <wil/com.h>
 
 #ifdef WIL_ENABLE_EXCEPTIONS
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 #endif
 
 // Do not include most headers until after the WIL headers to ensure that we're not inadvertently adding any unnecessary
@@ -1331,6 +1333,56 @@ TEST_CASE("WindowsInternalTests::SharedHandle", "[resource][shared_any]")
     set.insert(sp1);
     set.insert(sp2);
 }
+
+TEST_CASE("WindowsInternalTests::CompactSharedHandle", "[resource][shared_any]")
+{
+    static_assert(sizeof(wil::compact_shared_handle) == sizeof(void*), "compact_shared_any must be a single pointer");
+
+    wil::compact_shared_handle spValid(::CreateEventEx(nullptr, nullptr, CREATE_EVENT_INITIAL_SET, 0));
+    auto ptr = spValid.get();
+    REQUIRE(ptr != nullptr);
+    REQUIRE(spValid.use_count() == 1);
+
+    // copy and move share the single allocation
+    wil::compact_shared_handle spCopy = spValid;
+    REQUIRE(spCopy.get() == ptr);
+    REQUIRE(spValid.use_count() == 2);
+    wil::compact_shared_handle spMove = wistd::move(spCopy);
+    REQUIRE(spMove.get() == ptr);
+    REQUIRE_FALSE(spCopy);
+    REQUIRE(spValid.use_count() == 2);
+    spMove = spValid;
+    REQUIRE(spValid.use_count() == 2);
+    spMove.reset();
+    REQUIRE(spValid.use_count() == 1);
+
+    // unique construction, put and events
+    wil::compact_shared_handle spFromUnique = wil::unique_handle(::CreateEventEx(nullptr, nullptr, CREATE_EVENT_INITIAL_SET, 0));
+    REQUIRE(spFromUnique);
+    *spFromUnique.put() = ::CreateEventEx(nullptr, nullptr, CREATE_EVENT_INITIAL_SET, 0);
+    REQUIRE(spFromUnique);
+    wil::compact_shared_event event(wil::EventOptions::ManualReset);
+    auto eventCopy = event;
+    eventCopy.SetEvent();
+    REQUIRE(event.is_signaled());
+
+    // weak references, only available when requested
+    using weak_capable = wil::compact_shared_any<wil::unique_handle, true>;
+    weak_capable spStrong(::CreateEventEx(nullptr, nullptr, CREATE_EVENT_INITIAL_SET, 0));
+    wil::weak_any<weak_capable> weak = spStrong;
+    auto weakCopy = weak;
+    REQUIRE(weak.lock().get() == spStrong.get());
+    REQUIRE(spStrong.use_count() == 1);
+    spStrong.reset();
+    REQUIRE(weak.expired());
+    REQUIRE(weakCopy.expired());
+    REQUIRE_FALSE(weak.lock());
+
+    std::unordered_set<wil::compact_shared_handle> hashSet;
+    hashSet.insert(spValid);
+    hashSet.insert(spFromUnique);
+    REQUIRE(hashSet.size() == 2);
+}
 #endif
 
 template <typename event_t>
@@ -1972,6 +2024,73 @@ TEST_CASE("WindowsInternalTests::Locking", "[resource]")
         }
     }
 
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+    {
+        wil::sharded_rwlock rwlock;
+        {
+            auto lock = rwlock.lock_exclusive();
+            REQUIRE(lock);
+
+            auto lockRecursive = rwlock.try_lock_exclusive();
+            REQUIRE_FALSE(lockRecursive);
+
+            auto lockRecursiveShared = rwlock.try_lock_shared();
+            REQUIRE_FALSE(lockRecursiveShared);
+        }
+        {
+            auto lock = rwlock.lock_shared();
+            REQUIRE(lock);
+
+            auto lockRecursive = rwlock.try_lock_shared();
+            REQUIRE(lockRecursive);
+
+            auto lockRecursiveExclusive = rwlock.try_lock_exclusive();
+            REQUIRE_FALSE(lockRecursiveExclusive);
+        }
+        {
+            auto lock = rwlock.try_lock_exclusive();
+            REQUIRE(lock);
+        }
+        {
+            auto lock = rwlock.try_lock_shared();
+            REQUIRE(lock);
+        }
+
+        // Writers must wait for readers on every shard and exclude each other.
+        int value = 0;
+        LONG torn = 0;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i)
+        {
+            threads.emplace_back([&, i] {
+                for (int iteration = 0; iteration < 1000; ++iteration)
+                {
+                    if ((iteration % 10) == i)
+                    {
+                        auto lock = rwlock.lock_exclusive();
+                        value++;
+                        value++;
+                    }
+                    else
+                    {
+                        auto lock = rwlock.lock_shared();
+                        if ((value % 2) != 0)
+                        {
+                            InterlockedIncrement(&torn);
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        REQUIRE(torn == 0);
+        REQUIRE(value == 8 * 100 * 2);
+    }
+#endif
+
     {
         CRITICAL_SECTION lock;
         ::InitializeCriticalSectionEx(&lock, 0, 0);
@@ -3690,8 +3809,598 @@ TEST_CASE("WindowsInternalTests::SlimEventTests", "[resource][slim_event]")
         REQUIRE_FALSE(manualResetEvent.wait(/*timeout(ms)*/ 10));
     }
 }
+
+TEST_CASE("WindowsInternalTests::SlimSemaphoreLatchBarrierTests", "[resource][slim_event]")
+{
+    {
+        wil::slim_semaphore semaphore(1, /*spinCount*/ 100);
+        REQUIRE(semaphore.wait(/*timeout(ms)*/ 0));
+        REQUIRE_FALSE(semaphore.try_acquire());
+        REQUIRE_FALSE(semaphore.wait(/*timeout(ms)*/ 10));
+
+        LONG previousCount = -1;
+        semaphore.ReleaseSemaphore(2, &previousCount);
+        REQUIRE(previousCount == 0);
+        REQUIRE(semaphore.count() == 2);
+
+        REQUIRE(semaphore.wait(/*timeout(ms)*/ 0));
+        REQUIRE(semaphore.wait(/*timeout(ms)*/ 0));
+        REQUIRE(semaphore.count() == 0);
+    }
+
+    {
+        // Each side only acquires a count the other side released, so neither can take its own release.
+        wil::slim_semaphore request(0);
+        wil::slim_semaphore reply(0);
+        bool threadAcquired = false;
+        std::thread worker([&] {
+            threadAcquired = request.wait(/*timeout(ms)*/ 10000);
+            reply.ReleaseSemaphore();
+        });
+        request.ReleaseSemaphore();
+        const bool mainAcquired = reply.wait(/*timeout(ms)*/ 10000);
+        worker.join();
+        REQUIRE(threadAcquired);
+        REQUIRE(mainAcquired);
+        REQUIRE(request.count() == 0);
+        REQUIRE(reply.count() == 0);
+    }
+
+    {
+        wil::slim_latch latch(3);
+        REQUIRE_FALSE(latch.try_wait());
+        REQUIRE_FALSE(latch.wait(/*timeout(ms)*/ 10));
+
+        std::thread worker([&] { latch.count_down(2); });
+        latch.arrive_and_wait();
+        worker.join();
+        REQUIRE(latch.try_wait());
+        REQUIRE(latch.wait(/*timeout(ms)*/ 0));
+    }
+
+    {
+        const int threadCount = 4;
+        const int phaseCount = 50;
+        wil::slim_barrier barrier(threadCount, /*spinCount*/ 100);
+        LONG arrived = 0;
+        LONG lastArrivals = 0;
+        LONG inconsistentPhases = 0;
+
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&] {
+                for (int phase = 0; phase < phaseCount; ++phase)
+                {
+                    InterlockedIncrement(&arrived);
+                    if (barrier.arrive_and_wait())
+                    {
+                        InterlockedIncrement(&lastArrivals);
+                    }
+                    // Every thread has arrived at this phase before any is released from it.
+                    if (ReadAcquire(&arrived) < (phase + 1) * threadCount)
+                    {
+                        InterlockedIncrement(&inconsistentPhases);
+                    }
+                    barrier.arrive_and_wait();
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(inconsistentPhases == 0);
+        REQUIRE(arrived == threadCount * phaseCount);
+        REQUIRE(lastArrivals == phaseCount);
+    }
+}
 #endif // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
 
+#ifdef WIL_ENABLE_LOCK_CONTENTION_PROFILING
+TEST_CASE("WindowsInternalTests::LockContentionProfiling", "[resource]")
+{
+    auto findStatistics = [](const void* lock) {
+        wil::lock_contention_statistics found{};
+        wil::for_each_lock_contention([&](const wil::lock_contention_statistics& statistics) {
+            if (statistics.lock == lock)
+            {
+                found = statistics;
+            }
+        });
+        return found;
+    };
+
+    // Waits until another thread is queued on the held lock, so releasing it is guaranteed to be contended. An SRWLOCK sets
+    // its waiting bit (0x2) once a thread has queued, and a critical section's LockCount holds the ones' complement of the
+    // number of waiters above its two low bits.
+    auto waitForSrwlockWaiter = [](SRWLOCK* srwlock) {
+        while ((reinterpret_cast<ULONG_PTR>(ReadPointerAcquire(&srwlock->Ptr)) & 0x2) == 0)
+        {
+            Sleep(1);
+        }
+    };
+    auto waitForCriticalSectionWaiter = [](CRITICAL_SECTION* criticalSection) {
+        while (((-1 - ReadAcquire(&criticalSection->LockCount)) >> 2) == 0)
+        {
+            Sleep(1);
+        }
+    };
+
+    wil::srwlock lock;
+    wil::critical_section cs;
+    {
+        // Uncontended acquisitions are not recorded.
+        auto exclusive = lock.lock_exclusive();
+        auto entered = cs.lock();
+    }
+    REQUIRE(findStatistics(&lock).contentionCount == 0);
+    REQUIRE(findStatistics(&cs).contentionCount == 0);
+
+    {
+        auto exclusive = lock.lock_exclusive();
+        auto entered = cs.lock();
+        std::thread srwlockWaiter([&] {
+            auto shared = lock.lock_shared();
+        });
+        std::thread csWaiter([&] {
+            auto waited = cs.lock();
+        });
+        waitForSrwlockWaiter(exclusive.get());
+        waitForCriticalSectionWaiter(entered.get());
+        exclusive.reset();
+        entered.reset();
+        srwlockWaiter.join();
+        csWaiter.join();
+    }
+
+    const auto srwlockStatistics = findStatistics(&lock);
+    REQUIRE(srwlockStatistics.contentionCount == 1);
+    REQUIRE(strcmp(srwlockStatistics.lockType, "srwlock") == 0);
+    REQUIRE(srwlockStatistics.lastHolderThreadId == GetCurrentThreadId());
+    REQUIRE(srwlockStatistics.maxWaitMicroseconds <= srwlockStatistics.totalWaitMicroseconds);
+    REQUIRE(srwlockStatistics.lastContendedCallsite != nullptr);
+
+    const auto csStatistics = findStatistics(&cs);
+    REQUIRE(csStatistics.contentionCount == 1);
+    REQUIRE(csStatistics.lastHolderThreadId == GetCurrentThreadId());
+    REQUIRE(strcmp(csStatistics.lockType, "critical_section") == 0);
+
+    {
+        // An owner that took the lock with try_lock_exclusive is reported as the holder too.
+        wil::srwlock tryLocked;
+        auto exclusive = tryLocked.try_lock_exclusive();
+        REQUIRE(exclusive.get() != nullptr);
+        std::thread waiter([&] {
+            auto shared = tryLocked.lock_shared();
+        });
+        waitForSrwlockWaiter(exclusive.get());
+        exclusive.reset();
+        waiter.join();
+        REQUIRE(findStatistics(&tryLocked).lastHolderThreadId == GetCurrentThreadId());
+    }
+
+    // Destroyed locks leave the registry.
+    const void* destroyedLock{};
+    {
+        wil::srwlock shortLived;
+        destroyedLock = &shortLived;
+        auto exclusive = shortLived.lock_exclusive();
+        std::thread waiter([&] {
+            auto shared = shortLived.lock_shared();
+        });
+        waitForSrwlockWaiter(exclusive.get());
+        exclusive.reset();
+        waiter.join();
+        REQUIRE(findStatistics(destroyedLock).contentionCount == 1);
+    }
+    REQUIRE(findStatistics(destroyedLock).contentionCount == 0);
+}
+#endif // WIL_ENABLE_LOCK_CONTENTION_PROFILING
+
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN7)
+struct CountingBatchItem : wil::threadpool_batch_item
+{
+    LONG* runCount = nullptr;
+    LONG timesRun = 0;
+
+    void run() WI_NOEXCEPT override
+    {
+        ++timesRun;
+        ::InterlockedIncrement(runCount);
+    }
+};
+
+TEST_CASE("WindowsInternalTests::ThreadpoolBatchAndParallelFor", "[resource][threadpool]")
+{
+    SECTION("Every pushed item runs exactly once")
+    {
+        LONG runCount = 0;
+        CountingBatchItem items[500];
+        wil::threadpool_batch_nothrow batch;
+        REQUIRE_SUCCEEDED(batch.create());
+        for (auto& item : items)
+        {
+            item.runCount = &runCount;
+            batch.push(item);
+        }
+        batch.submit();
+        batch.wait();
+        batch.run_pending(); // nothing should be left for the caller
+        REQUIRE(runCount == ARRAYSIZE(items));
+        for (auto& item : items)
+        {
+            REQUIRE(item.timesRun == 1);
+        }
+    }
+
+    SECTION("parallel_for visits each index once, including uneven chunks and empty ranges")
+    {
+        std::vector<LONG> visits(10007);
+        REQUIRE_SUCCEEDED(wil::parallel_for_nothrow(size_t{0}, visits.size(), [&](size_t i) {
+            ::InterlockedIncrement(&visits[i]);
+        }));
+        REQUIRE(std::all_of(visits.begin(), visits.end(), [](LONG count) {
+            return count == 1;
+        }));
+
+        std::fill(visits.begin(), visits.end(), 0);
+        REQUIRE_SUCCEEDED(wil::parallel_for_nothrow(
+            -5, 95, [&](int i) {
+                ::InterlockedIncrement(&visits[i + 5]);
+            },
+            7));
+        REQUIRE(std::count(visits.begin(), visits.begin() + 100, 1) == 100);
+        REQUIRE(std::count(visits.begin() + 100, visits.end(), 0) == static_cast<ptrdiff_t>(visits.size() - 100));
+
+        // Ranges at the limits of a signed type, where the index arithmetic must not overflow
+        std::fill(visits.begin(), visits.end(), 0);
+        REQUIRE_SUCCEEDED(wil::parallel_for_nothrow(
+            LLONG_MAX - 100, LLONG_MAX, [&](long long i) {
+                ::InterlockedIncrement(&visits[static_cast<size_t>(LLONG_MAX - i)]);
+            },
+            3));
+        REQUIRE_SUCCEEDED(wil::parallel_for_nothrow(
+            LLONG_MIN, LLONG_MIN + 100, [&](long long i) {
+                ::InterlockedIncrement(&visits[static_cast<size_t>(i - LLONG_MIN) + 101]);
+            },
+            3));
+        REQUIRE(visits[0] == 0);
+        REQUIRE(std::count(visits.begin() + 1, visits.begin() + 201, 1) == 200);
+
+        bool called = false;
+        REQUIRE_SUCCEEDED(wil::parallel_for_nothrow(10, 10, [&](int) {
+            called = true;
+        }));
+        REQUIRE_FALSE(called);
+    }
+
+#ifdef WIL_ENABLE_EXCEPTIONS
+    SECTION("Idle workers steal from a worker with expensive indices")
+    {
+        // Index 0 stalls its worker; the rest of that worker's share must be finished by the others meanwhile.
+        wil::unique_event othersDone(wil::EventOptions::ManualReset);
+        LONG remaining = 999;
+        wil::parallel_for(
+            0, 1000, [&](int i) {
+                if (i == 0)
+                {
+                    othersDone.wait(5000);
+                }
+                else if (::InterlockedDecrement(&remaining) == 0)
+                {
+                    othersDone.SetEvent();
+                }
+            },
+            1);
+        REQUIRE(remaining == 0);
+    }
+#endif
+}
+#endif // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN7)
+
+struct TestTimerWheelEntry : wil::timer_wheel_entry
+{
+    LONG* remaining = nullptr;
+    HANDLE allFired = nullptr;
+    ULONGLONG scheduledAt = 0;
+    DWORD due = 0;
+    ULONGLONG firedAt = 0;
+    LONG timesFired = 0;
+
+    void on_timer_expired() WI_NOEXCEPT override
+    {
+        firedAt = ::GetTickCount64();
+        ++timesFired;
+        if (::InterlockedDecrement(remaining) == 0)
+        {
+            ::SetEvent(allFired);
+        }
+    }
+};
+
+TEST_CASE("WindowsInternalTests::TimerWheelTests", "[resource][threadpool]")
+{
+    wil::unique_event_nothrow allFired;
+    REQUIRE_SUCCEEDED(allFired.create(wil::EventOptions::ManualReset));
+
+    // Due times up to 1.5s on a 10ms tick place entries in the first two levels of the wheel and exercise cascading.
+    TestTimerWheelEntry entries[300];
+    TestTimerWheelEntry cancelled[10];
+    LONG remaining = ARRAYSIZE(entries);
+
+    wil::timer_wheel_nothrow wheel;
+    REQUIRE_SUCCEEDED(wheel.create(10));
+    for (ULONG i = 0; i < ARRAYSIZE(entries); ++i)
+    {
+        auto& entry = entries[i];
+        entry.remaining = &remaining;
+        entry.allFired = allFired.get();
+        entry.due = (i * 37) % 1500;
+        entry.scheduledAt = ::GetTickCount64();
+        wheel.schedule(entry, entry.due);
+    }
+
+    for (auto& entry : cancelled)
+    {
+        entry.remaining = &remaining;
+        entry.allFired = allFired.get();
+        wheel.schedule(entry, 50);
+        wheel.schedule(entry, 100); // rescheduling replaces the earlier due time
+        REQUIRE(wheel.cancel(entry));
+        REQUIRE_FALSE(wheel.cancel(entry));
+    }
+
+    REQUIRE(allFired.wait(10000));
+    for (auto& entry : entries)
+    {
+        REQUIRE(entry.timesFired == 1);
+        REQUIRE(entry.firedAt - entry.scheduledAt >= entry.due);
+    }
+
+    // Give the cancelled entries' original due times a chance to pass.
+    ::Sleep(200);
+    for (auto& entry : cancelled)
+    {
+        REQUIRE(entry.timesFired == 0);
+    }
+
+    // Entries still pending when the wheel is destroyed are dropped and can be scheduled again elsewhere.
+    {
+        wil::timer_wheel_nothrow shortLived;
+        REQUIRE_SUCCEEDED(shortLived.create(10));
+        shortLived.schedule(cancelled[0], 60 * 1000);
+    }
+    remaining = 1;
+    allFired.ResetEvent();
+    wheel.schedule(cancelled[0], 0);
+    REQUIRE(allFired.wait(10000));
+    REQUIRE(cancelled[0].timesFired == 1);
+}
+
+struct SlowTimerWheelEntry : wil::timer_wheel_entry
+{
+    HANDLE started = nullptr;
+    LONG finished = 0;
+
+    void on_timer_expired() WI_NOEXCEPT override
+    {
+        ::SetEvent(started);
+
+        // Outlast many ticks so that the threadpool timer fires again while this callback is still running.
+        ::Sleep(300);
+        ::InterlockedExchange(&finished, 1);
+    }
+};
+
+TEST_CASE("WindowsInternalTests::TimerWheelCancelDuringSlowCallback", "[resource][threadpool]")
+{
+    wil::unique_event_nothrow started;
+    wil::unique_event_nothrow allFired;
+    REQUIRE_SUCCEEDED(started.create(wil::EventOptions::ManualReset));
+    REQUIRE_SUCCEEDED(allFired.create(wil::EventOptions::ManualReset));
+
+    wil::timer_wheel_nothrow wheel;
+    REQUIRE_SUCCEEDED(wheel.create(10));
+
+    SlowTimerWheelEntry slow;
+    slow.started = started.get();
+    wheel.schedule(slow, 0);
+    REQUIRE(started.wait(10000));
+
+    // Expires on the ticks that overlap the slow callback; it is delivered once that callback returns.
+    TestTimerWheelEntry next;
+    LONG remaining = 1;
+    next.remaining = &remaining;
+    next.allFired = allFired.get();
+    next.due = 10;
+    next.scheduledAt = ::GetTickCount64();
+    wheel.schedule(next, next.due);
+
+    // Cancelling from this thread waits for the slow callback even though other ticks ran in the meantime.
+    REQUIRE_FALSE(wheel.cancel(slow));
+    REQUIRE(::InterlockedCompareExchange(&slow.finished, 0, 0) == 1);
+
+    REQUIRE(allFired.wait(10000));
+    REQUIRE(next.timesFired == 1);
+    REQUIRE(next.firedAt - next.scheduledAt >= next.due);
+}
+
+#if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN7)
+TEST_CASE("WindowsInternalTests::PrivateThreadpoolTests", "[resource][threadpool]")
+{
+    wil::unique_event_nothrow releaseDefaultPool;
+    REQUIRE_SUCCEEDED(releaseDefaultPool.create(wil::EventOptions::ManualReset));
+
+    // Tie up the default pool with more blocked callbacks than it has threads to start right away.
+    wil::unique_threadpool_work_nocancel blocker(::CreateThreadpoolWork(
+        [](PTP_CALLBACK_INSTANCE, void* context, PTP_WORK) {
+            ::WaitForSingleObject(static_cast<HANDLE>(context), 30000);
+        },
+        releaseDefaultPool.get(),
+        nullptr));
+    REQUIRE(blocker);
+    const auto blockerCount = ::GetActiveProcessorCount(ALL_PROCESSOR_GROUPS) * 8;
+    for (DWORD i = 0; i < blockerCount; ++i)
+    {
+        ::SubmitThreadpoolWork(blocker.get());
+    }
+    auto release = wil::SetEvent_scope_exit(releaseDefaultPool.get());
+
+    wil::unique_event_nothrow ran;
+    REQUIRE_SUCCEEDED(ran.create());
+    wil::threadpool_nothrow pool;
+    REQUIRE_SUCCEEDED(pool.create(1, 2, TP_CALLBACK_PRIORITY_HIGH));
+
+    // Work on the private pool starts promptly even though the default pool is saturated.
+    wil::unique_threadpool_work work;
+    REQUIRE_SUCCEEDED(pool.create_work(
+        work,
+        [](PTP_CALLBACK_INSTANCE, void* context, PTP_WORK) {
+            ::SetEvent(static_cast<HANDLE>(context));
+        },
+        ran.get()));
+    const auto start = ::GetTickCount64();
+    ::SubmitThreadpoolWork(work.get());
+    REQUIRE(ran.wait(5000));
+    REQUIRE(::GetTickCount64() - start < 1000);
+
+    wil::unique_threadpool_timer timer;
+    REQUIRE_SUCCEEDED(pool.create_timer(
+        timer,
+        [](PTP_CALLBACK_INSTANCE, void* context, PTP_TIMER) {
+            ::SetEvent(static_cast<HANDLE>(context));
+        },
+        ran.get()));
+    FILETIME dueTime{};
+    ::SetThreadpoolTimer(timer.get(), &dueTime, 0, 0);
+    REQUIRE(ran.wait(5000));
+
+    // Cleanup group members are closed together, and unique_* objects may outlive the pool object.
+    LONG groupRuns = 0;
+    auto groupWork = ::CreateThreadpoolWork(
+        [](PTP_CALLBACK_INSTANCE, void* context, PTP_WORK) {
+            ::InterlockedIncrement(static_cast<LONG*>(context));
+        },
+        &groupRuns,
+        pool.group_environment());
+    REQUIRE(groupWork != nullptr);
+    ::SubmitThreadpoolWork(groupWork);
+    ::WaitForThreadpoolWorkCallbacks(groupWork, FALSE);
+    pool.close_group_members();
+    REQUIRE(groupRuns == 1);
+
+    {
+        wil::threadpool_nothrow shortLived;
+        REQUIRE_SUCCEEDED(shortLived.create(1, 1));
+        REQUIRE_SUCCEEDED(shortLived.create_work(
+            work,
+            [](PTP_CALLBACK_INSTANCE, void* context, PTP_WORK) {
+                ::SetEvent(static_cast<HANDLE>(context));
+            },
+            ran.get()));
+    }
+    ::SubmitThreadpoolWork(work.get());
+    REQUIRE(ran.wait(5000));
+}
+#endif // WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP) && (_WIN32_WINNT >= _WIN32_WINNT_WIN7)
+
+TEST_CASE("WindowsInternalTests::WaitForManyHandles", "[resource]")
+{
+    std::vector<wil::unique_event_nothrow> events(200);
+    std::vector<HANDLE> handles;
+    for (auto& event : events)
+    {
+        REQUIRE_SUCCEEDED(event.create(wil::EventOptions::ManualReset));
+        handles.push_back(event.get());
+    }
+
+    auto result = wil::wait_for_any_nothrow(handles.data(), handles.size(), 0);
+    REQUIRE(result.timed_out());
+    REQUIRE(result.hresult() == HRESULT_FROM_WIN32(ERROR_TIMEOUT));
+
+    // Handles past the first MAXIMUM_WAIT_OBJECTS - 1 are covered by threadpool waits.
+    events[150].SetEvent();
+    result = wil::wait_for_any_nothrow(handles.data(), handles.size(), 5000);
+    REQUIRE(result.signaled());
+    REQUIRE(result.index() == 150);
+    events[150].ResetEvent();
+
+    events[10].SetEvent();
+    result = wil::wait_for_any_nothrow(handles.data(), handles.size(), 5000);
+    REQUIRE(result);
+    REQUIRE(result.index() == 10);
+
+    // A signal arriving while the caller is blocked wakes it.
+    events[10].ResetEvent();
+    std::thread setter([&] {
+        ::Sleep(50);
+        events[199].SetEvent();
+    });
+    result = wil::wait_for_any_failfast(handles.data(), handles.size());
+    setter.join();
+    REQUIRE(result.index() == 199);
+
+    result = wil::wait_for_all_nothrow(handles.data(), handles.size(), 0);
+    REQUIRE(result.timed_out());
+    for (auto& event : events)
+    {
+        event.SetEvent();
+    }
+    result = wil::wait_for_all_nothrow(handles.data(), handles.size(), 5000);
+    REQUIRE(result.signaled());
+
+    // Small arrays go straight to WaitForMultipleObjects.
+    events[0].ResetEvent();
+    result = wil::wait_for_any_nothrow(handles.data(), 3, 0);
+    REQUIRE(result.index() == 1);
+
+    HANDLE invalid[] = {handles[1], nullptr};
+    result = wil::wait_for_any_nothrow(invalid, ARRAYSIZE(invalid), 0);
+    REQUIRE(FAILED(result.hresult()));
+}
+
+TEST_CASE("WindowsInternalTests::EventPoolTests", "[resource][event_pool]")
+{
+    wil::event_pool pool(2);
+    HANDLE first;
+    {
+        wil::pooled_event_nothrow event;
+        REQUIRE_SUCCEEDED(event.create(pool, wil::EventOptions::ManualReset));
+        first = event.get();
+        REQUIRE(!event.is_signaled());
+        event.SetEvent();
+        REQUIRE(event.wait(0));
+    }
+    REQUIRE(pool.idle_count() == 1);
+
+    // The event comes back reset, and only for requests of the same kind.
+    wil::pooled_event_failfast autoReset(pool, wil::EventOptions::None);
+    REQUIRE(autoReset.get() != first);
+    wil::pooled_event_failfast reused(pool, wil::EventOptions::ManualReset);
+    REQUIRE(reused.get() == first);
+    REQUIRE(!reused.is_signaled());
+    REQUIRE(pool.idle_count() == 0);
+
+    wil::pooled_event_failfast signaled(pool, wil::EventOptions::ManualReset | wil::EventOptions::Signaled);
+    REQUIRE(signaled.is_signaled());
+
+    // Moves keep the pool; beyond the high-water mark events are closed.
+    auto moved = wistd::move(reused);
+    REQUIRE(!reused);
+    autoReset.reset();
+    moved.reset();
+    signaled.reset();
+    REQUIRE(pool.idle_count() == 2);
+
+    wil::pooled_event_failfast detached(pool, wil::EventOptions::None);
+    wil::unique_handle owned(detached.release());
+    REQUIRE(owned);
+    REQUIRE(!detached);
+    REQUIRE(pool.idle_count() == 1);
+}
+
 struct ConditionVariableCSCallbackContext
 {
     wil::condition_variable event;